@@ -31,4 +31,10 @@ package sim_pkg is
 
     attribute foreign of current_delta_cycle : function is "_nvc_current_delta";
 
+    -- Enable or disable waveform dumping from the current simulation
+    -- time onwards
+    procedure set_wave_dumping (enable : boolean);
+
+    attribute foreign of set_wave_dumping : procedure is "_nvc_set_wave_dumping";
+
 end package;
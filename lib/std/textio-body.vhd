@@ -48,18 +48,6 @@ package body textio is
         end if;
     end procedure;
 
-    procedure shrink (l : inout line; size : in natural) is
-        variable tmp : line;
-    begin
-        assert l /= null;
-        if size < l'length then
-            tmp := new string(1 to size);
-            tmp.all := l.all(1 to size);
-            deallocate(l);
-            l := tmp;
-        end if;
-    end procedure;
-
     procedure consume (l : inout line; nchars : in natural) is
         variable tmp : line;
     begin
@@ -243,44 +231,19 @@ package body textio is
     procedure read (l     : inout line;
                     value : out integer;
                     good  : out boolean ) is
-        variable pos         : integer := 1;
-        variable digit       : integer;
-        variable result      : integer := 0;
-        variable is_negative : boolean := false;
-        variable peek        : character;
+        procedure impl (str   : in string;
+                        value : out integer;
+                        good  : out boolean;
+                        used  : out natural);
+        attribute foreign of impl : procedure is "_std_textio_read_integer";
+        variable used : natural;
     begin
-        skip_whitespace(l);
-
-        if pos <= l.all'length then
-            case get_char(l.all, pos) is
-                when '-' =>
-                    pos := pos + 1;
-                    is_negative := true;
-                when '+' =>
-                    pos := pos + 1;
-                when others =>
-            end case;
-        end if;
-
-        while pos <= l.all'length loop
-            peek := get_char(l.all, pos);
-            exit when peek < '0' or peek > '9';
-            digit := character'pos(peek) - character'pos('0');
-            if is_negative then
-              digit := -digit;
-            end if;
-            result := (result * 10) + digit;
-            pos := pos + 1;
-        end loop;
-
-        if is_negative and pos = 2 then
-          -- Single dash without trailing digit is not good
-          pos := 1;
+        if l = null then
+            good := false;
+            return;
         end if;
-
-        good := pos > 1;
-        value := result;
-        consume(l, pos - 1);
+        impl(l.all, value, good, used);
+        consume(l, used);
     end procedure;
 
     procedure read (l     : inout line;
@@ -450,68 +413,32 @@ package body textio is
         strlen := pos - 1;
     end procedure;
 
+    procedure read_bits (l        : inout line;
+                         value    : out   bit_vector;
+                         log_base : in    positive;
+                         good     : out   boolean) is
+        procedure impl (str      : in string;
+                        value    : out bit_vector;
+                        log_base : in positive;
+                        good     : out boolean;
+                        used     : out natural);
+        attribute foreign of impl : procedure is "_std_textio_read_bits";
+        variable used : natural;
+    begin
+        if l = null then
+            value := (value'range => '0');
+            good := false;
+            return;
+        end if;
+        impl(l.all, value, log_base, good, used);
+        consume(l, used);
+    end procedure;
+
     procedure oread (l     : inout line;
                      value : out   bit_vector;
                      good  : out   boolean) is
-        variable digits     : string(1 to (value'length + 2) / 3);
-        variable ipos       : integer := 1;
-        variable opos       : integer := 1;
-        variable remainder  : integer;
-        variable char       : character;
-        variable bits       : bit_vector(1 to 3);
-        variable underscore : boolean := false;
-        alias avalue        : bit_vector(1 to value'length) is value;
     begin
-        good := false;
-        avalue := (others => '0');
-        skip_whitespace(l);
-        while ipos <= l'right and opos <= digits'right loop
-            char := get_char(l.all, ipos);
-            ipos := ipos + 1;
-            if char = '_' and underscore then
-                underscore := false;
-                next;
-            elsif char >= '0' and char <= '7' then
-                digits(opos) := char;
-                underscore := true;
-                opos := opos + 1;
-            else
-                exit;
-            end if;
-        end loop;
-        consume(l, ipos - 1);
-        if opos /= digits'right + 1 then
-            return;
-        end if;
-        opos := 1;
-        remainder := avalue'length rem 3;
-        for i in digits'range loop
-            case digits(i) is
-                when '0' => bits := "000";
-                when '1' => bits := "001";
-                when '2' => bits := "010";
-                when '3' => bits := "011";
-                when '4' => bits := "100";
-                when '5' => bits := "101";
-                when '6' => bits := "110";
-                when '7' => bits := "111";
-                when others => assert false;
-            end case;
-            if i = digits'left and remainder /= 0 then
-                -- Partial copy of first digit
-                avalue(1 to remainder) := bits(4 - remainder to 3);
-                opos := opos + remainder;
-                for j in 1 to 3 - remainder loop
-                    if bits(j) /= '0' then
-                        return;
-                    end if;
-                end loop;
-            else
-                avalue(opos to opos + 2) := bits;
-                opos := opos + 3;
-            end if;
-        end loop;
-        good := true;
+        read_bits(l, value, 3, good);
     end procedure;
 
     procedure oread (l     : inout line;
@@ -525,76 +452,8 @@ package body textio is
     procedure hread (l     : inout line;
                      value : out   bit_vector;
                      good  : out   boolean) is
-        variable digits     : string(1 to (value'length + 3) / 4);
-        variable ipos       : integer := 1;
-        variable opos       : integer := 1;
-        variable remainder  : integer;
-        variable char       : character;
-        variable bits       : bit_vector(1 to 4);
-        variable underscore : boolean := false;
-        alias avalue        : bit_vector(1 to value'length) is value;
     begin
-        good := false;
-        avalue := (others => '0');
-        skip_whitespace(l);
-        while ipos <= l'right and opos <= digits'right loop
-            char := get_char(l.all, ipos);
-            ipos := ipos + 1;
-            if char = '_' and underscore then
-                underscore := false;
-                next;
-            elsif (char >= '0' and char <= '9')
-                or (char >= 'a' and char <= 'f')
-                or (char >= 'A' and char <= 'F')
-            then
-                digits(opos) := char;
-                underscore := true;
-                opos := opos + 1;
-            else
-                exit;
-            end if;
-        end loop;
-        consume(l, ipos - 1);
-        if opos /= digits'right + 1 then
-            return;
-        end if;
-        opos := 1;
-        remainder := avalue'length rem 4;
-        for i in digits'range loop
-            case digits(i) is
-                when '0' => bits := "0000";
-                when '1' => bits := "0001";
-                when '2' => bits := "0010";
-                when '3' => bits := "0011";
-                when '4' => bits := "0100";
-                when '5' => bits := "0101";
-                when '6' => bits := "0110";
-                when '7' => bits := "0111";
-                when '8' => bits := "1000";
-                when '9' => bits := "1001";
-                when 'a' | 'A' => bits := "1010";
-                when 'b' | 'B' => bits := "1011";
-                when 'c' | 'C' => bits := "1100";
-                when 'd' | 'D' => bits := "1101";
-                when 'e' | 'E' => bits := "1110";
-                when 'f' | 'F' => bits := "1111";
-                when others => assert false;
-            end case;
-            if i = digits'left and remainder /= 0 then
-                -- Partial copy of first digit
-                avalue(1 to remainder) := bits(5 - remainder to 4);
-                opos := opos + remainder;
-                for j in 1 to 4 - remainder loop
-                    if bits(j) /= '0' then
-                        return;
-                    end if;
-                end loop;
-            else
-                avalue(opos to opos + 3) := bits;
-                opos := opos + 4;
-            end if;
-        end loop;
-        good := true;
+        read_bits(l, value, 4, good);
     end procedure;
 
     procedure hread (l     : inout line;
@@ -605,49 +464,26 @@ package body textio is
         assert good report "hread failed";
     end procedure;
 
-    constant LINE_BUFFER_SIZE : positive := 128;
-
     procedure readline (file f: text; l: inout line) is
-        variable tmp  : line;
-        variable ch   : string(1 to 1);
-        variable used : natural;
-        variable got  : integer;
+        impure function impl (file f : text) return string;
+        attribute foreign of impl : function is "_std_textio_readline";
     begin
         if l /= null then
             deallocate(l);
         end if;
-
-        tmp := new string(1 to LINE_BUFFER_SIZE);
-        loop
-            exit when endfile(f);
-
-            read(f, ch, got);
-            exit when got /= 1;
-
-            next when ch(1) = CR;
-
-            if ch(1) = LF then
-                exit;
-            else
-                if used = tmp'length then
-                    grow(tmp, LINE_BUFFER_SIZE, used);
-                end if;
-                used := used + 1;
-                tmp(used) := ch(1);
-            end if;
-        end loop;
-
-        shrink(tmp, used);
-        l := tmp;
+        l := new string'(impl(f));
     end procedure;
 
     procedure writeline (file f : text; l : inout line) is
+        procedure impl (file f : text; str : in string);
+        attribute foreign of impl : procedure is "_std_textio_writeline";
     begin
         if l /= null then
-            write(f, l.all);
+            impl(f, l.all);
             deallocate(l);
+        else
+            impl(f, "");
         end if;
-        write(f, (1 => LF));   -- Prepend CR on Windows?
         l := new string'("");
     end procedure;
 
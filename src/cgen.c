@@ -28,6 +28,7 @@
 #include "option.h"
 #include "phase.h"
 #include "rt/cover.h"
+#include "rt/heap.h"
 #include "rt/rt.h"
 #include "thread.h"
 #include "vcode.h"
@@ -37,6 +38,8 @@
 #include <limits.h>
 #include <unistd.h>
 #include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <libgen.h>
 #include <sys/stat.h>
 
@@ -60,12 +63,22 @@ typedef struct {
    unsigned         index;
    cover_tagging_t *cover;
    llvm_obj_t      *obj;
+   unsigned         cost;
+   unsigned         elapsed_us;
 } cgen_job_t;
 
+typedef A(cgen_job_t *) job_list_t;
+
+typedef struct {
+   vcode_unit_t vu;
+   unsigned     cost;
+} unit_cost_t;
+
 static A(char *) link_args;
 static A(char *) cleanup_files = AINIT;
 
 #define UNITS_PER_JOB 25
+#define UNIT_BASE_COST 16
 
 static void cgen_find_children(vcode_unit_t root, unit_list_t *units)
 {
@@ -240,23 +253,43 @@ static void cgen_linker_setup(void)
 #endif
 }
 
-static void cgen_link(const char *module_name, char **objs, int nobjs)
+static void cgen_output_path(const char *module_name, const char *ext,
+                             char *path)
 {
-   cgen_linker_setup();
-
    LOCAL_TEXT_BUF tb = tb_new();
    tb_printf(tb, "_%s", module_name);
    if (opt_get_int(OPT_NO_SAVE))
       tb_printf(tb, ".%d", getpid());
-   tb_cat(tb, "." DLL_EXT);
+   tb_printf(tb, ".%s", ext);
 
-   char so_path[PATH_MAX];
-   lib_realpath(lib_work(), tb_get(tb), so_path, PATH_MAX);
+   lib_realpath(lib_work(), tb_get(tb), path, PATH_MAX);
 
    if (opt_get_int(OPT_NO_SAVE)) {
-      APUSH(cleanup_files, xstrdup(so_path));
+      APUSH(cleanup_files, xstrdup(path));
       atexit(cleanup_temp_dll);
    }
+   else {
+      // The run command prefers the shared library so remove any
+      // output from an earlier elaboration using the other mode
+      const char *other = strcmp(ext, DLL_EXT) == 0 ? "a" : DLL_EXT;
+
+      tb_rewind(tb);
+      tb_printf(tb, "_%s.%s", module_name, other);
+
+      char stale[PATH_MAX];
+      lib_realpath(lib_work(), tb_get(tb), stale, PATH_MAX);
+
+      if (remove(stale) != 0 && errno != ENOENT)
+         fatal_errno("remove: %s", stale);
+   }
+}
+
+static void cgen_link(const char *module_name, char **objs, int nobjs)
+{
+   cgen_linker_setup();
+
+   char so_path[PATH_MAX];
+   cgen_output_path(module_name, DLL_EXT, so_path);
 
    cgen_link_arg("-o");
    cgen_link_arg("%s", so_path);
@@ -272,7 +305,7 @@ static void cgen_link(const char *module_name, char **objs, int nobjs)
 #endif
 
 #ifdef IMPLIB_REQUIRED
-   tb_rewind(tb);
+   LOCAL_TEXT_BUF tb = tb_new();
    const char *cyglib = getenv("NVC_IMP_LIB");
    if (cyglib != NULL)
       tb_cat(tb, cyglib);
@@ -303,12 +336,63 @@ static void cgen_link(const char *module_name, char **objs, int nobjs)
    ACLEAR(link_args);
 }
 
+static void cgen_archive(const char *module_name, char **objs, int nobjs)
+{
+   char ar_path[PATH_MAX];
+   cgen_output_path(module_name, "a", ar_path);
+
+   FILE *f = fopen(ar_path, "wb");
+   if (f == NULL)
+      fatal_errno("cannot create %s", ar_path);
+
+   fputs("!<arch>\n", f);
+
+   for (int i = 0; i < nobjs; i++) {
+      int fd = open(objs[i], O_RDONLY);
+      if (fd < 0)
+         fatal_errno("%s", objs[i]);
+
+      struct stat st;
+      if (fstat(fd, &st) != 0)
+         fatal_errno("%s", objs[i]);
+
+      void *map = map_file(fd, st.st_size);
+      close(fd);
+
+      // Standard ar(1) member header: the member names are only used to
+      // label the code in the cache
+      char name[17];
+      checked_sprintf(name, sizeof(name), "%d.%s/", i, LLVM_OBJ_EXT);
+      fprintf(f, "%-16s%-12d%-6d%-6d%-8o%-10zu`\n", name, 0, 0, 0, 0644,
+              (size_t)st.st_size);
+
+      fwrite(map, st.st_size, 1, f);
+      if (st.st_size % 2 != 0)
+         fputc('\n', f);
+
+      unmap_file(map, st.st_size);
+
+      if (unlink(objs[i]) != 0)
+         fatal_errno("unlink: %s", objs[i]);
+   }
+
+   if (fclose(f) != 0)
+      fatal_errno("%s", ar_path);
+
+   progress("writing object archive");
+}
+
 static void cgen_async_work(void *context, void *arg)
 {
    jit_t *jit = context;
    cgen_job_t *job = arg;
 
-   llvm_obj_t *obj = llvm_obj_new(job->module_name);
+   const uint64_t start_us = get_timestamp_us();
+
+   const llvm_obj_kind_t kind =
+      opt_get_int(OPT_NO_LINK) ? LLVM_OBJ_LOADABLE : LLVM_OBJ_SHARED;
+
+   llvm_obj_t *obj = llvm_obj_new(job->module_name, kind);
 
    if (job->index == 0)
       llvm_add_abi_version(obj);
@@ -326,24 +410,56 @@ static void cgen_async_work(void *context, void *arg)
    llvm_obj_finalise(obj, LLVM_O0);
    llvm_obj_emit(obj, job->obj_path);
 
-   ACLEAR(job->units);
-   free(job->module_name);
-   free(job);
+   job->elapsed_us = get_timestamp_us() - start_us;
+}
+
+static unsigned cgen_unit_cost(vcode_unit_t vu)
+{
+   // The number of vcode ops is a good predictor of the time spent in
+   // both the JIT IR generation and LLVM
+   vcode_select_unit(vu);
+
+   unsigned cost = UNIT_BASE_COST;
+   const int nblocks = vcode_count_blocks();
+   for (int i = 0; i < nblocks; i++) {
+      vcode_select_block(i);
+      cost += vcode_count_ops();
+   }
+
+   return cost;
+}
+
+static int cgen_cost_cmp(const void *a, const void *b)
+{
+   const unit_cost_t *ua = a, *ub = b;
+   return (ua->cost < ub->cost) - (ua->cost > ub->cost);
+}
+
+static int cgen_job_cmp(const void *a, const void *b)
+{
+   const cgen_job_t *ja = *(const cgen_job_t **)a;
+   const cgen_job_t *jb = *(const cgen_job_t **)b;
+   return (ja->cost < jb->cost) - (ja->cost > jb->cost);
 }
 
 static void cgen_partition_jobs(unit_list_t *units, workq_t *wq,
                                 const char *base_name, int units_per_job,
-                                tree_t top, obj_list_t *objs)
+                                tree_t top, obj_list_t *objs,
+                                job_list_t *jobs)
 {
-   int counter = 0;
-
-   // Adjust units_per_job to ensure that each job has a roughly equal
-   // number of units
    const int njobs = (units->count + units_per_job - 1) / units_per_job;
-   units_per_job = (units->count + njobs - 1) / njobs;
 
-   for (unsigned i = 0; i < units->count; i += units_per_job, counter++) {
-      char *module_name = xasprintf("%s.%d", base_name, counter);
+   unit_cost_t *costs LOCAL =
+      xmalloc_array(units->count, sizeof(unit_cost_t));
+   for (unsigned i = 0; i < units->count; i++) {
+      costs[i].vu = units->items[i];
+      costs[i].cost = cgen_unit_cost(units->items[i]);
+   }
+
+   heap_t *heap = heap_new(njobs + 1);
+
+   for (int i = 0; i < njobs; i++) {
+      char *module_name = xasprintf("%s.%d", base_name, i);
       char *obj_name LOCAL =
          xasprintf("_%s.%d." LLVM_OBJ_EXT, module_name, getpid());
 
@@ -353,14 +469,45 @@ static void cgen_partition_jobs(unit_list_t *units, workq_t *wq,
       cgen_job_t *job = xcalloc(sizeof(cgen_job_t));
       job->module_name = module_name;
       job->obj_path    = xstrdup(obj_path);
-      job->index       = counter;
-
-      for (unsigned j = i; j < units->count && j < i + units_per_job; j++)
-         APUSH(job->units, units->items[j]);
+      job->index       = i;
 
+      APUSH(*jobs, job);
       APUSH(*objs, job->obj_path);
 
-      workq_do(wq, cgen_async_work, job);
+      heap_insert(heap, 0, job);
+   }
+
+   // Assign the most expensive units first, each to the job with the
+   // lowest total cost so far, to avoid a few large units making one
+   // job the long pole
+   qsort(costs, units->count, sizeof(unit_cost_t), cgen_cost_cmp);
+
+   for (unsigned i = 0; i < units->count; i++) {
+      cgen_job_t *job = heap_extract_min(heap);
+      APUSH(job->units, costs[i].vu);
+      job->cost += costs[i].cost;
+      heap_insert(heap, job->cost, job);
+   }
+
+   heap_free(heap);
+
+   // Start the most expensive jobs first
+   cgen_job_t **order LOCAL = xmalloc_array(njobs, sizeof(cgen_job_t *));
+   for (int i = 0; i < njobs; i++)
+      order[i] = jobs->items[i];
+
+   qsort(order, njobs, sizeof(cgen_job_t *), cgen_job_cmp);
+
+   for (int i = 0; i < njobs; i++)
+      workq_do(wq, cgen_async_work, order[i]);
+}
+
+static void cgen_report_jobs(job_list_t *jobs)
+{
+   for (unsigned i = 0; i < jobs->count; i++) {
+      const cgen_job_t *job = jobs->items[i];
+      debugf("job %s: %d units; cost %u; %u ms", job->module_name,
+             job->units.count, job->cost, job->elapsed_us / 1000);
    }
 }
 
@@ -409,14 +556,29 @@ void cgen(tree_t top, cover_tagging_t *cover)
    workq_t *wq = workq_new(jit);
 
    obj_list_t objs = AINIT;
-   cgen_partition_jobs(&units, wq, istr(name), UNITS_PER_JOB, top, &objs);
+   job_list_t jobs = AINIT;
+   cgen_partition_jobs(&units, wq, istr(name), UNITS_PER_JOB, top,
+                       &objs, &jobs);
 
    workq_start(wq);
    workq_drain(wq);
 
    progress("code generation for %d units", units.count);
 
-   cgen_link(istr(name), objs.items, objs.count);
+   if (opt_get_int(OPT_VERBOSE))
+      cgen_report_jobs(&jobs);
+
+   for (unsigned i = 0; i < jobs.count; i++) {
+      ACLEAR(jobs.items[i]->units);
+      free(jobs.items[i]->module_name);
+      free(jobs.items[i]);
+   }
+   ACLEAR(jobs);
+
+   if (opt_get_int(OPT_NO_LINK))
+      cgen_archive(istr(name), objs.items, objs.count);
+   else
+      cgen_link(istr(name), objs.items, objs.count);
 
    for (unsigned i = 0; i < objs.count; i++)
       free(objs.items[i]);
@@ -520,7 +682,7 @@ void aotgen(const char *outfile, char **argv, int argc)
 
    progress("initialising");
 
-   llvm_obj_t *obj = llvm_obj_new("preload");
+   llvm_obj_t *obj = llvm_obj_new("preload", LLVM_OBJ_SHARED);
    llvm_add_abi_version(obj);
 
    for (int i = 0; i < units.count; i++) {
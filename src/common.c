@@ -987,6 +987,11 @@ void intern_strings(void)
 
    id_cache[W_NUMERIC_STD_UNSIGNED] = ident_new("IEEE.NUMERIC_STD_UNSIGNED");
    id_cache[W_NUMERIC_BIT_UNSIGNED] = ident_new("IEEE.NUMERIC_BIT_UNSIGNED");
+
+   id_cache[W_IEEE_1164_RISING] =
+      ident_new("IEEE.STD_LOGIC_1164.RISING_EDGE(sU)B");
+   id_cache[W_IEEE_1164_FALLING] =
+      ident_new("IEEE.STD_LOGIC_1164.FALLING_EDGE(sU)B");
 }
 
 bool is_uninstantiated_package(tree_t pack)
@@ -196,6 +196,8 @@ typedef enum {
    W_IEEE_1164_NOR,
    W_IEEE_1164_XOR,
    W_IEEE_1164_XNOR,
+   W_IEEE_1164_RISING,
+   W_IEEE_1164_FALLING,
    W_FOREIGN,
    W_WORK,
    W_STD,
@@ -89,10 +89,12 @@ typedef struct _hint_rec {
 } hint_rec_t;
 
 static unsigned         n_errors = 0;
+static unsigned         n_warnings = 0;
 static file_list_t      loc_files;
 static vhdl_severity_t  exit_severity = SEVERITY_ERROR;
 static diag_level_t     stderr_level = DIAG_DEBUG;
 static nvc_lock_t       diag_lock = 0;
+static nvc_lock_t       loc_lock = 0;
 
 static __thread diag_consumer_t consumer = NULL;
 
@@ -275,24 +277,28 @@ void loc_read(loc_t *loc, loc_rd_ctx_t *ctx)
          fatal("corrupt location file reference %x", old_ref);
 
       if (ctx->ref_map[old_ref] == FILE_INVALID) {
+         // Location tables may be read concurrently when merging
+         // coverage databases
+         SCOPED_LOCK(loc_lock);
+
          for (unsigned i = 0; i < loc_files.count; i++) {
             if (strcmp(loc_files.items[i].name_str,
                        ctx->file_map[old_ref]) == 0)
                ctx->ref_map[old_ref] = loc_files.items[i].ref;
          }
-      }
 
-      if (ctx->ref_map[old_ref] == FILE_INVALID) {
-         loc_file_t new = {
-            .linebuf  = NULL,
-            .name_str = ctx->file_map[old_ref],
-            .ref      = loc_files.count
-         };
+         if (ctx->ref_map[old_ref] == FILE_INVALID) {
+            loc_file_t new = {
+               .linebuf  = NULL,
+               .name_str = ctx->file_map[old_ref],
+               .ref      = loc_files.count
+            };
 
-         APUSH(loc_files, new);
+            APUSH(loc_files, new);
 
-         ctx->ref_map[old_ref]  = new.ref;
-         ctx->file_map[old_ref] = NULL;   // Owned by loc_file_t now
+            ctx->ref_map[old_ref]  = new.ref;
+            ctx->file_map[old_ref] = NULL;   // Owned by loc_file_t now
+         }
       }
 
       new_ref = ctx->ref_map[old_ref];
@@ -936,6 +942,8 @@ void diag_femit(diag_t *d, FILE *f)
 
    if (is_error && relaxed_add(&n_errors, 1) == opt_get_int(OPT_ERROR_LIMIT))
       fatal("too many errors, giving up");
+   else if (d->level == DIAG_WARN)
+      relaxed_add(&n_warnings, 1);
 
    for (int i = 0; i < d->hints.count; i++)
       free(d->hints.items[i].text);
@@ -1051,6 +1059,11 @@ void reset_error_count(void)
    n_errors = 0;
 }
 
+unsigned warning_count(void)
+{
+   return n_warnings;
+}
+
 void fmt_loc(FILE *f, const loc_t *loc)
 {
    // Legacy interface for debugging only
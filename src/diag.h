@@ -104,6 +104,7 @@ void diag_stacktrace(diag_t *d, bool stacktrace);
 
 unsigned error_count(void);
 void reset_error_count(void);
+unsigned warning_count(void);
 
 void wrapped_printf(const char *fmt, ...);
 
@@ -43,8 +43,35 @@
 #include <stdlib.h>
 #include <inttypes.h>
 
+#define FUSE_MAX_PROCS 16
+
 typedef A(tree_t) tree_list_t;
 typedef A(type_t) type_list_t;
+typedef A(tree_list_t) fuse_list_t;
+
+typedef struct {
+   tree_t producer;
+   tree_t consumer;
+   tree_t fused;
+} fuse_chain_t;
+
+typedef A(fuse_chain_t) chain_list_t;
+
+typedef struct {
+   tree_t  signal;
+   tree_t  variable;
+   hash_t *targets;
+   int     nrefs;
+   int     nwrites;
+   bool    valid;
+} chain_check_t;
+
+typedef struct {
+   hash_t *first;
+   hash_t *second;
+   tree_t  owner;
+   tree_t  container;
+} chain_owners_t;
 
 typedef struct _elab_ctx elab_ctx_t;
 
@@ -1734,10 +1761,832 @@ static void elab_psl(tree_t t, const elab_ctx_t *ctx)
    tree_add_stmt(ctx->out, t);
 }
 
-static void elab_stmts(tree_t t, const elab_ctx_t *ctx)
+static bool elab_fusable_stmts(tree_t container, int nstmts,
+                               tree_list_t *targets)
+{
+   for (int i = 0; i < nstmts; i++) {
+      tree_t s = tree_stmt(container, i);
+
+      switch (tree_kind(s)) {
+      case T_SIGNAL_ASSIGN:
+         {
+            tree_t target = tree_target(s);
+            if (tree_kind(target) != T_REF)
+               return false;
+
+            tree_t decl = tree_ref(target);
+            const tree_kind_t dkind = tree_kind(decl);
+            if (dkind != T_SIGNAL_DECL && dkind != T_PORT_DECL)
+               return false;
+
+            const int nwaves = tree_waveforms(s);
+            for (int j = 0; j < nwaves; j++) {
+               if (!tree_has_value(tree_waveform(s, j)))
+                  return false;   // Null transaction
+            }
+
+            if (targets != NULL)
+               APUSH(*targets, decl);
+         }
+         break;
+
+      case T_IF:
+         {
+            const int nconds = tree_conds(s);
+            for (int j = 0; j < nconds; j++) {
+               tree_t c = tree_cond(s, j);
+               if (!elab_fusable_stmts(c, tree_stmts(c), targets))
+                  return false;
+            }
+         }
+         break;
+
+      case T_CASE:
+         {
+            const int nalts = tree_stmts(s);
+            for (int j = 0; j < nalts; j++) {
+               tree_t a = tree_stmt(s, j);
+               if (tree_decls(a) > 0)
+                  return false;
+               else if (!elab_fusable_stmts(a, tree_stmts(a), targets))
+                  return false;
+            }
+         }
+         break;
+
+      default:
+         return false;
+      }
+   }
+
+   return true;
+}
+
+static bool elab_fusable_trigger(tree_t trigger)
+{
+   // Only fuse processes whose inputs are signals where the event flag
+   // is cached by the runtime and so cheap to test
+   if (tree_kind(trigger) != T_REF)
+      return false;
+
+   tree_t decl = tree_ref(trigger);
+   const tree_kind_t kind = tree_kind(decl);
+   if (kind != T_SIGNAL_DECL && kind != T_PORT_DECL)
+      return false;
+
+   type_t base = type_base_recur(tree_type(decl));
+   return type_is_enum(base) && type_enum_literals(base) <= 256;
+}
+
+static bool elab_fusable_process(tree_t proc, tree_list_t *targets)
+{
+   if (tree_decls(proc) > 0 || (tree_flags(proc) & TREE_F_POSTPONED))
+      return false;
+
+   const int nstmts = tree_stmts(proc);
+   if (nstmts < 2)
+      return false;
+
+   tree_t wait = tree_stmt(proc, nstmts - 1);
+   if (tree_kind(wait) != T_WAIT || !(tree_flags(wait) & TREE_F_STATIC_WAIT))
+      return false;
+
+   const int ntriggers = tree_triggers(wait);
+   if (ntriggers == 0)
+      return false;
+
+   for (int i = 0; i < ntriggers; i++) {
+      if (!elab_fusable_trigger(tree_trigger(wait, i)))
+         return false;
+   }
+
+   return elab_fusable_stmts(proc, nstmts - 1, targets);
+}
+
+static tree_t elab_fuse_or(tree_t or_decl, tree_t lhs, tree_t rhs)
+{
+   tree_t fcall = tree_new(T_FCALL);
+   tree_set_ident(fcall, tree_ident(or_decl));
+   tree_set_ref(fcall, or_decl);
+   tree_set_loc(fcall, tree_loc(rhs));
+   tree_set_type(fcall, tree_type(or_decl));
+   add_param(fcall, lhs, P_POS, NULL);
+   add_param(fcall, rhs, P_POS, NULL);
+
+   return fcall;
+}
+
+static tree_t elab_fuse_guard(tree_t proc, tree_t first, tree_t or_decl,
+                              tree_t skip, tree_t wait, hash_t *seen)
+{
+   // Build the condition "FIRST or S1'EVENT or S2'EVENT ..." for the
+   // triggers of the original process other than SKIP and add them to
+   // the wait statement of the fused process
+
+   type_t std_bool = std_type(NULL, STD_BOOLEAN);
+   tree_t pwait = tree_stmt(proc, tree_stmts(proc) - 1);
+   tree_t value = make_ref(first);
+
+   const int ntriggers = tree_triggers(pwait);
+   for (int i = 0; i < ntriggers; i++) {
+      tree_t trigger = tree_trigger(pwait, i);
+      if (tree_ref(trigger) == skip)
+         continue;
+
+      tree_t event = tree_new(T_ATTR_REF);
+      tree_set_name(event, trigger);
+      tree_set_ident(event, ident_new("EVENT"));
+      tree_set_loc(event, tree_loc(trigger));
+      tree_set_subkind(event, ATTR_EVENT);
+      tree_set_type(event, std_bool);
+
+      value = elab_fuse_or(or_decl, value, event);
+
+      if (hash_put(seen, tree_ref(trigger), trigger))
+         continue;
+
+      tree_add_trigger(wait, trigger);
+   }
+
+   return value;
+}
+
+static tree_t elab_fuse_first(tree_t proc)
+{
+   type_t std_bool = std_type(NULL, STD_BOOLEAN);
+
+   tree_t first = tree_new(T_VAR_DECL);
+   tree_set_ident(first, ident_new("FIRST"));
+   tree_set_loc(first, tree_loc(proc));
+   tree_set_type(first, std_bool);
+   tree_set_value(first, make_ref(type_enum_literal(std_bool, 1)));
+
+   return first;
+}
+
+static tree_t elab_fuse_clear(tree_t proc, tree_t first)
+{
+   type_t std_bool = std_type(NULL, STD_BOOLEAN);
+
+   tree_t clear = tree_new(T_VAR_ASSIGN);
+   tree_set_loc(clear, tree_loc(proc));
+   tree_set_target(clear, make_ref(first));
+   tree_set_value(clear, make_ref(type_enum_literal(std_bool, 0)));
+
+   return clear;
+}
+
+static tree_t elab_fuse_group(tree_t *procs, int count, int index)
+{
+   // Build a single process which executes the body of each original
+   // process only if one of the signals it is sensitive to had an
+   // event, or unconditionally the first time it runs
+
+   char name[32];
+   checked_sprintf(name, sizeof(name), "_F%d", index);
+
+   tree_t fused = tree_new(T_PROCESS);
+   tree_set_ident(fused, ident_new(name));
+   tree_set_loc(fused, tree_loc(procs[0]));
+
+   tree_t or_decl = std_func(ident_new("STD.STANDARD.\"or\"(BB)B"));
+   assert(or_decl != NULL);
+
+   tree_t first = elab_fuse_first(procs[0]);
+   tree_add_decl(fused, first);
+
+   tree_t wait = tree_new(T_WAIT);
+   tree_set_loc(wait, tree_loc(procs[0]));
+   tree_set_flag(wait, TREE_F_STATIC_WAIT);
+
+   hash_t *seen = hash_new(16);
+
+   for (int i = 0; i < count; i++) {
+      tree_t c = tree_new(T_COND_STMT);
+      tree_set_loc(c, tree_loc(procs[i]));
+      tree_set_value(c, elab_fuse_guard(procs[i], first, or_decl, NULL,
+                                        wait, seen));
+
+      const int nstmts = tree_stmts(procs[i]);
+      for (int j = 0; j < nstmts - 1; j++)
+         tree_add_stmt(c, tree_stmt(procs[i], j));
+
+      tree_t s = tree_new(T_IF);
+      tree_set_ident(s, tree_ident(procs[i]));
+      tree_set_loc(s, tree_loc(procs[i]));
+      tree_add_cond(s, c);
+
+      tree_add_stmt(fused, s);
+   }
+
+   hash_free(seen);
+
+   tree_add_stmt(fused, elab_fuse_clear(procs[0], first));
+   tree_add_stmt(fused, wait);
+
+   return fused;
+}
+
+static void elab_chain_check_cb(tree_t t, void *context)
+{
+   chain_check_t *cc = context;
+
+   switch (tree_kind(t)) {
+   case T_REF:
+      if (tree_has_ref(t) && tree_ref(t) == cc->signal)
+         cc->nrefs++;
+      break;
+
+   case T_SIGNAL_ASSIGN:
+      {
+         tree_t target = tree_target(t);
+         if (tree_kind(target) != T_REF || tree_ref(target) != cc->signal)
+            break;
+
+         // The same target may be shared by several assignments
+         if (cc->targets != NULL && !hash_put(cc->targets, target, target))
+            cc->nwrites++;
+
+         // Only a single transaction with no delay can be forwarded
+         // through a variable
+         if (tree_waveforms(t) != 1 || tree_has_delay(tree_waveform(t, 0)))
+            cc->valid = false;
+      }
+      break;
+
+   case T_ATTR_REF:
+      {
+         tree_t name = tree_name(t);
+         if (tree_kind(name) == T_REF && tree_ref(name) == cc->signal)
+            cc->valid = false;
+      }
+      break;
+
+   case T_FCALL:
+      {
+         const int nparams = tree_params(t);
+         for (int i = 0; i < nparams; i++) {
+            tree_t p = tree_param(t, i);
+            tree_t value = tree_value(p);
+            if (tree_kind(value) != T_REF || tree_ref(value) != cc->signal)
+               continue;
+            else if (tree_subkind(p) != P_POS || !tree_has_ref(t))
+               cc->valid = false;
+            else {
+               tree_t port = tree_port(tree_ref(t), tree_pos(p));
+               if (tree_class(port) == C_SIGNAL)
+                  cc->valid = false;
+            }
+         }
+      }
+      break;
+
+   default:
+      break;
+   }
+}
+
+static void elab_chain_owner_cb(tree_t t, void *context)
+{
+   chain_owners_t *co = context;
+
+   if (!tree_has_ref(t))
+      return;
+
+   tree_t decl = tree_ref(t);
+   if (tree_kind(decl) != T_SIGNAL_DECL)
+      return;
+
+   // Record the first two statements which reference each signal and
+   // use the container to stand for any further references
+   tree_t first = hash_get(co->first, decl);
+   if (first == NULL)
+      hash_put(co->first, decl, co->owner);
+   else if (first != co->owner) {
+      tree_t second = hash_get(co->second, decl);
+      if (second == NULL)
+         hash_put(co->second, decl, co->owner);
+      else if (second != co->owner)
+         hash_put(co->second, decl, co->container);
+   }
+}
+
+static bool elab_chain_copy_pred(tree_t t, void *context)
+{
+   chain_check_t *cc = context;
+   return tree_kind(t) == T_REF && tree_ref(t) == cc->signal;
+}
+
+static void elab_chain_copy_cb(tree_t t, void *context)
+{
+   chain_check_t *cc = context;
+
+   if (tree_kind(t) == T_REF && tree_ref(t) == cc->signal) {
+      tree_set_ref(t, cc->variable);
+      tree_set_ident(t, tree_ident(cc->variable));
+   }
+}
+
+static bool elab_chain_signal(tree_t decl)
+{
+   if (is_guarded_signal(decl))
+      return false;
+
+   type_t type = tree_type(decl);
+   if (!type_is_resolved(type))
+      return true;
+
+   // The effective value of a resolved signal with a single driver is
+   // the driving value only for the standard logic resolution function
+   for (type_t t = type; type_kind(t) == T_SUBTYPE; t = type_base(t)) {
+      if (type_has_resolution(t)) {
+         tree_t rname = type_resolution(t);
+         if (tree_kind(rname) != T_REF)
+            return false;
+
+         tree_t rdecl = tree_ref(rname);
+         ident_t std_resolved = ident_new("IEEE.STD_LOGIC_1164.RESOLVED(Y)U");
+         return tree_has_ident2(rdecl) && tree_ident2(rdecl) == std_resolved;
+      }
+   }
+
+   return false;
+}
+
+static tree_t elab_chain_neq(type_t type)
+{
+   // The predefined inequality operator is declared alongside the
+   // type in the same design unit
+   type_t base = type_base_recur(type);
+   ident_t qual = ident_runtil(type_ident(base), '.');
+   if (qual == type_ident(base))
+      return NULL;
+
+   tree_t unit = lib_get_qualified(qual);
+   if (unit == NULL)
+      return NULL;
+
+   const int ndecls = tree_decls(unit);
+   for (int i = 0; i < ndecls; i++) {
+      tree_t d = tree_decl(unit, i);
+      if (tree_kind(d) != T_FUNC_DECL || tree_subkind(d) != S_SCALAR_NEQ)
+         continue;
+      else if (type_eq(tree_type(tree_port(d, 0)), base))
+         return d;
+   }
+
+   return NULL;
+}
+
+static void elab_chain_producer(tree_t from, int nstmts, tree_t to,
+                                tree_t signal, tree_t var)
+{
+   // Copy the body of the producer replacing each assignment to the
+   // intermediate signal with an assignment to the variable followed
+   // by an assignment of the variable to the signal
+
+   for (int i = 0; i < nstmts; i++) {
+      tree_t s = tree_stmt(from, i);
+
+      switch (tree_kind(s)) {
+      case T_SIGNAL_ASSIGN:
+         if (tree_ref(tree_target(s)) == signal) {
+            tree_t w0 = tree_waveform(s, 0);
+
+            tree_t v = tree_new(T_VAR_ASSIGN);
+            tree_set_loc(v, tree_loc(s));
+            tree_set_target(v, make_ref(var));
+            tree_set_value(v, tree_value(w0));
+
+            tree_add_stmt(to, v);
+
+            tree_t w = tree_new(T_WAVEFORM);
+            tree_set_loc(w, tree_loc(w0));
+            tree_set_value(w, make_ref(var));
+
+            tree_t a = tree_new(T_SIGNAL_ASSIGN);
+            tree_set_loc(a, tree_loc(s));
+            tree_set_target(a, tree_target(s));
+            tree_add_waveform(a, w);
+
+            tree_add_stmt(to, a);
+            continue;
+         }
+         break;
+
+      case T_IF:
+         {
+            tree_t new = tree_new(T_IF);
+            tree_set_loc(new, tree_loc(s));
+            if (tree_has_ident(s))
+               tree_set_ident(new, tree_ident(s));
+
+            const int nconds = tree_conds(s);
+            for (int j = 0; j < nconds; j++) {
+               tree_t c = tree_cond(s, j);
+
+               tree_t nc = tree_new(T_COND_STMT);
+               tree_set_loc(nc, tree_loc(c));
+               if (tree_has_value(c))
+                  tree_set_value(nc, tree_value(c));
+
+               elab_chain_producer(c, tree_stmts(c), nc, signal, var);
+               tree_add_cond(new, nc);
+            }
+
+            tree_add_stmt(to, new);
+            continue;
+         }
+
+      case T_CASE:
+         {
+            tree_t new = tree_new(T_CASE);
+            tree_set_loc(new, tree_loc(s));
+            tree_set_value(new, tree_value(s));
+            if (tree_has_ident(s))
+               tree_set_ident(new, tree_ident(s));
+
+            const int nalts = tree_stmts(s);
+            for (int j = 0; j < nalts; j++) {
+               tree_t a = tree_stmt(s, j);
+
+               tree_t na = tree_new(T_ALTERNATIVE);
+               tree_set_loc(na, tree_loc(a));
+
+               const int nassocs = tree_assocs(a);
+               for (int k = 0; k < nassocs; k++)
+                  tree_add_assoc(na, tree_assoc(a, k));
+
+               elab_chain_producer(a, tree_stmts(a), na, signal, var);
+               tree_add_stmt(new, na);
+            }
+
+            tree_add_stmt(to, new);
+            continue;
+         }
+
+      default:
+         break;
+      }
+
+      tree_add_stmt(to, s);
+   }
+}
+
+static tree_t elab_fuse_chain(tree_t producer, tree_t consumer,
+                              tree_t signal, tree_t neq_decl, int index)
 {
+   // Build a single process which runs the consumer in the same
+   // activation as the producer using a variable holding the value
+   // last assigned to the intermediate signal, instead of waiting a
+   // delta cycle for the signal to update
+
+   tree_t var = tree_new(T_VAR_DECL);
+   tree_set_ident(var, tree_ident(signal));
+   tree_set_loc(var, tree_loc(signal));
+   tree_set_type(var, tree_type(signal));
+   if (tree_has_value(signal))
+      tree_set_value(var, tree_value(signal));
+
+   chain_check_t cc = {
+      .signal   = signal,
+      .variable = var,
+      .valid    = true,
+   };
+
+   tree_t copy = consumer;
+   tree_copy(&copy, 1, elab_chain_copy_pred, NULL, &cc,
+             elab_chain_copy_cb, NULL, &cc);
+
+   const int nstmts = tree_stmts(copy);
+
+   // References from another arena were not copied
+   for (int i = 0; i < nstmts - 1; i++)
+      tree_visit_only(tree_stmt(copy, i), elab_chain_check_cb, &cc, T_REF);
+
+   if (cc.nrefs > 0)
+      return NULL;
+
+   char name[32];
+   checked_sprintf(name, sizeof(name), "_C%d", index);
+
+   tree_t fused = tree_new(T_PROCESS);
+   tree_set_ident(fused, ident_new(name));
+   tree_set_loc(fused, tree_loc(consumer));
+
+   type_t std_bool = std_type(NULL, STD_BOOLEAN);
+   tree_t or_decl = std_func(ident_new("STD.STANDARD.\"or\"(BB)B"));
+   assert(or_decl != NULL);
+
+   tree_t first = elab_fuse_first(consumer);
+   tree_add_decl(fused, first);
+   tree_add_decl(fused, var);
+
+   tree_t wait = tree_new(T_WAIT);
+   tree_set_loc(wait, tree_loc(consumer));
+   tree_set_flag(wait, TREE_F_STATIC_WAIT);
+
+   hash_t *seen = hash_new(16);
+
+   tree_t c0 = tree_new(T_COND_STMT);
+   tree_set_loc(c0, tree_loc(producer));
+   tree_set_value(c0, elab_fuse_guard(producer, first, or_decl, NULL,
+                                      wait, seen));
+
+   elab_chain_producer(producer, tree_stmts(producer) - 1, c0, signal, var);
+
+   tree_t s0 = tree_new(T_IF);
+   tree_set_ident(s0, tree_ident(producer));
+   tree_set_loc(s0, tree_loc(producer));
+   tree_add_cond(s0, c0);
+
+   tree_add_stmt(fused, s0);
+
+   // The consumer also runs whenever the value assigned to the
+   // intermediate signal differs from its current value, which is
+   // exactly when the signal would have an event in the next cycle
+   tree_t neq = tree_new(T_FCALL);
+   tree_set_ident(neq, tree_ident(neq_decl));
+   tree_set_ref(neq, neq_decl);
+   tree_set_loc(neq, tree_loc(consumer));
+   tree_set_type(neq, std_bool);
+   add_param(neq, make_ref(var), P_POS, NULL);
+   add_param(neq, make_ref(signal), P_POS, NULL);
+
+   tree_t c1 = tree_new(T_COND_STMT);
+   tree_set_loc(c1, tree_loc(consumer));
+   tree_set_value(c1, elab_fuse_or(or_decl,
+                                   elab_fuse_guard(consumer, first, or_decl,
+                                                   signal, wait, seen),
+                                   neq));
+
+   for (int i = 0; i < nstmts - 1; i++)
+      tree_add_stmt(c1, tree_stmt(copy, i));
+
+   tree_t s1 = tree_new(T_IF);
+   tree_set_ident(s1, tree_ident(consumer));
+   tree_set_loc(s1, tree_loc(consumer));
+   tree_add_cond(s1, c1);
+
+   tree_add_stmt(fused, s1);
+
+   hash_free(seen);
+
+   tree_add_stmt(fused, elab_fuse_clear(consumer, first));
+   tree_add_stmt(fused, wait);
+
+   return fused;
+}
+
+static bool elab_chain_disjoint(tree_t producer, tree_t consumer)
+{
+   // The consumer must not drive any signal which is also driven by
+   // the producer or which the producer is sensitive to
+
+   tree_list_t ptargets = AINIT, ctargets = AINIT;
+   elab_fusable_process(producer, &ptargets);
+   elab_fusable_process(consumer, &ctargets);
+
+   tree_t pwait = tree_stmt(producer, tree_stmts(producer) - 1);
+   const int ntriggers = tree_triggers(pwait);
+
+   bool disjoint = true;
+   for (int i = 0; i < ctargets.count && disjoint; i++) {
+      for (int j = 0; j < ptargets.count; j++)
+         disjoint &= ptargets.items[j] != ctargets.items[i];
+
+      for (int j = 0; j < ntriggers; j++)
+         disjoint &= tree_ref(tree_trigger(pwait, j)) != ctargets.items[i];
+   }
+
+   ACLEAR(ptargets);
+   ACLEAR(ctargets);
+   return disjoint;
+}
+
+static void elab_fuse_chains(tree_t t, tree_t *procs, int count,
+                             chain_list_t *chains, hash_t *map)
+{
+   // Fuse a process which is the only driver of a local signal with
+   // the process which is the only reader of that signal, provided
+   // the signal is not otherwise visible through attributes or as an
+   // actual for a signal parameter
+
+   chain_owners_t co = {
+      .first     = hash_new(128),
+      .second    = hash_new(128),
+      .container = t,
+   };
+
+   hash_t *local = hash_new(128);
+
+   const int ndecls = tree_decls(t);
+   for (int i = 0; i < ndecls; i++) {
+      tree_t d = tree_decl(t, i);
+      if (tree_kind(d) == T_SIGNAL_DECL)
+         hash_put(local, d, d);
+
+      co.owner = t;
+      tree_visit_only(d, elab_chain_owner_cb, &co, T_REF);
+   }
+
    const int nstmts = tree_stmts(t);
    for (int i = 0; i < nstmts; i++) {
+      co.owner = tree_stmt(t, i);
+      tree_visit_only(co.owner, elab_chain_owner_cb, &co, T_REF);
+   }
+
+   hash_t *fusable = hash_new(count * 2);
+   for (int i = 0; i < count; i++)
+      hash_put(fusable, procs[i], procs[i]);
+
+   for (int i = 0; i < count; i++) {
+      tree_t consumer = procs[i];
+      if (hash_get(map, consumer) != NULL)
+         continue;
+
+      tree_t wait = tree_stmt(consumer, tree_stmts(consumer) - 1);
+
+      const int ntriggers = tree_triggers(wait);
+      for (int j = 0; j < ntriggers; j++) {
+         tree_t signal = tree_ref(tree_trigger(wait, j));
+         if (hash_get(local, signal) == NULL)
+            continue;
+
+         tree_t first = hash_get(co.first, signal);
+         tree_t second = hash_get(co.second, signal);
+
+         tree_t producer = first == consumer ? second : first;
+         if (producer == NULL || producer == consumer)
+            continue;
+         else if (first != consumer && second != consumer)
+            continue;
+         else if (hash_get(fusable, producer) == NULL)
+            continue;
+         else if (hash_get(map, producer) != NULL)
+            continue;
+         else if (!elab_chain_signal(signal))
+            continue;
+
+         chain_check_t pcheck = {
+            .signal  = signal,
+            .targets = hash_new(16),
+            .valid   = true
+         };
+         tree_visit(producer, elab_chain_check_cb, &pcheck);
+         hash_free(pcheck.targets);
+
+         // The producer must not read the signal
+         if (!pcheck.valid || pcheck.nwrites != pcheck.nrefs)
+            continue;
+
+         chain_check_t ccheck = {
+            .signal  = signal,
+            .targets = hash_new(16),
+            .valid   = true
+         };
+         tree_visit(consumer, elab_chain_check_cb, &ccheck);
+         hash_free(ccheck.targets);
+
+         if (!ccheck.valid || ccheck.nwrites > 0)
+            continue;
+         else if (!elab_chain_disjoint(producer, consumer))
+            continue;
+
+         tree_t neq_decl = elab_chain_neq(tree_type(signal));
+         if (neq_decl == NULL)
+            continue;
+
+         tree_t fused = elab_fuse_chain(producer, consumer, signal,
+                                        neq_decl, chains->count);
+         if (fused == NULL)
+            continue;
+
+         const fuse_chain_t fc = {
+            .producer = producer,
+            .consumer = consumer,
+            .fused    = fused,
+         };
+         APUSH(*chains, fc);
+
+         hash_put(map, producer, (void *)(intptr_t)chains->count);
+         hash_put(map, consumer, (void *)(intptr_t)chains->count);
+         break;
+      }
+   }
+
+   hash_free(fusable);
+   hash_free(local);
+   hash_free(co.first);
+   hash_free(co.second);
+}
+
+static void elab_fuse_processes(tree_t *procs, int count,
+                                fuse_list_t *groups, hash_t *map)
+{
+   // Group processes which are sensitive to the same signals and so
+   // are likely to be woken in the same delta cycle
+
+   tree_list_t targets = AINIT;
+   hash_t *ndrivers = hash_new(count * 2);
+
+   for (int i = 0; i < count; i++) {
+      ATRIM(targets, 0);
+      elab_fusable_process(procs[i], &targets);
+
+      for (int j = 0; j < targets.count; j++) {
+         const intptr_t n = (intptr_t)hash_get(ndrivers, targets.items[j]);
+         hash_put(ndrivers, targets.items[j], (void *)(n + 1));
+      }
+   }
+
+   hash_t *trigmap = hash_new(count * 2);
+
+   for (int i = 0; i < count; i++) {
+      ATRIM(targets, 0);
+      elab_fusable_process(procs[i], &targets);
+
+      // Merging two processes which drive the same signal would change
+      // the number of drivers
+      bool multiple = false;
+      for (int j = 0; j < targets.count; j++)
+         multiple |= (intptr_t)hash_get(ndrivers, targets.items[j]) > 1;
+
+      if (multiple)
+         continue;
+
+      const int nstmts = tree_stmts(procs[i]);
+      tree_t wait = tree_stmt(procs[i], nstmts - 1);
+      const int ntriggers = tree_triggers(wait);
+
+      int gid = -1;
+      for (int j = 0; j < ntriggers && gid == -1; j++) {
+         tree_t decl = tree_ref(tree_trigger(wait, j));
+         const intptr_t g = (intptr_t)hash_get(trigmap, decl) - 1;
+         if (g >= 0 && groups->items[g].count < FUSE_MAX_PROCS)
+            gid = g;
+      }
+
+      if (gid == -1) {
+         tree_list_t empty = AINIT;
+         APUSH(*groups, empty);
+         gid = groups->count - 1;
+      }
+
+      APUSH(groups->items[gid], procs[i]);
+      hash_put(map, procs[i], (void *)(intptr_t)(gid + 1));
+
+      for (int j = 0; j < ntriggers; j++) {
+         tree_t decl = tree_ref(tree_trigger(wait, j));
+         hash_put(trigmap, decl, (void *)(intptr_t)(gid + 1));
+      }
+   }
+
+   hash_free(trigmap);
+   hash_free(ndrivers);
+   ACLEAR(targets);
+}
+
+static void elab_stmts(tree_t t, const elab_ctx_t *ctx)
+{
+   const int fuse =
+      ctx->cover == NULL ? opt_get_int(OPT_FUSE_PROCESSES) : 0;
+   const int nstmts = tree_stmts(t);
+
+   // Each group of fused processes is elaborated in place of its first
+   // member so the order of processes and drivers is unchanged, and
+   // each fused chain in place of its consumer
+   fuse_list_t groups = AINIT;
+   chain_list_t chains = AINIT;
+   hash_t *fusemap = NULL, *chainmap = NULL;
+   if (fuse) {
+      SCOPED_A(tree_t) fusable = AINIT;
+      for (int i = 0; i < nstmts; i++) {
+         tree_t s = tree_stmt(t, i);
+         if (tree_kind(s) == T_PROCESS && elab_fusable_process(s, NULL))
+            APUSH(fusable, s);
+      }
+
+      if (fuse > 1 && fusable.count > 1) {
+         chainmap = hash_new(fusable.count * 2);
+         elab_fuse_chains(t, fusable.items, fusable.count, &chains,
+                          chainmap);
+
+         int wptr = 0;
+         for (int i = 0; i < fusable.count; i++) {
+            if (hash_get(chainmap, fusable.items[i]) == NULL)
+               fusable.items[wptr++] = fusable.items[i];
+         }
+         ATRIM(fusable, wptr);
+      }
+
+      if (fusable.count > 1) {
+         fusemap = hash_new(fusable.count * 2);
+         elab_fuse_processes(fusable.items, fusable.count, &groups, fusemap);
+      }
+   }
+
+   for (int i = 0, index = 0; i < nstmts; i++) {
       tree_t s = tree_stmt(t, i);
 
       switch (tree_kind(s)) {
@@ -1757,7 +2606,23 @@ static void elab_stmts(tree_t t, const elab_ctx_t *ctx)
          elab_case_generate(s, ctx);
          break;
       case T_PROCESS:
-         elab_process(s, ctx);
+         {
+            const intptr_t cid =
+               chainmap ? (intptr_t)hash_get(chainmap, s) - 1 : -1;
+            const intptr_t gid =
+               fusemap ? (intptr_t)hash_get(fusemap, s) - 1 : -1;
+            if (cid >= 0) {
+               if (chains.items[cid].consumer == s)
+                  elab_process(chains.items[cid].fused, ctx);
+            }
+            else if (gid < 0 || groups.items[gid].count == 1)
+               elab_process(s, ctx);
+            else if (groups.items[gid].items[0] == s) {
+               tree_list_t *g = &(groups.items[gid]);
+               elab_process(elab_fuse_group(g->items, g->count, index++),
+                            ctx);
+            }
+         }
          break;
       case T_PSL:
          elab_psl(s, ctx);
@@ -1766,6 +2631,17 @@ static void elab_stmts(tree_t t, const elab_ctx_t *ctx)
          fatal_trace("unexpected statement %s", tree_kind_str(tree_kind(s)));
       }
    }
+
+   if (fusemap != NULL)
+      hash_free(fusemap);
+
+   if (chainmap != NULL)
+      hash_free(chainmap);
+
+   for (int i = 0; i < groups.count; i++)
+      ACLEAR(groups.items[i]);
+   ACLEAR(groups);
+   ACLEAR(chains);
 }
 
 static void elab_block(tree_t t, const elab_ctx_t *ctx)
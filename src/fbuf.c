@@ -18,6 +18,7 @@
 #include "util.h"
 #include "fbuf.h"
 #include "fastlz.h"
+#include "thread.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -93,7 +94,8 @@ struct _fbuf {
    size_t       zbufsz;
 };
 
-static fbuf_t *open_list = NULL;
+static fbuf_t     *open_list = NULL;
+static nvc_lock_t  open_lock = 0;
 
 #define ADLER_MOD               65521
 #define ADLER_CHUNK_LEN_32      5552
@@ -271,6 +273,14 @@ static uint32_t checksum_finish(cs_state_t *state)
    }
 }
 
+uint32_t fbuf_checksum(fbuf_cs_t algo, const void *data, size_t len)
+{
+   cs_state_t state;
+   checksum_init(&state, algo);
+   checksum_update(&state, (uint8_t *)data, len);
+   return checksum_finish(&state);
+}
+
 void fbuf_cleanup(void)
 {
    for (fbuf_t *it = open_list; it != NULL; it = it->next) {
@@ -430,7 +440,6 @@ fbuf_t *fbuf_open(const char *file, fbuf_mode_t mode, fbuf_cs_t csum)
    f->file  = h;
    f->fname = xstrdup(file);
    f->mode  = mode;
-   f->next  = open_list;
    f->zip   = DEFAULT_ZIP;
 
    checksum_init(&(f->checksum), csum);
@@ -455,6 +464,10 @@ fbuf_t *fbuf_open(const char *file, fbuf_mode_t mode, fbuf_cs_t csum)
    else
       fbuf_decompress(f);
 
+   SCOPED_LOCK(open_lock);
+
+   f->next = open_list;
+
    if (open_list != NULL)
       open_list->prev = f;
 
@@ -554,6 +567,8 @@ void fbuf_close(fbuf_t *f, uint32_t *checksum)
 
    fclose(f->file);
 
+   nvc_lock(&open_lock);
+
    if (f->prev == NULL) {
       assert(f == open_list);
       if (f->next != NULL)
@@ -566,6 +581,8 @@ void fbuf_close(fbuf_t *f, uint32_t *checksum)
          f->next->prev = f->prev;
    }
 
+   nvc_unlock(&open_lock);
+
    if (checksum != NULL)
       *checksum = checksum_finish(&(f->checksum));
 
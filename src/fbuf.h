@@ -44,6 +44,7 @@ fbuf_t *fbuf_open(const char *file, fbuf_mode_t mode, fbuf_cs_t csum);
 void fbuf_close(fbuf_t *f, uint32_t *checksum);
 void fbuf_cleanup(void);
 const char *fbuf_file_name(fbuf_t *f);
+uint32_t fbuf_checksum(fbuf_cs_t algo, const void *data, size_t len);
 
 int64_t fbuf_get_int(fbuf_t *f);
 uint64_t fbuf_get_uint(fbuf_t *f);
@@ -22,31 +22,165 @@
 #include <string.h>
 #include <assert.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Open addressing probe table shared by the hash tables below
+//
+// Slots are divided into groups of GROUP_SIZE with a control byte per
+// slot which is either CTRL_EMPTY or the top seven bits of the hash of
+// the key stored there.  Every control byte in a group is compared at
+// once so only slots with a matching tag need the full key comparing.
+// The order array records the slots in insertion order which makes
+// iteration and rehashing independent of the key values.
+
+#define GROUP_SIZE 16
+#define CTRL_EMPTY 0x80
+
+typedef struct {
+   unsigned  ngroups;
+   unsigned  limit;
+   unsigned  members;
+   uint8_t  *ctrl;
+   uint32_t *order;
+} probe_table_t;
+
+static void table_init(probe_table_t *t, int size)
+{
+   const unsigned nslots = MAX(GROUP_SIZE, next_power_of_2(size));
+
+   t->ngroups = nslots / GROUP_SIZE;
+   t->limit   = nslots - nslots / 8;   // Maximum load factor of 7/8
+   t->members = 0;
+   t->ctrl    = xmalloc(nslots + t->limit * sizeof(uint32_t));
+   t->order   = (uint32_t *)(t->ctrl + nslots);
+
+   memset(t->ctrl, CTRL_EMPTY, nslots);
+}
+
+static inline unsigned table_slots(probe_table_t *t)
+{
+   return t->ngroups * GROUP_SIZE;
+}
+
+static inline uint8_t table_tag(uint64_t hash)
+{
+   return hash >> 57;
+}
+
+static inline unsigned table_group(probe_table_t *t, uint64_t hash)
+{
+   return hash & (t->ngroups - 1);
+}
+
+static inline unsigned table_next(probe_table_t *t, unsigned group,
+                                  unsigned *stride)
+{
+   // Triangular probing visits every group when the count is a power
+   // of two
+   return (group + (*stride)++) & (t->ngroups - 1);
+}
+
+static inline unsigned group_match(const uint8_t *ctrl, uint8_t byte)
+{
+#ifdef __SSE2__
+   const __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+   return _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(byte)));
+#else
+   unsigned mask = 0;
+   for (int i = 0; i < GROUP_SIZE; i++)
+      mask |= (ctrl[i] == byte) << i;
+   return mask;
+#endif
+}
+
+static unsigned table_insert(probe_table_t *t, uint64_t hash)
+{
+   // The caller must check the key is not already present and that
+   // there is space for another member
+   assert(t->members < t->limit);
+
+   unsigned stride = 1;
+   for (unsigned g = table_group(t, hash); ; g = table_next(t, g, &stride)) {
+      uint8_t *ctrl = t->ctrl + g * GROUP_SIZE;
+      const unsigned empty = group_match(ctrl, CTRL_EMPTY);
+      if (empty != 0) {
+         const int bit = __builtin_ctz(empty);
+         ctrl[bit] = table_tag(hash);
+         return (t->order[t->members++] = g * GROUP_SIZE + bit);
+      }
+   }
+}
+
+// Expands to the body of a function returning the index of the slot
+// where MATCH is true or UINT32_MAX if no such slot exists
+#define TABLE_FIND(t, hash, match) do {                                 \
+      const uint8_t tag = table_tag(hash);                              \
+      unsigned stride = 1;                                              \
+      for (unsigned g = table_group((t), (hash)); ;                     \
+           g = table_next((t), g, &stride)) {                           \
+         const uint8_t *ctrl = (t)->ctrl + g * GROUP_SIZE;              \
+         for (unsigned m = group_match(ctrl, tag); m; m &= m - 1) {     \
+            const uint32_t slot = g * GROUP_SIZE + __builtin_ctz(m);    \
+            if (match)                                                  \
+               return slot;                                             \
+         }                                                              \
+         if (group_match(ctrl, CTRL_EMPTY))                             \
+            return UINT32_MAX;                                          \
+      }                                                                 \
+   } while (0)
+
+// Doubles the number of slots and reinserts the existing entries in
+// their original order
+#define TABLE_GROW(h, hash_fn) do {                                     \
+      probe_table_t __old = (h)->table;                                 \
+      typeof((h)->slots) __old_slots = (h)->slots;                      \
+      table_init(&((h)->table), table_slots(&__old) * 2);               \
+      (h)->slots = xmalloc_array(table_slots(&((h)->table)),            \
+                                 sizeof(*__old_slots));                 \
+      for (unsigned __i = 0; __i < __old.members; __i++) {              \
+         const unsigned __from = __old.order[__i];                      \
+         const unsigned __to =                                          \
+            table_insert(&((h)->table), hash_fn(__old_slots[__from]));  \
+         (h)->slots[__to] = __old_slots[__from];                        \
+      }                                                                 \
+      free(__old.ctrl);                                                 \
+      free(__old_slots);                                                \
+   } while (0)
+
 ////////////////////////////////////////////////////////////////////////////////
 // Hash table of pointers to pointers
 
+typedef struct {
+   const void *key;
+   void       *value;
+} hash_slot_t;
+
 struct _hash {
-   unsigned     size;
-   unsigned     members;
-   void       **values;
-   const void **keys;
+   probe_table_t  table;
+   hash_slot_t   *slots;
 };
 
-static inline int hash_slot(unsigned size, const void *key)
+static inline uint64_t hash_ptr(const void *key)
 {
    assert(key != NULL);
-   return mix_bits_64(key) & (size - 1);
+   return mix_bits_64(key);
+}
+
+#define HASH_SLOT_HASH(s) hash_ptr((s).key)
+
+static inline uint32_t hash_find(hash_t *h, const void *key, uint64_t hash)
+{
+   TABLE_FIND(&(h->table), hash, h->slots[slot].key == key);
 }
 
 hash_t *hash_new(int size)
 {
    hash_t *h = xmalloc(sizeof(hash_t));
-   h->size    = next_power_of_2(size);
-   h->members = 0;
-
-   char *mem = xcalloc(h->size * 2 * sizeof(void *));
-   h->values = (void **)mem;
-   h->keys   = (const void **)(mem + (h->size * sizeof(void *)));
+   table_init(&(h->table), size);
+   h->slots = xmalloc_array(table_slots(&(h->table)), sizeof(hash_slot_t));
 
    return h;
 }
@@ -54,92 +188,53 @@ hash_t *hash_new(int size)
 void hash_free(hash_t *h)
 {
    if (h != NULL) {
-      free(h->values);
+      free(h->table.ctrl);
+      free(h->slots);
       free(h);
    }
 }
 
 bool hash_put(hash_t *h, const void *key, void *value)
 {
-   if (unlikely(h->members >= h->size / 2)) {
-      // Rebuild the hash table with a larger size
-      // This is expensive so a conservative initial size should be chosen
-
-      const int old_size = h->size;
-      h->size *= 2;
-
-      const void **old_keys = h->keys;
-      void **old_values = h->values;
+   const uint64_t hash = hash_ptr(key);
 
-      char *mem = xcalloc(h->size * 2 * sizeof(void *));
-      h->values = (void **)mem;
-      h->keys   = (const void **)(mem + (h->size * sizeof(void *)));
-
-      h->members = 0;
-
-      for (int i = 0; i < old_size; i++) {
-         if (old_keys[i] != NULL)
-            hash_put(h, old_keys[i], old_values[i]);
-      }
-
-      free(old_values);
+   const uint32_t slot = hash_find(h, key, hash);
+   if (slot != UINT32_MAX) {
+      h->slots[slot].value = value;
+      return true;
    }
 
-   int slot = hash_slot(h->size, key);
-
-   for (int i = 1; ; slot = (slot + i++) & (h->size - 1)) {
-      if (h->keys[slot] == key) {
-         h->values[slot] = value;
-         return true;
-      }
-      else if (h->keys[slot] == NULL) {
-         h->values[slot] = value;
-         h->keys[slot] = key;
-         h->members++;
-         break;
-      }
-   }
+   if (unlikely(h->table.members == h->table.limit))
+      TABLE_GROW(h, HASH_SLOT_HASH);
 
+   h->slots[table_insert(&(h->table), hash)] = (hash_slot_t){ key, value };
    return false;
 }
 
 void hash_delete(hash_t *h, const void *key)
 {
-   int slot = hash_slot(h->size, key);
-
-   for (int i = 1; ; slot = (slot + i++) & (h->size - 1)) {
-      if (h->keys[slot] == key) {
-         h->values[slot] = NULL;
-         return;
-      }
-      else if (h->keys[slot] == NULL)
-         return;
-   }
+   // The key remains in the table with a null value
+   const uint32_t slot = hash_find(h, key, hash_ptr(key));
+   if (slot != UINT32_MAX)
+      h->slots[slot].value = NULL;
 }
 
 void *hash_get(hash_t *h, const void *key)
 {
-   int slot = hash_slot(h->size, key);
-
-   for (int i = 1; ; slot = (slot + i++) & (h->size - 1)) {
-      if (h->keys[slot] == key)
-         return h->values[slot];
-      else if (h->keys[slot] == NULL)
-         return NULL;
-   }
+   const uint32_t slot = hash_find(h, key, hash_ptr(key));
+   return slot == UINT32_MAX ? NULL : h->slots[slot].value;
 }
 
 bool hash_iter(hash_t *h, hash_iter_t *now, const void **key, void **value)
 {
    assert(*now != HASH_END);
 
-   while (*now < h->size) {
-      const unsigned old = (*now)++;
-      if (h->keys[old] != NULL) {
-         *key   = h->keys[old];
-         *value = h->values[old];
-         return true;
-      }
+   // Entries are visited in insertion order
+   if (*now < h->table.members) {
+      const hash_slot_t *s = &(h->slots[h->table.order[(*now)++]]);
+      *key   = s->key;
+      *value = s->value;
+      return true;
    }
 
    *now = HASH_END;
@@ -148,20 +243,23 @@ bool hash_iter(hash_t *h, hash_iter_t *now, const void **key, void **value)
 
 unsigned hash_members(hash_t *h)
 {
-   return h->members;
+   return h->table.members;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // Hash table of strings to pointers
 
+typedef struct {
+   char *key;
+   void *value;
+} shash_slot_t;
+
 struct _shash {
-   unsigned   size;
-   unsigned   members;
-   void     **values;
-   char     **keys;
+   probe_table_t  table;
+   shash_slot_t  *slots;
 };
 
-static inline int shash_slot(shash_t *h, const char *key)
+static inline uint64_t hash_str(const char *key)
 {
    assert(key != NULL);
 
@@ -174,18 +272,21 @@ static inline int shash_slot(shash_t *h, const char *key)
    while ((c = *key++))
       hash = ((hash << 5) + hash) + c;
 
-   return mix_bits_32(hash) & (h->size - 1);
+   return mix_bits_64(hash);
+}
+
+#define SHASH_SLOT_HASH(s) hash_str((s).key)
+
+static inline uint32_t shash_find(shash_t *h, const char *key, uint64_t hash)
+{
+   TABLE_FIND(&(h->table), hash, strcmp(h->slots[slot].key, key) == 0);
 }
 
 shash_t *shash_new(int size)
 {
    shash_t *h = xmalloc(sizeof(shash_t));
-   h->size    = next_power_of_2(size);
-   h->members = 0;
-
-   char *mem = xcalloc(h->size * 2 * sizeof(void *));
-   h->values = (void **)mem;
-   h->keys   = (char **)(mem + (h->size * sizeof(void *)));
+   table_init(&(h->table), size);
+   h->slots = xmalloc_array(table_slots(&(h->table)), sizeof(shash_slot_t));
 
    return h;
 }
@@ -195,111 +296,71 @@ void shash_free(shash_t *h)
    if (h == NULL)
       return;
 
-   for (unsigned i = 0; i < h->size; i++) {
-      if (h->keys[i] != NULL)
-         free(h->keys[i]);
-   }
+   for (unsigned i = 0; i < h->table.members; i++)
+      free(h->slots[h->table.order[i]].key);
 
-   free(h->values);
+   free(h->table.ctrl);
+   free(h->slots);
    free(h);
 }
 
-static void shash_put_copy(shash_t *h, char *key, void *value)
-{
-   int slot = shash_slot(h, key);
-
-   for (; ; slot = (slot + 1) & (h->size - 1)) {
-      if (h->keys[slot] == NULL) {
-         h->values[slot] = value;
-         h->keys[slot] = key;
-         h->members++;
-         break;
-      }
-      else if (strcmp(h->keys[slot], key) == 0) {
-         h->values[slot] = value;
-         return;
-      }
-   }
-}
-
 void shash_put(shash_t *h, const char *key, void *value)
 {
-   if (unlikely(h->members >= h->size / 2)) {
-      // Rebuild the hash table with a larger size
+   const uint64_t hash = hash_str(key);
 
-      const int old_size = h->size;
-      h->size *= 2;
-
-      char **old_keys = h->keys;
-      void **old_values = h->values;
-
-      char *mem = xcalloc(h->size * 2 * sizeof(void *));
-      h->values = (void **)mem;
-      h->keys   = (char **)(mem + (h->size * sizeof(void *)));
-
-      h->members = 0;
-
-      for (int i = 0; i < old_size; i++) {
-         if (old_keys[i] != NULL)
-            shash_put_copy(h, old_keys[i], old_values[i]);
-      }
-
-      free(old_values);
+   const uint32_t slot = shash_find(h, key, hash);
+   if (slot != UINT32_MAX) {
+      h->slots[slot].value = value;
+      return;
    }
 
-   shash_put_copy(h, xstrdup(key), value);
+   if (unlikely(h->table.members == h->table.limit))
+      TABLE_GROW(h, SHASH_SLOT_HASH);
+
+   h->slots[table_insert(&(h->table), hash)] =
+      (shash_slot_t){ xstrdup(key), value };
 }
 
 void *shash_get(shash_t *h, const char *key)
 {
-   int slot = shash_slot(h, key);
-
-   for (; ; slot = (slot + 1) & (h->size - 1)) {
-      if (h->keys[slot] == NULL)
-         return NULL;
-      else if (strcmp(h->keys[slot], key) == 0)
-         return h->values[slot];
-   }
+   const uint32_t slot = shash_find(h, key, hash_str(key));
+   return slot == UINT32_MAX ? NULL : h->slots[slot].value;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // Hash of unsigned integers to pointers
 
+typedef struct {
+   uint64_t  key;
+   void     *value;
+} ihash_slot_t;
+
 struct _ihash {
-   unsigned   size;
-   unsigned   members;
-   void     **values;
-   uint64_t  *keys;
-   uint64_t  *mask;
-   uint64_t   cachekey;
-   void      *cacheval;
+   probe_table_t  table;
+   ihash_slot_t  *slots;
+   uint64_t       cachekey;
+   void          *cacheval;
 };
 
-static inline int ihash_slot(ihash_t *h, uint64_t key)
+static inline uint64_t hash_int(uint64_t key)
 {
    key = (key ^ (key >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
    key = (key ^ (key >> 27)) * UINT64_C(0x94d049bb133111eb);
-   key = key ^ (key >> 31);
+   return key ^ (key >> 31);
+}
+
+#define IHASH_SLOT_HASH(s) hash_int((s).key)
 
-   return key & (h->size - 1);
+static inline uint32_t ihash_find(ihash_t *h, uint64_t key, uint64_t hash)
+{
+   TABLE_FIND(&(h->table), hash, h->slots[slot].key == key);
 }
 
 ihash_t *ihash_new(int size)
 {
-   ihash_t *h = xmalloc(sizeof(ihash_t));
-   h->size    = next_power_of_2(size);
-   h->members = 0;
-
-   const size_t bytes =
-      h->size * sizeof(void *) +
-      h->size * sizeof(uint64_t) +
-      (h->size + 63 / 64) * sizeof(uint64_t);
-
-   char *mem = xcalloc(bytes);
-   h->values = (void **)mem;
-   h->keys   = (uint64_t *)(mem + (h->size * sizeof(void *)));
-   h->mask   = (uint64_t *)(mem + (h->size * sizeof(void *))
-                            + (h->size * sizeof(uint64_t)));
+   ihash_t *h = xcalloc(sizeof(ihash_t));
+   table_init(&(h->table), size);
+   h->slots = xmalloc_array(table_slots(&(h->table)), sizeof(ihash_slot_t));
 
    return h;
 }
@@ -307,97 +368,62 @@ ihash_t *ihash_new(int size)
 void ihash_free(ihash_t *h)
 {
    if (h != NULL) {
-      free(h->values);
+      free(h->table.ctrl);
+      free(h->slots);
       free(h);
    }
 }
 
 void ihash_put(ihash_t *h, uint64_t key, void *value)
 {
-   if (unlikely(h->members >= h->size / 2)) {
-      // Rebuild the hash table with a larger size
-
-      const int old_size = h->size;
-      h->size *= 2;
-
-      uint64_t *old_keys = h->keys;
-      uint64_t *old_mask = h->mask;
-      void **old_values = h->values;
-
-      const size_t bytes =
-         h->size * sizeof(void *) +
-         h->size * sizeof(uint64_t) +
-         (ALIGN_UP(h->size, 64) / 64) * sizeof(uint64_t);
-
-      char *mem = xcalloc(bytes);
-      h->values = (void **)mem;
-      h->keys   = (uint64_t *)(mem + (h->size * sizeof(void *)));
-      h->mask   = (uint64_t *)(mem + (h->size * sizeof(void *))
-                               + (h->size * sizeof(uint64_t)));
-
-      h->members = 0;
-
-      for (int i = 0; i < old_size; i++) {
-         if (old_mask[i / 64] & (UINT64_C(1) << (i % 64)))
-            ihash_put(h, old_keys[i], old_values[i]);
-      }
-
-      free(old_values);
-   }
-
    h->cachekey = key;
    h->cacheval = value;
 
-   int slot = ihash_slot(h, key);
+   const uint64_t hash = hash_int(key);
 
-   for (; ; slot = (slot + 1) & (h->size - 1)) {
-      if (!(h->mask[slot / 64] & (UINT64_C(1) << (slot % 64)))) {
-         h->values[slot] = value;
-         h->keys[slot] = key;
-         h->mask[slot / 64] |= (UINT64_C(1) << (slot % 64));
-         h->members++;
-         break;
-      }
-      else if (h->keys[slot] == key) {
-         h->values[slot] = value;
-         assert(h->mask[slot / 64] & (UINT64_C(1) << (slot % 64)));
-         return;
-      }
+   const uint32_t slot = ihash_find(h, key, hash);
+   if (slot != UINT32_MAX) {
+      h->slots[slot].value = value;
+      return;
    }
+
+   if (unlikely(h->table.members == h->table.limit))
+      TABLE_GROW(h, IHASH_SLOT_HASH);
+
+   h->slots[table_insert(&(h->table), hash)] = (ihash_slot_t){ key, value };
 }
 
 void *ihash_get(ihash_t *h, uint64_t key)
 {
-   if (h->members > 0 && key == h->cachekey)
+   if (h->table.members > 0 && key == h->cachekey)
       return h->cacheval;
 
    h->cachekey = key;
 
-   int slot = ihash_slot(h, key);
-
-   for (; ; slot = (slot + 1) & (h->size - 1)) {
-      if (!(h->mask[slot / 64] & (UINT64_C(1) << (slot % 64))))
-         return (h->cacheval = NULL);
-      else if (h->keys[slot] == key)
-         return (h->cacheval = h->values[slot]);
-   }
+   const uint32_t slot = ihash_find(h, key, hash_int(key));
+   return (h->cacheval = (slot == UINT32_MAX ? NULL : h->slots[slot].value));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // Set of pointers implemented as a hash table
 
 struct _hset {
-   unsigned     size;
-   unsigned     members;
-   const void **keys;
+   probe_table_t   table;
+   const void    **slots;
 };
 
+#define HSET_SLOT_HASH(s) hash_ptr(s)
+
+static inline uint32_t hset_find(hset_t *h, const void *key, uint64_t hash)
+{
+   TABLE_FIND(&(h->table), hash, h->slots[slot] == key);
+}
+
 hset_t *hset_new(int size)
 {
    hset_t *h = xmalloc(sizeof(hset_t));
-   h->size    = next_power_of_2(size);
-   h->members = 0;
-   h->keys    = xcalloc_array(h->size, sizeof(void *));
+   table_init(&(h->table), size);
+   h->slots = xmalloc_array(table_slots(&(h->table)), sizeof(void *));
 
    return h;
 }
@@ -405,53 +431,28 @@ hset_t *hset_new(int size)
 void hset_free(hset_t *h)
 {
    if (h != NULL) {
-      free(h->keys);
+      free(h->table.ctrl);
+      free(h->slots);
       free(h);
    }
 }
 
 void hset_insert(hset_t *h, const void *key)
 {
-   if (unlikely(h->members >= h->size / 2)) {
-      const int old_size = h->size;
-      h->size *= 2;
-
-      const void **old_keys = h->keys;
-      h->keys = xcalloc_array(h->size, sizeof(void *));
-
-      h->members = 0;
-
-      for (int i = 0; i < old_size; i++) {
-         if (old_keys[i] != NULL)
-            hset_insert(h, old_keys[i]);
-      }
+   const uint64_t hash = hash_ptr(key);
 
-      free(old_keys);
-   }
+   if (hset_find(h, key, hash) != UINT32_MAX)
+      return;
 
-   int slot = hash_slot(h->size, key);
+   if (unlikely(h->table.members == h->table.limit))
+      TABLE_GROW(h, HSET_SLOT_HASH);
 
-   for (; ; slot = (slot + 1) & (h->size - 1)) {
-      if (h->keys[slot] == key)
-         return;
-      else if (h->keys[slot] == NULL) {
-         h->keys[slot] = key;
-         h->members++;
-         break;
-      }
-   }
+   h->slots[table_insert(&(h->table), hash)] = key;
 }
 
 bool hset_contains(hset_t *h, const void *key)
 {
-   int slot = hash_slot(h->size, key);
-
-   for (; ; slot = (slot + 1) & (h->size - 1)) {
-      if (h->keys[slot] == key)
-         return true;
-      else if (h->keys[slot] == NULL)
-         return false;
-   }
+   return hset_find(h, key, hash_ptr(key)) != UINT32_MAX;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -498,7 +499,7 @@ void chash_free(chash_t *h)
 
 bool chash_put(chash_t *h, const void *key, void *value)
 {
-   const int slot = hash_slot(h->size, key);
+   const int slot = hash_ptr(key) & (h->size - 1);
 
    for (;;) {
       chash_node_t **p = &(h->slots[slot]);
@@ -523,7 +524,7 @@ bool chash_put(chash_t *h, const void *key, void *value)
 
 void *chash_get(chash_t *h, const void *key)
 {
-   const int slot = hash_slot(h->size, key);
+   const int slot = hash_ptr(key) & (h->size - 1);
 
    for (chash_node_t *it = load_acquire(&(h->slots[slot]));
         it != NULL; it = load_acquire(&(it->chain))) {
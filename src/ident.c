@@ -526,17 +526,28 @@ int ident_compare(ident_t a, ident_t b)
 
 static bool ident_glob_walk(const char *str, const char *g)
 {
-   if (*str == '\0')
-      return *g == '\0';
-   else if (*g == '\0')
-      return false;
-   else if (*g == '*')
-      return ident_glob_walk(str + 1, g)
-         || ident_glob_walk(str + 1, g + 1);
-   else if (*str == *g)
-      return ident_glob_walk(str + 1, g + 1);
-   else
-      return false;
+   // Iterative matcher which only backtracks to the most recent star
+   // so runs in O(n*m) time rather than exponential time
+   const char *star = NULL, *resume = NULL;
+   while (*str != '\0') {
+      if (*g == '*') {
+         // A star matches at least one character
+         star = ++g;
+         resume = ++str;
+      }
+      else if (*g == *str) {
+         g++;
+         str++;
+      }
+      else if (star != NULL) {
+         g = star;
+         str = ++resume;
+      }
+      else
+         return false;
+   }
+
+   return *g == '\0';
 }
 
 bool ident_glob(ident_t i, const char *glob, int length)
@@ -16,6 +16,7 @@
 //
 
 #include "util.h"
+#include "array.h"
 #include "cpustate.h"
 #include "debug.h"
 #include "hash.h"
@@ -41,6 +42,7 @@
 #include <mach-o/x86_64/reloc.h>
 #else
 #include <elf.h>
+#include <ar.h>
 #endif
 
 #ifdef HAVE_CAPSTONE
@@ -413,6 +415,15 @@ code_blob_t *code_blob_new(code_cache_t *code, ident_t name, size_t hint)
 
       const size_t chunksz = MAX(reqsz, THREAD_CACHE_SIZE);
       const size_t alignedsz = ALIGN_UP(chunksz, CODE_BLOB_ALIGN);
+
+      if (alignedsz > CODE_PAGE_SIZE)
+         return NULL;
+      else if (code->globalfree->size < reqsz) {
+         // Not enough space left in the current page
+         DEBUG_ONLY(debugf("requesting new %d byte code page", CODE_PAGE_SIZE));
+         code_page_new(code);
+      }
+
       const size_t take = MIN(code->globalfree->size, alignedsz);
 
       free->size = take;
@@ -565,6 +576,8 @@ void code_blob_patch(code_blob_t *blob, jit_label_t label, code_patch_fn_t fn)
 }
 
 #ifdef ARCH_ARM64
+#define ARM64_VENEER_SIZE 16
+
 static void *arm64_emit_trampoline(code_blob_t *blob, uintptr_t dest)
 {
    const uint8_t veneer[] = {
@@ -843,11 +856,12 @@ static void code_load_macho(code_blob_t *blob, const void *data, size_t size)
    }
 }
 #elif !defined __MINGW32__
-static void code_load_elf(code_blob_t *blob, const void *data, size_t size)
+static const Elf64_Ehdr *elf_check_header(const void *data, size_t size)
 {
    const Elf64_Ehdr *ehdr = data;
 
-   if (ehdr->e_ident[EI_MAG0] != ELFMAG0
+   if (size < sizeof(Elf64_Ehdr)
+       || ehdr->e_ident[EI_MAG0] != ELFMAG0
        || ehdr->e_ident[EI_MAG1] != ELFMAG1
        || ehdr->e_ident[EI_MAG2] != ELFMAG2
        || ehdr->e_ident[EI_MAG3] != ELFMAG3)
@@ -856,14 +870,23 @@ static void code_load_elf(code_blob_t *blob, const void *data, size_t size)
       fatal_trace("bad section header size %d != %zu", ehdr->e_shentsize,
                   sizeof(Elf64_Shdr));
 
-   const Elf64_Shdr *strtab_hdr =
-      data + ehdr->e_shoff + ehdr->e_shstrndx * ehdr->e_shentsize;
-   const char *strtab = data + strtab_hdr->sh_offset;
+   return ehdr;
+}
 
-   void **load_addr LOCAL = xcalloc_array(ehdr->e_shnum, sizeof(void *));
+static const Elf64_Shdr *elf_section(const void *data, int index)
+{
+   const Elf64_Ehdr *ehdr = data;
+   return data + ehdr->e_shoff + index * ehdr->e_shentsize;
+}
+
+static void elf_load_sections(code_blob_t *blob, const void *data,
+                              void **load_addr)
+{
+   const Elf64_Ehdr *ehdr = data;
+   const char *strtab = data + elf_section(data, ehdr->e_shstrndx)->sh_offset;
 
    for (int i = 0; i < ehdr->e_shnum; i++) {
-      const Elf64_Shdr *shdr = data + ehdr->e_shoff + i * ehdr->e_shentsize;
+      const Elf64_Shdr *shdr = elf_section(data, i);
 
       switch (shdr->sh_type) {
       case SHT_PROGBITS:
@@ -874,6 +897,17 @@ static void code_load_elf(code_blob_t *blob, const void *data, size_t size)
          }
          break;
 
+      case SHT_NOBITS:
+         if (shdr->sh_flags & SHF_ALLOC) {
+            static const uint8_t zeros[64];
+            code_blob_align(blob, shdr->sh_addralign);
+            load_addr[i] = blob->wptr;
+            for (size_t n = 0; n < shdr->sh_size; n += sizeof(zeros))
+               code_blob_emit(blob, zeros, MIN(sizeof(zeros),
+                                               shdr->sh_size - n));
+         }
+         break;
+
       case SHT_RELA:
          // Handled in second pass
          break;
@@ -889,38 +923,48 @@ static void code_load_elf(code_blob_t *blob, const void *data, size_t size)
                shdr->sh_type);
       }
    }
+}
 
-   if (blob->overflow)
-      return;   // Relocations might point outside of code span
+static void elf_relocate(code_blob_t *blob, const void *data,
+                         void **load_addr, shash_t *symbols)
+{
+   const Elf64_Ehdr *ehdr = data;
+   const char *strtab = data + elf_section(data, ehdr->e_shstrndx)->sh_offset;
 
    for (int i = 0; i < ehdr->e_shnum; i++) {
-      const Elf64_Shdr *shdr = data + ehdr->e_shoff + i * ehdr->e_shentsize;
+      const Elf64_Shdr *shdr = elf_section(data, i);
       if (shdr->sh_type != SHT_RELA)
          continue;
 
-      const Elf64_Shdr *mod =
-         data + ehdr->e_shoff + shdr->sh_info * ehdr->e_shentsize;
+      const Elf64_Shdr *mod = elf_section(data, shdr->sh_info);
       if (mod->sh_type != SHT_PROGBITS || !(mod->sh_flags & SHF_ALLOC))
          continue;
       else if (load_addr[shdr->sh_info] == NULL)
          fatal_trace("section %s not loaded", strtab + mod->sh_name);
 
-      const Elf64_Shdr *symtab =
-         data + ehdr->e_shoff + shdr->sh_link * ehdr->e_shentsize;
+      const Elf64_Shdr *symtab = elf_section(data, shdr->sh_link);
       if (symtab->sh_type != SHT_SYMTAB)
          fatal_trace("section %s is not a symbol table",
                      strtab + symtab->sh_name);
 
+      const char *symstr =
+         data + elf_section(data, symtab->sh_link)->sh_offset;
+
       const Elf64_Rela *endp = data + shdr->sh_offset + shdr->sh_size;
       for (const Elf64_Rela *r = data + shdr->sh_offset; r < endp; r++) {
          const Elf64_Sym *sym = data + symtab->sh_offset
             + ELF64_R_SYM(r->r_info) * symtab->sh_entsize;
+         const char *name = symstr + sym->st_name;
 
          char *ptr = NULL;
          switch (ELF64_ST_TYPE(sym->st_info)) {
          case STT_NOTYPE:
          case STT_FUNC:
-            ptr = ffi_find_symbol(NULL, strtab + sym->st_name);
+         case STT_OBJECT:
+            if (sym->st_shndx != SHN_UNDEF && sym->st_shndx < SHN_LORESERVE)
+               ptr = load_addr[sym->st_shndx] + sym->st_value;
+            else if (symbols == NULL || !(ptr = shash_get(symbols, name)))
+               ptr = ffi_find_symbol(NULL, name);
             break;
          case STT_SECTION:
             ptr = load_addr[sym->st_shndx];
@@ -929,7 +973,7 @@ static void code_load_elf(code_blob_t *blob, const void *data, size_t size)
 
          if (ptr == NULL)
             fatal_trace("cannot resolve symbol %s type %d",
-                        strtab + sym->st_name, ELF64_ST_TYPE(sym->st_info));
+                        name, ELF64_ST_TYPE(sym->st_info));
 
          ptr += r->r_addend;
 
@@ -967,11 +1011,182 @@ static void code_load_elf(code_blob_t *blob, const void *data, size_t size)
             blob->span->size = blob->wptr - blob->span->base;
             code_disassemble(blob->span, (uintptr_t)patch, NULL);
             fatal_trace("cannot handle relocation type %ld for symbol %s",
-                        ELF64_R_TYPE(r->r_info), strtab + sym->st_name);
+                        ELF64_R_TYPE(r->r_info), name);
+         }
+      }
+   }
+}
+
+static void code_load_elf(code_blob_t *blob, const void *data, size_t size)
+{
+   const Elf64_Ehdr *ehdr = elf_check_header(data, size);
+
+   void **load_addr LOCAL = xcalloc_array(ehdr->e_shnum, sizeof(void *));
+
+   elf_load_sections(blob, data, load_addr);
+
+   if (blob->overflow)
+      return;   // Relocations might point outside of code span
+
+   elf_relocate(blob, data, load_addr, NULL);
+}
+
+static size_t elf_load_size(const void *data)
+{
+   const Elf64_Ehdr *ehdr = data;
+
+   size_t size = 0;
+   for (int i = 0; i < ehdr->e_shnum; i++) {
+      const Elf64_Shdr *shdr = elf_section(data, i);
+      if (shdr->sh_flags & SHF_ALLOC)
+         size += shdr->sh_size + shdr->sh_addralign;
+#ifdef ARCH_ARM64
+      else if (shdr->sh_type == SHT_RELA) {
+         // Reserve space for a veneer for each call
+         const Elf64_Rela *endp = data + shdr->sh_offset + shdr->sh_size;
+         for (const Elf64_Rela *r = data + shdr->sh_offset; r < endp; r++) {
+            if (ELF64_R_TYPE(r->r_info) == R_AARCH64_CALL26)
+               size += ARM64_VENEER_SIZE;
          }
       }
+#endif
+   }
+
+   return size;
+}
+
+static void elf_export_symbols(const void *data, void **load_addr,
+                               shash_t *symbols)
+{
+   const Elf64_Ehdr *ehdr = data;
+
+   for (int i = 0; i < ehdr->e_shnum; i++) {
+      const Elf64_Shdr *shdr = elf_section(data, i);
+      if (shdr->sh_type != SHT_SYMTAB)
+         continue;
+
+      const char *symstr = data + elf_section(data, shdr->sh_link)->sh_offset;
+
+      const Elf64_Sym *endp = data + shdr->sh_offset + shdr->sh_size;
+      for (const Elf64_Sym *sym = data + shdr->sh_offset; sym < endp; sym++) {
+         if (ELF64_ST_BIND(sym->st_info) == STB_LOCAL)
+            continue;
+         else if (sym->st_shndx == SHN_UNDEF || sym->st_shndx >= SHN_LORESERVE)
+            continue;
+         else if (load_addr[sym->st_shndx] == NULL)
+            continue;
+
+         void *addr = load_addr[sym->st_shndx] + sym->st_value;
+         shash_put(symbols, symstr + sym->st_name, addr);
+      }
    }
 }
+
+typedef struct {
+   const void   *data;
+   void        **load_addr;
+   code_span_t  *span;
+   uint8_t      *base;
+   uint8_t      *veneers;
+   uint8_t      *limit;
+} elf_member_t;
+
+void code_load_archive(code_cache_t *code, ident_t name, const void *data,
+                       size_t size, shash_t *symbols)
+{
+   if (size < SARMAG || memcmp(data, ARMAG, SARMAG) != 0)
+      fatal("%s: bad archive magic", istr(name));
+
+   A(elf_member_t) members = AINIT;
+   code_blob_t *blob = NULL;
+   jit_entry_fn_t entry;
+
+   // All the objects must be loaded before any relocations are
+   // processed as they can refer to symbols in each other
+   const void *end = data + size;
+   for (const void *p = data + SARMAG; p + sizeof(struct ar_hdr) <= end; ) {
+      const struct ar_hdr *hdr = p;
+      if (memcmp(hdr->ar_fmag, ARFMAG, sizeof(hdr->ar_fmag)) != 0)
+         fatal("%s: bad archive member header", istr(name));
+
+      const size_t msize = strtoul(hdr->ar_size, NULL, 10);
+      const void *mdata = p + sizeof(struct ar_hdr);
+      if (mdata + msize > end)
+         fatal("%s: truncated archive member", istr(name));
+
+      p = mdata + ALIGN_UP(msize, 2);
+
+      if (hdr->ar_name[0] == '/')
+         continue;   // Symbol table or long name table
+
+      const Elf64_Ehdr *ehdr = elf_check_header(mdata, msize);
+
+      const size_t loadsz = elf_load_size(mdata);
+      if (loadsz > CODE_PAGE_SIZE)
+         fatal("%s: object is too large to load into the code cache",
+               istr(name));
+
+      // Pack as many objects as possible into each blob
+      if (blob != NULL && blob->wptr + loadsz > blob->span->base
+          + blob->span->size) {
+         code_blob_finalise(blob, &entry);
+         blob = NULL;
+      }
+
+      if (blob == NULL) {
+         const size_t hint = MIN(MAX(loadsz, end - mdata), CODE_PAGE_SIZE);
+         if ((blob = code_blob_new(code, name, hint)) == NULL)
+            fatal("%s: cannot allocate code cache", istr(name));
+      }
+
+      elf_member_t m = {
+         .data      = mdata,
+         .load_addr = xcalloc_array(ehdr->e_shnum, sizeof(void *)),
+         .span      = blob->span,
+         .base      = blob->wptr,
+      };
+
+      elf_load_sections(blob, mdata, m.load_addr);
+
+      // Veneers are written into the remaining space during relocation
+      m.veneers = blob->wptr;
+      while (blob->wptr < m.base + loadsz && !blob->overflow)
+         code_blob_emit(blob, (uint8_t[]){ 0 }, 1);
+
+      if (blob->overflow)
+         fatal_trace("code cache overflow loading %s", istr(name));
+
+      m.limit = blob->wptr;
+
+      elf_export_symbols(mdata, m.load_addr, symbols);
+
+      APUSH(members, m);
+   }
+
+   if (blob != NULL)
+      code_blob_finalise(blob, &entry);
+
+   thread_wx_mode(WX_WRITE);
+
+   for (int i = 0; i < members.count; i++) {
+      elf_member_t *m = &(members.items[i]);
+
+      code_blob_t tmp = {
+         .span = m->span,
+         .wptr = m->veneers,
+      };
+      elf_relocate(&tmp, m->data, m->load_addr, symbols);
+      assert(tmp.wptr <= m->limit);
+
+      __builtin___clear_cache((char *)m->base, (char *)m->limit);
+
+      free(m->load_addr);
+   }
+
+   thread_wx_mode(WX_EXECUTE);
+
+   ACLEAR(members);
+}
 #endif
 
 void code_load_object(code_blob_t *blob, const void *data, size_t size)
@@ -984,3 +1199,11 @@ void code_load_object(code_blob_t *blob, const void *data, size_t size)
    code_load_elf(blob, data, size);
 #endif
 }
+
+#if defined __APPLE__ || defined __MINGW32__
+void code_load_archive(code_cache_t *code, ident_t name, const void *data,
+                       size_t size, shash_t *symbols)
+{
+   fatal("loading object archives is not supported on this platform");
+}
+#endif
@@ -37,6 +37,7 @@
 #include <assert.h>
 #include <ctype.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <inttypes.h>
 #include <stdlib.h>
 #include <string.h>
@@ -68,8 +69,10 @@ typedef struct {
 } func_array_t;
 
 typedef struct _aot_dll {
-   jit_dll_t  *dll;
-   jit_pack_t *pack;
+   jit_dll_t    *dll;
+   shash_t      *symbols;
+   code_cache_t *code;
+   jit_pack_t   *pack;
 } aot_dll_t;
 
 typedef struct {
@@ -172,7 +175,11 @@ void jit_free(jit_t *j)
    aot_dll_t *libs[] = { j->aotlib, j->preloadlib };
    for (int i = 0; i < ARRAY_LEN(libs); i++) {
       if (libs[i] != NULL) {
-         ffi_unload_dll(libs[i]->dll);
+         if (libs[i]->dll != NULL)
+            ffi_unload_dll(libs[i]->dll);
+         if (libs[i]->code != NULL)
+            code_cache_free(libs[i]->code);
+         shash_free(libs[i]->symbols);
          jit_pack_free(libs[i]->pack);
          free(libs[i]);
       }
@@ -217,6 +224,13 @@ void *jit_mspace_alloc(size_t size)
    return mspace_alloc(thread->jit->mspace, size);
 }
 
+void *jit_mspace_alloc_noscan(size_t size)
+{
+   jit_thread_local_t *thread = jit_thread_local();
+   assert(thread->state == JIT_RUNNING);
+   return mspace_alloc_noscan(thread->jit->mspace, size);
+}
+
 static void jit_install(jit_t *j, jit_func_t *f)
 {
    assert_lock_held(&(j->lock));
@@ -244,6 +258,14 @@ static void jit_install(jit_t *j, jit_func_t *f)
    if (f->unit) chash_put(j->index, f->unit, f);
 }
 
+static void *aot_find_symbol(aot_dll_t *lib, const char *name)
+{
+   if (lib->dll != NULL)
+      return ffi_find_symbol(lib->dll, name);
+   else
+      return shash_get(lib->symbols, name);
+}
+
 static jit_handle_t jit_lazy_compile_locked(jit_t *j, ident_t name)
 {
    assert_lock_held(&j->lock);
@@ -261,7 +283,7 @@ static jit_handle_t jit_lazy_compile_locked(jit_t *j, ident_t name)
       for (int i = 0; i < ARRAY_LEN(try); i++) {
          if (try[i] == NULL)
             continue;
-         else if ((descr = ffi_find_symbol(try[i]->dll, tb_get(tb)))) {
+         else if ((descr = aot_find_symbol(try[i], tb_get(tb)))) {
             jit_pack_put(try[i]->pack, name, descr->cpool,
                          descr->strtab, descr->debug);
             break;
@@ -284,6 +306,14 @@ static jit_handle_t jit_lazy_compile_locked(jit_t *j, ident_t name)
    f->entry     = descr ? descr->entry : jit_interp;
    f->object    = vu ? vcode_unit_object(vu) : NULL;
 
+   jit_entry_fn_t intrinsic = jit_bind_intrinsic(name);
+   if (intrinsic != NULL) {
+      // The generic implementation is still interpreted and tiered
+      // up as usual but compiled code replaces the fallback
+      f->fallback = f->entry;
+      f->entry    = intrinsic;
+   }
+
    // Install now to allow circular references in relocations
    jit_install(j, f);
 
@@ -946,15 +976,11 @@ int jit_backedge_limit(jit_t *j)
    return j->backedge;
 }
 
-static aot_dll_t *load_dll_internal(jit_t *j, const char *path)
+static void check_abi_version(aot_dll_t *lib, const char *path)
 {
    uint32_t abi_version = 0;
 
-   aot_dll_t *lib = xcalloc(sizeof(aot_dll_t));
-   lib->pack = jit_pack_new();
-   lib->dll  = ffi_load_dll(path);
-
-   uint32_t *p = ffi_find_symbol(lib->dll, "__nvc_abi_version");
+   uint32_t *p = aot_find_symbol(lib, "__nvc_abi_version");
    if (p == NULL)
       warnf("%s: cannot find symbol __nvc_abi_version", path);
    else
@@ -966,7 +992,44 @@ static aot_dll_t *load_dll_internal(jit_t *j, const char *path)
 
    if (opt_get_int(OPT_JIT_LOG))
       debugf("loaded AOT library from %s", path);
+}
+
+static aot_dll_t *load_dll_internal(jit_t *j, const char *path)
+{
+   aot_dll_t *lib = xcalloc(sizeof(aot_dll_t));
+   lib->pack = jit_pack_new();
+   lib->dll  = ffi_load_dll(path);
 
+   check_abi_version(lib, path);
+   return lib;
+}
+
+static aot_dll_t *load_archive_internal(jit_t *j, ident_t name,
+                                        const char *path)
+{
+   int fd = open(path, O_RDONLY);
+   if (fd < 0)
+      fatal_errno("%s", path);
+
+   struct stat st;
+   if (fstat(fd, &st) != 0)
+      fatal_errno("%s", path);
+
+   void *map = map_file(fd, st.st_size);
+   close(fd);
+
+   aot_dll_t *lib = xcalloc(sizeof(aot_dll_t));
+   lib->pack    = jit_pack_new();
+   lib->symbols = shash_new(256);
+   lib->code    = code_cache_new();
+
+   // The objects in the archive are relocated directly into the code
+   // cache which avoids running the system linker during elaboration
+   code_load_archive(lib->code, name, map, st.st_size, lib->symbols);
+
+   unmap_file(map, st.st_size);
+
+   check_abi_version(lib, path);
    return lib;
 }
 
@@ -1004,18 +1067,30 @@ void jit_load_dll(jit_t *j, ident_t name)
    tb_printf(tb, "_%s", istr(name));
    if (opt_get_int(OPT_NO_SAVE))
       tb_printf(tb, ".%d", getpid());
+
+   const size_t baselen = tb_len(tb);
    tb_cat(tb, "." DLL_EXT);
 
    char so_path[PATH_MAX];
    lib_realpath(lib, tb_get(tb), so_path, sizeof(so_path));
 
-   if (access(so_path, F_OK) != 0)
+   tb_trim(tb, baselen);
+   tb_cat(tb, ".a");
+
+   char ar_path[PATH_MAX];
+   lib_realpath(lib, tb_get(tb), ar_path, sizeof(ar_path));
+
+   const bool have_dll = access(so_path, F_OK) == 0;
+   if (!have_dll && access(ar_path, F_OK) != 0)
       return;
 
    if (j->aotlib != NULL)
       fatal_trace("AOT library already loaded");
 
-   j->aotlib = load_dll_internal(j, so_path);
+   if (have_dll)
+      j->aotlib = load_dll_internal(j, so_path);
+   else
+      j->aotlib = load_archive_internal(j, name, ar_path);
 }
 
 void jit_msg(const loc_t *where, diag_level_t level, const char *fmt, ...)
@@ -1072,6 +1147,12 @@ static void jit_async_cgen(void *context, void *arg)
       (*tier->plugin.cgen)(f->jit, f->handle, tier->context);
 }
 
+jit_entry_fn_t *jit_code_slot(jit_func_t *f)
+{
+   // Code generators install compiled code here
+   return f->fallback != NULL ? &(f->fallback) : &(f->entry);
+}
+
 void jit_tier_up(jit_func_t *f)
 {
    assert(f->hotness <= 0);
@@ -23,6 +23,7 @@
 #include "jit/jit.h"
 #include "lib.h"
 #include "object.h"
+#include "option.h"
 #include "rt/mspace.h"
 #include "rt/rt.h"
 #include "rt/structs.h"
@@ -115,9 +116,31 @@ void x_file_read(void **_fp, uint8_t *data, int32_t size, int32_t count,
    if (*fp == NULL)
       jit_msg(NULL, DIAG_FATAL, "read from closed file");
 
-   size_t n = fread(data, size, count, *fp);
+   if (!opt_get_int(OPT_GC_GENERATIONAL)) {
+      size_t n = fread(data, size, count, *fp);
+      if (out != NULL)
+         *out = n;
+      return;
+   }
+
+   // Copy through a small buffer as the destination may be on a
+   // write-protected heap page and a large fread calls read(2) on it
+   // directly which fails rather than faulting
+   const size_t total = (size_t)size * count;
+   size_t nbytes = 0;
+   while (nbytes < total) {
+      char buf[1024];
+      const size_t chunk = MIN(sizeof(buf), total - nbytes);
+      const size_t nr = fread(buf, 1, chunk, *fp);
+      memcpy(data + nbytes, buf, nr);
+      nbytes += nr;
+
+      if (nr < chunk)
+         break;
+   }
+
    if (out != NULL)
-      *out = n;
+      *out = size > 0 ? nbytes / size : 0;
 }
 
 void x_file_close(void **_fp)
@@ -737,8 +760,9 @@ void __nvc_do_exit(jit_exit_t which, jit_anchor_t *anchor, jit_scalar_t *args,
          sig_shared_t *shared  = args[0].pointer;
          int32_t       offset  = args[1].integer;
          int32_t       count   = args[2].integer;
+         uint64_t      mask    = args[3].integer;
 
-         x_sched_event(shared, offset, count);
+         x_sched_event(shared, offset, count, mask);
       }
       break;
 
@@ -760,7 +784,7 @@ void __nvc_do_exit(jit_exit_t which, jit_anchor_t *anchor, jit_scalar_t *args,
       {
          int64_t value = args[0].integer;
 
-         char *buf = jit_mspace_alloc(28);
+         char *buf = jit_mspace_alloc_noscan(28);
 
          ffi_uarray_t u = x_int_to_string(value, buf, 28);
          args[0].pointer = u.ptr;
@@ -785,7 +809,7 @@ void __nvc_do_exit(jit_exit_t which, jit_anchor_t *anchor, jit_scalar_t *args,
       {
          double value = args[0].real;
 
-         char *buf = jit_mspace_alloc(32);
+         char *buf = jit_mspace_alloc_noscan(32);
 
          ffi_uarray_t u = x_real_to_string(value, buf, 32);
          args[0].pointer = u.ptr;
@@ -913,7 +937,7 @@ void __nvc_do_exit(jit_exit_t which, jit_anchor_t *anchor, jit_scalar_t *args,
          uint8_t *ptr = args[0].pointer;
          int32_t  len = args[1].integer;
 
-         char *buf = jit_mspace_alloc(len);
+         char *buf = jit_mspace_alloc_noscan(len);
 
          ffi_uarray_t u = x_canon_value(ptr, len, buf);
          args[0].pointer = u.ptr;
@@ -1177,7 +1201,7 @@ void _debug_dump(const uint8_t *ptr, int32_t len)
 }
 
 DLLEXPORT
-void *__nvc_mspace_alloc(uintptr_t size, jit_anchor_t *anchor)
+void *__nvc_mspace_alloc(uintptr_t size, int32_t noscan, jit_anchor_t *anchor)
 {
    jit_thread_local_t *thread = jit_thread_local();
    thread->anchor = anchor;
@@ -1189,7 +1213,7 @@ void *__nvc_mspace_alloc(uintptr_t size, jit_anchor_t *anchor)
       __builtin_unreachable();
    }
 
-   void *ptr = jit_mspace_alloc(size);
+   void *ptr = noscan ? jit_mspace_alloc_noscan(size) : jit_mspace_alloc(size);
 
    thread->anchor = NULL;
    return ptr;
@@ -36,7 +36,8 @@ void x_sched_waveform(sig_shared_t *ss, uint32_t offset, void *values,
 int32_t x_test_net_event(sig_shared_t *ss, uint32_t offset, int32_t count);
 int32_t x_test_net_active(sig_shared_t *ss, uint32_t offset,
                           int32_t count);
-void x_sched_event(sig_shared_t *ss, uint32_t offset, int32_t count);
+void x_sched_event(sig_shared_t *ss, uint32_t offset, int32_t count,
+                   uint64_t mask);
 void x_implicit_event(sig_shared_t *ss, uint32_t offset, int32_t count,
                       sig_shared_t *wake_ss);
 void x_alias_signal(sig_shared_t *ss, tree_t where);
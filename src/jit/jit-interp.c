@@ -822,7 +822,13 @@ static void interp_galloc(jit_interp_t *state, jit_ir_t *ir)
               "which is larger than the maximum supported %u bytes",
               bytes, UINT32_MAX);
 
-   state->regs[ir->result].pointer = mspace_alloc(state->mspace, bytes);
+   assert(ir->arg2.kind == JIT_VALUE_INT64);
+
+   if (ir->arg2.int64)
+      state->regs[ir->result].pointer = mspace_alloc_noscan(state->mspace,
+                                                            bytes);
+   else
+      state->regs[ir->result].pointer = mspace_alloc(state->mspace, bytes);
 
    thread->anchor = NULL;
 }
@@ -1064,7 +1070,7 @@ static void interp_loop(jit_interp_t *state)
 void jit_interp(jit_func_t *f, jit_anchor_t *caller, jit_scalar_t *args,
                 tlab_t *tlab)
 {
-   jit_entry_fn_t entry = load_acquire(&f->entry);
+   jit_entry_fn_t entry = load_acquire(jit_code_slot(f));
    if (unlikely(entry != jit_interp)) {
       // Raced with a code generation thread installing a compiled
       // version of this function
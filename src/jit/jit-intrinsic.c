@@ -0,0 +1,660 @@
+//
+//  Copyright (C) 2023  Nick Gasson
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "util.h"
+#include "ident.h"
+#include "jit/jit-priv.h"
+#include "rt/mspace.h"
+
+#include <assert.h>
+#include <string.h>
+
+//
+// Native implementations of hot subprograms from the IEEE libraries
+//
+// Each intrinsic handles the common case where every element of the
+// inputs is '0', '1', 'L', or 'H' and the result fits in MAX_WORDS
+// 64-bit words.  Anything else, including every case where the VHDL
+// code would report a warning or error, calls the generic VHDL
+// implementation so the observable behaviour is identical.
+//
+
+#define MAX_WORDS 16
+#define MAX_BITS  (MAX_WORDS * 64)
+
+#define BYTES_01 UINT64_C(0x0101010101010101)
+#define BYTES_02 UINT64_C(0x0202020202020202)
+#define BYTES_FE UINT64_C(0xfefefefefefefefe)
+#define GATHER   UINT64_C(0x0102040810204080)
+
+#define INTRINSIC(name)                                         \
+   static void name(jit_func_t *f, jit_anchor_t *caller,        \
+                    jit_scalar_t *args, tlab_t *tlab)
+#define CTX f, caller, args, tlab
+#define GENERIC() return (*f->fallback)(f, caller, args, tlab)
+
+// Positions of the STD_ULOGIC enumeration literals
+enum { _U, _X, _0, _1, _Z, _W, _L, _H, _D };
+
+typedef enum { FORM_VV, FORM_VI, FORM_IV } form_t;
+typedef enum { OP_ADD, OP_SUB, OP_MUL } arith_op_t;
+typedef enum { CMP_EQ, CMP_NEQ, CMP_LT, CMP_LE, CMP_GT, CMP_GE } cmp_op_t;
+typedef enum {
+   LOGIC_AND, LOGIC_OR, LOGIC_XOR, LOGIC_NAND, LOGIC_NOR, LOGIC_XNOR
+} logic_op_t;
+
+typedef struct {
+   const uint8_t *ptr;
+   int64_t        length;
+} vector_t;
+
+typedef struct {
+   const char     *name;
+   jit_entry_fn_t  fn;
+} intrinsic_t;
+
+static const uint8_t and_table[9][9] = {
+   { _U, _U, _0, _U, _U, _U, _0, _U, _U },
+   { _U, _X, _0, _X, _X, _X, _0, _X, _X },
+   { _0, _0, _0, _0, _0, _0, _0, _0, _0 },
+   { _U, _X, _0, _1, _X, _X, _0, _1, _X },
+   { _U, _X, _0, _X, _X, _X, _0, _X, _X },
+   { _U, _X, _0, _X, _X, _X, _0, _X, _X },
+   { _0, _0, _0, _0, _0, _0, _0, _0, _0 },
+   { _U, _X, _0, _1, _X, _X, _0, _1, _X },
+   { _U, _X, _0, _X, _X, _X, _0, _X, _X },
+};
+
+static const uint8_t or_table[9][9] = {
+   { _U, _U, _U, _1, _U, _U, _U, _1, _U },
+   { _U, _X, _X, _1, _X, _X, _X, _1, _X },
+   { _U, _X, _0, _1, _X, _X, _0, _1, _X },
+   { _1, _1, _1, _1, _1, _1, _1, _1, _1 },
+   { _U, _X, _X, _1, _X, _X, _X, _1, _X },
+   { _U, _X, _X, _1, _X, _X, _X, _1, _X },
+   { _U, _X, _0, _1, _X, _X, _0, _1, _X },
+   { _1, _1, _1, _1, _1, _1, _1, _1, _1 },
+   { _U, _X, _X, _1, _X, _X, _X, _1, _X },
+};
+
+static const uint8_t xor_table[9][9] = {
+   { _U, _U, _U, _U, _U, _U, _U, _U, _U },
+   { _U, _X, _X, _X, _X, _X, _X, _X, _X },
+   { _U, _X, _0, _1, _X, _X, _0, _1, _X },
+   { _U, _X, _1, _0, _X, _X, _1, _0, _X },
+   { _U, _X, _X, _X, _X, _X, _X, _X, _X },
+   { _U, _X, _X, _X, _X, _X, _X, _X, _X },
+   { _U, _X, _0, _1, _X, _X, _0, _1, _X },
+   { _U, _X, _1, _0, _X, _X, _1, _0, _X },
+   { _U, _X, _X, _X, _X, _X, _X, _X, _X },
+};
+
+static const uint8_t not_table[9] = {
+   _U, _X, _1, _0, _X, _X, _1, _0, _X
+};
+
+static inline vector_t get_vector(jit_scalar_t *args, int pos)
+{
+   const int64_t biased = args[pos + 2].integer;
+
+   vector_t v = {
+      .ptr    = args[pos].pointer,
+      .length = biased ^ (biased >> 63),
+   };
+   return v;
+}
+
+static uint8_t *alloc_result(jit_anchor_t *caller, jit_scalar_t *args,
+                             tlab_t *tlab, int64_t length, bool downto)
+{
+   jit_thread_local_t *thread = jit_thread_local();
+   thread->anchor = caller;
+
+   uint8_t *mem = tlab_alloc(tlab, length);
+
+   thread->anchor = NULL;
+
+   // NUMERIC_STD returns (N-1 downto 0) and STD_LOGIC_1164 (1 to N)
+   args[0].pointer = mem;
+   args[1].integer = downto ? length - 1 : 1;
+   args[2].integer = downto ? ~length : length;
+
+   return mem;
+}
+
+static inline uint64_t load_be64(const uint8_t *p)
+{
+   uint64_t word;
+   memcpy(&word, p, sizeof(uint64_t));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+   word = __builtin_bswap64(word);
+#endif
+   return word;
+}
+
+static bool pack_slow(const uint8_t *p, int count, uint64_t *bits)
+{
+   uint64_t value = 0;
+   for (int i = 0; i < count; i++) {
+      switch (p[i]) {
+      case _0: case _L: value <<= 1; break;
+      case _1: case _H: value = (value << 1) | 1; break;
+      default: return false;
+      }
+   }
+
+   *bits = value;
+   return true;
+}
+
+static bool pack_bits(vector_t v, uint64_t *words, int nwords, bool is_signed)
+{
+   assert(v.length <= nwords * 64);
+
+   memset(words, '\0', nwords * sizeof(uint64_t));
+
+   // The leftmost element is the most significant bit so work
+   // backwards from the end of the array eight elements at a time
+   const uint8_t *p = v.ptr + v.length;
+   int64_t bit = 0;
+   for (; p - v.ptr >= 8; p -= 8, bit += 8) {
+      const uint64_t chunk = load_be64(p - 8);
+
+      uint64_t bits;
+      if ((chunk & BYTES_FE) == BYTES_02)   // All '0' or '1'
+         bits = ((chunk & BYTES_01) * GATHER) >> 56;
+      else if (!pack_slow(p - 8, 8, &bits))
+         return false;
+
+      words[bit / 64] |= bits << (bit % 64);
+   }
+
+   if (p > v.ptr) {
+      uint64_t bits;
+      if (!pack_slow(v.ptr, p - v.ptr, &bits))
+         return false;
+
+      words[bit / 64] |= bits << (bit % 64);
+   }
+
+   if (is_signed && v.length > 0) {
+      const int64_t top = v.length - 1;
+      if (words[top / 64] & (UINT64_C(1) << (top % 64))) {
+         if (v.length % 64 != 0)
+            words[top / 64] |= ~UINT64_C(0) << (v.length % 64);
+         for (int i = top / 64 + 1; i < nwords; i++)
+            words[i] = ~UINT64_C(0);
+      }
+   }
+
+   return true;
+}
+
+static void unpack_bits(const uint64_t *words, int64_t length, uint8_t *p)
+{
+   for (int64_t i = 0; i < length; i++) {
+      const int64_t bit = length - 1 - i;
+      p[i] = _0 + ((words[bit / 64] >> (bit % 64)) & 1);
+   }
+}
+
+static bool int_fits(int64_t value, int64_t size, bool is_signed)
+{
+   // Equivalent to the truncation check in TO_UNSIGNED and TO_SIGNED
+   if (size >= 64)
+      return is_signed || value >= 0;
+   else if (is_signed) {
+      const int64_t limit = INT64_C(1) << (size - 1);
+      return value >= -limit && value < limit;
+   }
+   else
+      return value >= 0 && value < (INT64_C(1) << size);
+}
+
+static void int_to_words(int64_t value, uint64_t *words, int nwords)
+{
+   words[0] = value;
+   for (int i = 1; i < nwords; i++)
+      words[i] = value < 0 ? ~UINT64_C(0) : 0;
+}
+
+static void numeric_arith(jit_func_t *f, jit_anchor_t *caller,
+                          jit_scalar_t *args, tlab_t *tlab, arith_op_t op,
+                          form_t form, bool is_signed)
+{
+   vector_t l = {}, r = {};
+   switch (form) {
+   case FORM_VV:
+      l = get_vector(args, 1);
+      r = get_vector(args, 4);
+      break;
+   case FORM_VI:
+      l = get_vector(args, 1);
+      r.length = l.length;   // Converted with TO_UNSIGNED(R, L'length)
+      break;
+   case FORM_IV:
+      r = get_vector(args, 2);
+      l.length = r.length;
+      break;
+   }
+
+   if (l.length < 1 || r.length < 1)
+      GENERIC();
+
+   int64_t size;
+   if (op == OP_MUL) {
+      size = l.length + r.length;
+      if (size > 64)
+         GENERIC();
+   }
+   else {
+      size = MAX(l.length, r.length);
+      if (size > MAX_BITS)
+         GENERIC();
+   }
+
+   const int nwords = (size + 63) / 64;
+   uint64_t lw[MAX_WORDS], rw[MAX_WORDS];
+
+   if (form == FORM_IV) {
+      if (!int_fits(args[1].integer, l.length, is_signed))
+         GENERIC();
+      int_to_words(args[1].integer, lw, nwords);
+   }
+   else if (!pack_bits(l, lw, nwords, is_signed))
+      GENERIC();
+
+   if (form == FORM_VI) {
+      if (!int_fits(args[4].integer, r.length, is_signed))
+         GENERIC();
+      int_to_words(args[4].integer, rw, nwords);
+   }
+   else if (!pack_bits(r, rw, nwords, is_signed))
+      GENERIC();
+
+   uint64_t result[MAX_WORDS];
+   switch (op) {
+   case OP_ADD:
+   case OP_SUB:
+      {
+         uint64_t carry = (op == OP_SUB);
+         for (int i = 0; i < nwords; i++) {
+            const uint64_t a = lw[i];
+            const uint64_t b = (op == OP_SUB) ? ~rw[i] : rw[i];
+            const uint64_t sum = a + b;
+            result[i] = sum + carry;
+            carry = (sum < a) | (result[i] < sum);
+         }
+      }
+      break;
+   case OP_MUL:
+      // Both operands are extended to 64 bits and the true product
+      // fits in SIZE bits so the low bits are correct for signed too
+      result[0] = lw[0] * rw[0];
+      break;
+   }
+
+   uint8_t *mem = alloc_result(caller, args, tlab, size, true);
+   unpack_bits(result, size, mem);
+}
+
+static void numeric_compare(jit_func_t *f, jit_anchor_t *caller,
+                            jit_scalar_t *args, tlab_t *tlab, cmp_op_t op,
+                            form_t form, bool is_signed)
+{
+   vector_t l = {}, r = {};
+   switch (form) {
+   case FORM_VV:
+      l = get_vector(args, 1);
+      r = get_vector(args, 4);
+      break;
+   case FORM_VI:
+      l = get_vector(args, 1);
+      r.length = 64;
+      break;
+   case FORM_IV:
+      r = get_vector(args, 2);
+      l.length = 64;
+      break;
+   }
+
+   // The mixed integer forms compare the numeric values even when
+   // the integer does not fit in the vector
+   const int64_t size = MAX(l.length, r.length);
+   if (l.length < 1 || r.length < 1 || size > MAX_BITS)
+      GENERIC();
+
+   const int nwords = (size + 63) / 64;
+   uint64_t lw[MAX_WORDS], rw[MAX_WORDS];
+
+   if (form == FORM_IV)
+      int_to_words(args[1].integer, lw, nwords);
+   else if (!pack_bits(l, lw, nwords, is_signed))
+      GENERIC();
+
+   if (form == FORM_VI)
+      int_to_words(args[4].integer, rw, nwords);
+   else if (!pack_bits(r, rw, nwords, is_signed))
+      GENERIC();
+
+   int cmp = 0;
+   for (int i = nwords - 1; i >= 0 && cmp == 0; i--) {
+      if (i == nwords - 1 && is_signed)
+         cmp = ((int64_t)lw[i] > (int64_t)rw[i])
+            - ((int64_t)lw[i] < (int64_t)rw[i]);
+      else
+         cmp = (lw[i] > rw[i]) - (lw[i] < rw[i]);
+   }
+
+   switch (op) {
+   case CMP_EQ:  args[0].integer = (cmp == 0); break;
+   case CMP_NEQ: args[0].integer = (cmp != 0); break;
+   case CMP_LT:  args[0].integer = (cmp < 0); break;
+   case CMP_LE:  args[0].integer = (cmp <= 0); break;
+   case CMP_GT:  args[0].integer = (cmp > 0); break;
+   case CMP_GE:  args[0].integer = (cmp >= 0); break;
+   }
+}
+
+static void numeric_resize(jit_func_t *f, jit_anchor_t *caller,
+                           jit_scalar_t *args, tlab_t *tlab, bool is_signed)
+{
+   const vector_t arg = get_vector(args, 1);
+   const int64_t new_size = args[4].integer;
+
+   if (new_size < 1 || arg.length == 0)
+      GENERIC();
+
+   // RESIZE copies elements verbatim including metavalues
+   uint8_t *mem = alloc_result(caller, args, tlab, new_size, true);
+
+   if (is_signed) {
+      const int64_t count = MIN(arg.length, new_size) - 1;
+      memset(mem, arg.ptr[0], new_size - count);
+      memcpy(mem + new_size - count, arg.ptr + arg.length - count, count);
+   }
+   else if (new_size < arg.length)
+      memcpy(mem, arg.ptr + arg.length - new_size, new_size);
+   else {
+      memset(mem, _0, new_size - arg.length);
+      memcpy(mem + new_size - arg.length, arg.ptr, arg.length);
+   }
+}
+
+static void numeric_to_vector(jit_func_t *f, jit_anchor_t *caller,
+                              jit_scalar_t *args, tlab_t *tlab,
+                              bool is_signed)
+{
+   const int64_t value = args[1].integer;
+   const int64_t size = args[2].integer;
+
+   if (size < 1 || !int_fits(value, size, is_signed))
+      GENERIC();
+
+   uint8_t *mem = alloc_result(caller, args, tlab, size, true);
+
+   for (int64_t i = 0; i < size; i++) {
+      const int64_t bit = size - 1 - i;
+      if (bit < 63)
+         mem[i] = _0 + ((value >> bit) & 1);
+      else
+         mem[i] = value < 0 ? _1 : _0;
+   }
+}
+
+static void numeric_to_integer(jit_func_t *f, jit_anchor_t *caller,
+                               jit_scalar_t *args, tlab_t *tlab,
+                               bool is_signed)
+{
+   const vector_t arg = get_vector(args, 1);
+
+   if (arg.length < 1 || arg.length > MAX_BITS)
+      GENERIC();
+
+   const int nwords = (arg.length + 63) / 64;
+   uint64_t words[MAX_WORDS];
+   if (!pack_bits(arg, words, nwords, is_signed))
+      GENERIC();
+
+   // Only handle results in the range of a 32-bit INTEGER: the generic
+   // implementation reports the overflow otherwise
+   const int64_t value = words[0];
+   for (int i = 1; i < nwords; i++) {
+      if (words[i] != (value < 0 ? ~UINT64_C(0) : 0))
+         GENERIC();
+   }
+
+   if (value > INT32_MAX || value < (is_signed ? INT32_MIN : 0))
+      GENERIC();
+
+   args[0].integer = value;
+}
+
+static void numeric_shift(jit_func_t *f, jit_anchor_t *caller,
+                          jit_scalar_t *args, tlab_t *tlab, bool left,
+                          bool arith)
+{
+   const vector_t arg = get_vector(args, 1);
+   const int64_t count = args[4].integer;
+
+   // Arithmetic shift by zero returns ARG with its original index range
+   if (arg.length < 1 || (arith && (arg.length == 1 || count == 0)))
+      GENERIC();
+
+   // Shifts copy elements verbatim including metavalues
+   uint8_t *mem = alloc_result(caller, args, tlab, arg.length, true);
+
+   if (arith) {
+      const int64_t n = MIN(count, arg.length - 1);
+      memset(mem, arg.ptr[0], n);
+      memcpy(mem + n, arg.ptr, arg.length - n);
+   }
+   else if (count >= arg.length)
+      memset(mem, _0, arg.length);
+   else if (left) {
+      memcpy(mem, arg.ptr + count, arg.length - count);
+      memset(mem + arg.length - count, _0, count);
+   }
+   else {
+      memset(mem, _0, count);
+      memcpy(mem + count, arg.ptr, arg.length - count);
+   }
+}
+
+static inline uint8_t logic_table(logic_op_t op, uint8_t a, uint8_t b)
+{
+   switch (op) {
+   case LOGIC_AND:  return and_table[a][b];
+   case LOGIC_OR:   return or_table[a][b];
+   case LOGIC_XOR:  return xor_table[a][b];
+   case LOGIC_NAND: return not_table[and_table[a][b]];
+   case LOGIC_NOR:  return not_table[or_table[a][b]];
+   case LOGIC_XNOR: return not_table[xor_table[a][b]];
+   }
+
+   return _X;
+}
+
+static inline uint64_t logic_word(logic_op_t op, uint64_t a, uint64_t b)
+{
+   // Each byte is either '0' (2) or '1' (3) so only the low bit differs
+   switch (op) {
+   case LOGIC_AND:  return a & b;
+   case LOGIC_OR:   return a | b;
+   case LOGIC_XOR:  return (a ^ b) | BYTES_02;
+   case LOGIC_NAND: return (a & b) ^ BYTES_01;
+   case LOGIC_NOR:  return (a | b) ^ BYTES_01;
+   case LOGIC_XNOR: return ((a ^ b) | BYTES_02) ^ BYTES_01;
+   }
+
+   return 0;
+}
+
+static void std_logic_binary(jit_func_t *f, jit_anchor_t *caller,
+                             jit_scalar_t *args, tlab_t *tlab, logic_op_t op)
+{
+   const vector_t l = get_vector(args, 1);
+   const vector_t r = get_vector(args, 4);
+
+   if (l.length != r.length)
+      GENERIC();
+
+   uint8_t *mem = alloc_result(caller, args, tlab, l.length, false);
+
+   int64_t i = 0;
+   for (; i + 8 <= l.length; i += 8) {
+      uint64_t a, b;
+      memcpy(&a, l.ptr + i, sizeof(uint64_t));
+      memcpy(&b, r.ptr + i, sizeof(uint64_t));
+
+      if ((a & BYTES_FE) == BYTES_02 && (b & BYTES_FE) == BYTES_02) {
+         const uint64_t result = logic_word(op, a, b);
+         memcpy(mem + i, &result, sizeof(uint64_t));
+      }
+      else {
+         for (int j = 0; j < 8; j++)
+            mem[i + j] = logic_table(op, l.ptr[i + j], r.ptr[i + j]);
+      }
+   }
+
+   for (; i < l.length; i++)
+      mem[i] = logic_table(op, l.ptr[i], r.ptr[i]);
+}
+
+INTRINSIC(std_logic_not)
+{
+   const vector_t arg = get_vector(args, 1);
+
+   uint8_t *mem = alloc_result(caller, args, tlab, arg.length, false);
+
+   int64_t i = 0;
+   for (; i + 8 <= arg.length; i += 8) {
+      uint64_t a;
+      memcpy(&a, arg.ptr + i, sizeof(uint64_t));
+
+      if ((a & BYTES_FE) == BYTES_02) {
+         const uint64_t result = a ^ BYTES_01;
+         memcpy(mem + i, &result, sizeof(uint64_t));
+      }
+      else {
+         for (int j = 0; j < 8; j++)
+            mem[i + j] = not_table[arg.ptr[i + j]];
+      }
+   }
+
+   for (; i < arg.length; i++)
+      mem[i] = not_table[arg.ptr[i]];
+}
+
+#define NUMERIC_FORMS(impl, name, op)                                   \
+   INTRINSIC(name##_uu) { impl(CTX, op, FORM_VV, false); }              \
+   INTRINSIC(name##_ss) { impl(CTX, op, FORM_VV, true); }               \
+   INTRINSIC(name##_un) { impl(CTX, op, FORM_VI, false); }              \
+   INTRINSIC(name##_nu) { impl(CTX, op, FORM_IV, false); }              \
+   INTRINSIC(name##_si) { impl(CTX, op, FORM_VI, true); }               \
+   INTRINSIC(name##_is) { impl(CTX, op, FORM_IV, true); }
+
+NUMERIC_FORMS(numeric_arith, numeric_add, OP_ADD)
+NUMERIC_FORMS(numeric_arith, numeric_sub, OP_SUB)
+NUMERIC_FORMS(numeric_arith, numeric_mul, OP_MUL)
+NUMERIC_FORMS(numeric_compare, numeric_eq, CMP_EQ)
+NUMERIC_FORMS(numeric_compare, numeric_neq, CMP_NEQ)
+NUMERIC_FORMS(numeric_compare, numeric_lt, CMP_LT)
+NUMERIC_FORMS(numeric_compare, numeric_le, CMP_LE)
+NUMERIC_FORMS(numeric_compare, numeric_gt, CMP_GT)
+NUMERIC_FORMS(numeric_compare, numeric_ge, CMP_GE)
+
+INTRINSIC(numeric_resize_u) { numeric_resize(CTX, false); }
+INTRINSIC(numeric_resize_s) { numeric_resize(CTX, true); }
+INTRINSIC(numeric_to_unsigned) { numeric_to_vector(CTX, false); }
+INTRINSIC(numeric_to_signed) { numeric_to_vector(CTX, true); }
+INTRINSIC(numeric_to_integer_u) { numeric_to_integer(CTX, false); }
+INTRINSIC(numeric_to_integer_s) { numeric_to_integer(CTX, true); }
+INTRINSIC(numeric_shift_left) { numeric_shift(CTX, true, false); }
+INTRINSIC(numeric_shift_right_u) { numeric_shift(CTX, false, false); }
+INTRINSIC(numeric_shift_right_s) { numeric_shift(CTX, false, true); }
+
+INTRINSIC(std_logic_and) { std_logic_binary(CTX, LOGIC_AND); }
+INTRINSIC(std_logic_or) { std_logic_binary(CTX, LOGIC_OR); }
+INTRINSIC(std_logic_xor) { std_logic_binary(CTX, LOGIC_XOR); }
+INTRINSIC(std_logic_nand) { std_logic_binary(CTX, LOGIC_NAND); }
+INTRINSIC(std_logic_nor) { std_logic_binary(CTX, LOGIC_NOR); }
+INTRINSIC(std_logic_xnor) { std_logic_binary(CTX, LOGIC_XNOR); }
+
+#define NUMERIC_STD "IEEE.NUMERIC_STD."
+#define NAT "7NATURAL"
+
+#define NUMERIC_ENTRIES(sym, name, U, S, RU, RS)                        \
+   { NUMERIC_STD "\"" sym "\"(" U U ")" RU, name##_uu },                \
+   { NUMERIC_STD "\"" sym "\"(" S S ")" RS, name##_ss },                \
+   { NUMERIC_STD "\"" sym "\"(" U NAT ")" RU, name##_un },              \
+   { NUMERIC_STD "\"" sym "\"(" NAT U ")" RU, name##_nu },              \
+   { NUMERIC_STD "\"" sym "\"(" S "I)" RS, name##_si },                 \
+   { NUMERIC_STD "\"" sym "\"(I" S ")" RS, name##_is }
+
+#define NUMERIC_STD_INTRINSICS(U, S)                                    \
+   NUMERIC_ENTRIES("+", numeric_add, U, S, U, S),                       \
+   NUMERIC_ENTRIES("-", numeric_sub, U, S, U, S),                       \
+   NUMERIC_ENTRIES("*", numeric_mul, U, S, U, S),                       \
+   NUMERIC_ENTRIES("=", numeric_eq, U, S, "B", "B"),                    \
+   NUMERIC_ENTRIES("/=", numeric_neq, U, S, "B", "B"),                  \
+   NUMERIC_ENTRIES("<", numeric_lt, U, S, "B", "B"),                    \
+   NUMERIC_ENTRIES("<=", numeric_le, U, S, "B", "B"),                   \
+   NUMERIC_ENTRIES(">", numeric_gt, U, S, "B", "B"),                    \
+   NUMERIC_ENTRIES(">=", numeric_ge, U, S, "B", "B"),                   \
+   { NUMERIC_STD "RESIZE(" U NAT ")" U, numeric_resize_u },             \
+   { NUMERIC_STD "RESIZE(" S NAT ")" S, numeric_resize_s },             \
+   { NUMERIC_STD "TO_UNSIGNED(" NAT NAT ")" U, numeric_to_unsigned },   \
+   { NUMERIC_STD "TO_SIGNED(I" NAT ")" S, numeric_to_signed },          \
+   { NUMERIC_STD "TO_INTEGER(" U ")" NAT, numeric_to_integer_u },       \
+   { NUMERIC_STD "TO_INTEGER(" S ")I", numeric_to_integer_s },          \
+   { NUMERIC_STD "SHIFT_LEFT(" U NAT ")" U, numeric_shift_left },       \
+   { NUMERIC_STD "SHIFT_LEFT(" S NAT ")" S, numeric_shift_left },       \
+   { NUMERIC_STD "SHIFT_RIGHT(" U NAT ")" U, numeric_shift_right_u },   \
+   { NUMERIC_STD "SHIFT_RIGHT(" S NAT ")" S, numeric_shift_right_s }
+
+#define STD_LOGIC_1164_INTRINSICS(V)                                    \
+   { "IEEE.STD_LOGIC_1164.\"and\"(" V V ")" V, std_logic_and },         \
+   { "IEEE.STD_LOGIC_1164.\"or\"(" V V ")" V, std_logic_or },           \
+   { "IEEE.STD_LOGIC_1164.\"xor\"(" V V ")" V, std_logic_xor },         \
+   { "IEEE.STD_LOGIC_1164.\"nand\"(" V V ")" V, std_logic_nand },       \
+   { "IEEE.STD_LOGIC_1164.\"nor\"(" V V ")" V, std_logic_nor },         \
+   { "IEEE.STD_LOGIC_1164.\"xnor\"(" V V ")" V, std_logic_xnor },       \
+   { "IEEE.STD_LOGIC_1164.\"not\"(" V ")" V, std_logic_not }
+
+static const intrinsic_t intrinsic_list[] = {
+   NUMERIC_STD_INTRINSICS("25IEEE.NUMERIC_STD.UNSIGNED",
+                          "23IEEE.NUMERIC_STD.SIGNED"),
+   NUMERIC_STD_INTRINSICS("36IEEE.NUMERIC_STD.UNRESOLVED_UNSIGNED",
+                          "34IEEE.NUMERIC_STD.UNRESOLVED_SIGNED"),
+   STD_LOGIC_1164_INTRINSICS("V"),   // STD_LOGIC_VECTOR before VHDL-2008
+   STD_LOGIC_1164_INTRINSICS("Y"),
+};
+
+jit_entry_fn_t jit_bind_intrinsic(ident_t name)
+{
+   const char *str = istr(name);
+   if (strncmp(str, "IEEE.", 5) != 0)
+      return NULL;
+
+   for (int i = 0; i < ARRAY_LEN(intrinsic_list); i++) {
+      if (strcmp(intrinsic_list[i].name, str) == 0)
+         return intrinsic_list[i].fn;
+   }
+
+   return NULL;
+}
@@ -24,6 +24,7 @@
 #include "mask.h"
 #include "option.h"
 #include "rt/cover.h"
+#include "rt/structs.h"
 #include "tree.h"
 #include "vcode.h"
 
@@ -615,10 +616,13 @@ static void macro_memset(jit_irgen_t *g, jit_size_t sz, jit_value_t dest,
    irgen_emit_binary(g, MACRO_MEMSET, sz, JIT_CC_NONE, count, dest, value);
 }
 
-static jit_value_t macro_galloc(jit_irgen_t *g, jit_value_t bytes)
+static jit_value_t macro_galloc(jit_irgen_t *g, jit_value_t bytes,
+                                bool noscan)
 {
    jit_reg_t r = irgen_alloc_reg(g);
-   irgen_emit_unary(g, MACRO_GALLOC, JIT_SZ_UNSPEC, JIT_CC_NONE, r, bytes);
+   jit_value_t arg2 = jit_value_from_int64(noscan);
+   irgen_emit_binary(g, MACRO_GALLOC, JIT_SZ_UNSPEC, JIT_CC_NONE,
+                     r, bytes, arg2);
    return jit_value_from_reg(r);
 }
 
@@ -821,6 +825,33 @@ static int irgen_size_bytes(vcode_type_t vtype)
    }
 }
 
+static bool irgen_is_pointer_free(vcode_type_t vtype)
+{
+   switch (vtype_kind(vtype)) {
+   case VCODE_TYPE_INT:
+   case VCODE_TYPE_OFFSET:
+   case VCODE_TYPE_REAL:
+      return true;
+
+   case VCODE_TYPE_CARRAY:
+      return irgen_is_pointer_free(vtype_elem(vtype));
+
+   case VCODE_TYPE_RECORD:
+      {
+         const int nfields = vtype_fields(vtype);
+         for (int i = 0; i < nfields; i++) {
+            if (!irgen_is_pointer_free(vtype_field(vtype, i)))
+               return false;
+         }
+
+         return true;
+      }
+
+   default:
+      return false;
+   }
+}
+
 static jit_size_t irgen_jit_size(vcode_type_t vtype)
 {
    const int bits = irgen_size_bits(vtype);
@@ -2583,7 +2614,11 @@ static void irgen_op_new(jit_irgen_t *g, int op)
    if (vcode_count_args(op) > 0)
       bytes = j_mul(g, bytes, irgen_get_arg(g, op, 0));
 
-   g->map[vcode_get_result(op)] = macro_galloc(g, bytes);
+   // Objects that cannot contain pointers are never scanned by the
+   // garbage collector
+   const bool noscan = irgen_is_pointer_free(vtype);
+
+   g->map[vcode_get_result(op)] = macro_galloc(g, bytes, noscan);
 }
 
 static void irgen_op_alloc(jit_irgen_t *g, int op)
@@ -3023,6 +3058,11 @@ static void irgen_op_last_value(jit_irgen_t *g, int op)
    g->map[result] = j_add(g, last_value, scaled);
 }
 
+static bool irgen_is_zero(jit_value_t value)
+{
+   return value.kind == JIT_VALUE_INT64 && value.int64 == 0;
+}
+
 static void irgen_op_sched_waveform(jit_irgen_t *g, int op)
 {
    jit_value_t shared = irgen_get_arg(g, op, 0);
@@ -3034,6 +3074,38 @@ static void irgen_op_sched_waveform(jit_irgen_t *g, int op)
 
    jit_value_t scalar = irgen_is_scalar(g, op, 2);
 
+   irgen_label_t *l_cont = NULL;
+
+   if (irgen_is_zero(after) && irgen_is_zero(reject) && scalar.int64) {
+      // The runtime sets SIG_F_INLINE_DRV on scalar signals with a
+      // single fast driver: the new value can be written straight into
+      // the driver and the update is scheduled when the process suspends
+      const int32_t valueoff =
+         (int32_t)offsetof(rt_signal_t, nexus.sources.u.driver.waveforms.value)
+         - (int32_t)offsetof(rt_signal_t, shared);
+
+      jit_value_t flags = j_load(g, JIT_SZ_32, jit_addr_from_value(shared, 4));
+
+      jit_value_t inlinebit = jit_value_from_int64(SIG_F_INLINE_DRV);
+      jit_value_t inlineflag = j_and(g, flags, inlinebit);
+
+      irgen_label_t *l_slow = irgen_alloc_label(g);
+      l_cont = irgen_alloc_label(g);
+
+      j_cmp(g, JIT_CC_EQ, inlineflag, jit_value_from_int64(0));
+      j_jump(g, JIT_CC_T, l_slow);
+
+      j_store(g, JIT_SZ_64, value, jit_addr_from_value(shared, valueoff));
+
+      jit_value_t pendbit = jit_value_from_int64(SIG_F_INLINE_PEND);
+      jit_value_t newflags = j_or(g, flags, pendbit);
+      j_store(g, JIT_SZ_32, newflags, jit_addr_from_value(shared, 4));
+
+      j_jump(g, JIT_CC_NONE, l_cont);
+
+      irgen_bind_label(g, l_slow);
+   }
+
    j_send(g, 0, shared);
    j_send(g, 1, offset);
    j_send(g, 2, count);
@@ -3043,6 +3115,9 @@ static void irgen_op_sched_waveform(jit_irgen_t *g, int op)
    j_send(g, 6, scalar);
 
    macro_exit(g, JIT_EXIT_SCHED_WAVEFORM);
+
+   if (l_cont != NULL)
+      irgen_bind_label(g, l_cont);
 }
 
 static void irgen_op_disconnect(jit_irgen_t *g, int op)
@@ -3099,9 +3174,16 @@ static void irgen_op_sched_event(jit_irgen_t *g, int op)
    jit_value_t offset = jit_value_from_reg(jit_value_as_reg(shared) + 1);
    jit_value_t count  = irgen_get_arg(g, op, 1);
 
+   jit_value_t mask;
+   if (vcode_count_args(op) > 2)
+      mask = irgen_get_arg(g, op, 2);
+   else
+      mask = jit_value_from_int64(-1);
+
    j_send(g, 0, shared);
    j_send(g, 1, offset);
    j_send(g, 2, count);
+   j_send(g, 3, mask);
    macro_exit(g, JIT_EXIT_SCHED_EVENT);
 }
 
@@ -3335,6 +3417,13 @@ static void irgen_op_cover_stmt(jit_irgen_t *g, int op)
    uint32_t tag = vcode_get_tag(op);
    jit_value_t mem = jit_addr_from_cover_tag(JIT_COVER_STMT, tag);
 
+   if (vcode_get_subkind(op) & COV_FLAG_HIT_ONCE) {
+      // Only record that the statement was executed: a plain store
+      // avoids the read-modify-write dependency on every iteration
+      j_store(g, JIT_SZ_32, jit_value_from_int64(1), mem);
+      return;
+   }
+
    // XXX: this should be atomic
    jit_value_t cur = j_load(g, JIT_SZ_32, mem);
    jit_value_t inc = j_add(g, cur, jit_value_from_int64(1));
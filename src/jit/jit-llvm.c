@@ -886,6 +886,7 @@ static LLVMValueRef llvm_get_fn(llvm_obj_t *obj, llvm_fn_t which)
       {
          LLVMTypeRef args[] = {
             obj->types[LLVM_INTPTR],
+            obj->types[LLVM_INT32],
 #ifdef LLVM_HAS_OPAQUE_POINTERS
             obj->types[LLVM_PTR],
 #else
@@ -1859,8 +1860,11 @@ static void cgen_op_call(llvm_obj_t *obj, cgen_block_t *cgb, jit_ir_t *ir)
       fptr = LLVMBuildLoad2(obj->builder, obj->types[LLVM_PTR], ptr, "");
 
 #if CLOSED_WORLD
-      LOCAL_TEXT_BUF symbol = safe_symbol(callee->name);
-      entry = llvm_add_fn(obj, tb_get(symbol), obj->types[LLVM_ENTRY_FN]);
+      // Intrinsics must be called through the function pointer
+      if (callee->fallback == NULL) {
+         LOCAL_TEXT_BUF symbol = safe_symbol(callee->name);
+         entry = llvm_add_fn(obj, tb_get(symbol), obj->types[LLVM_ENTRY_FN]);
+      }
 #endif
    }
    else
@@ -2097,10 +2101,13 @@ static void cgen_macro_galloc(llvm_obj_t *obj, cgen_block_t *cgb, jit_ir_t *ir)
 {
    cgen_sync_irpos(obj, cgb, ir);
 
+   assert(ir->arg2.kind == JIT_VALUE_INT64);
+
    LLVMValueRef size = cgen_get_value(obj, cgb, ir->arg1);
 
    LLVMValueRef args[] = {
       LLVMBuildTrunc(obj->builder, size, obj->types[LLVM_INTPTR], ""),
+      llvm_int32(obj, ir->arg2.int64),
       cgb->func->anchor
    };
    LLVMValueRef ptr = llvm_call_fn(obj, LLVM_MSPACE_ALLOC, args,
@@ -3035,7 +3042,7 @@ static void cgen_tlab_alloc_body(llvm_obj_t *obj)
 
    LLVMPositionBuilderAtEnd(obj->builder, slow_bb);
 
-   LLVMValueRef args[] = { bytes, anchor };
+   LLVMValueRef args[] = { bytes, llvm_int32(obj, 0), anchor };
    LLVMValueRef slow_ptr = llvm_call_fn(obj, LLVM_MSPACE_ALLOC, args,
                                         ARRAY_LEN(args));
 
@@ -3310,7 +3317,7 @@ static void jit_llvm_cgen(jit_t *j, jit_handle_t handle, void *context)
    code_load_object(blob, LLVMGetBufferStart(buf), objsz);
 
    const size_t size = blob->wptr - base;
-   code_blob_finalise(blob, &(f->entry));
+   code_blob_finalise(blob, jit_code_slot(f));
 
    if (opt_get_int(OPT_JIT_LOG)) {
       const uint64_t end_us = get_timestamp_us();
@@ -3353,13 +3360,21 @@ void jit_register_llvm_plugin(jit_t *j)
 ////////////////////////////////////////////////////////////////////////////////
 // Ahead-of-time code generation
 
-llvm_obj_t *llvm_obj_new(const char *name)
+llvm_obj_t *llvm_obj_new(const char *name, llvm_obj_kind_t kind)
 {
    llvm_obj_t *obj = xcalloc(sizeof(llvm_obj_t));
    obj->context     = LLVMContextCreate();
    obj->module      = LLVMModuleCreateWithNameInContext(name, obj->context);
    obj->builder     = LLVMCreateBuilderInContext(obj->context);
-   obj->target      = llvm_target_machine(LLVMRelocPIC, LLVMCodeModelDefault);
+
+   if (kind == LLVM_OBJ_LOADABLE) {
+      // Use the same code model as the JIT so that the object can be
+      // placed anywhere in the address space by code_load_object
+      obj->target = llvm_target_machine(LLVMRelocStatic, JIT_CODE_MODEL);
+   }
+   else
+      obj->target = llvm_target_machine(LLVMRelocPIC, LLVMCodeModelDefault);
+
    obj->data_ref    = LLVMCreateTargetDataLayout(obj->target);
    obj->pack_writer = pack_writer_new();
 
@@ -32,7 +32,12 @@ typedef enum {
    LLVM_O3
 } llvm_opt_level_t;
 
-llvm_obj_t *llvm_obj_new(const char *name);
+typedef enum {
+   LLVM_OBJ_SHARED,      // Linked into a shared library
+   LLVM_OBJ_LOADABLE     // Loaded directly into the code cache
+} llvm_obj_kind_t;
+
+llvm_obj_t *llvm_obj_new(const char *name, llvm_obj_kind_t kind);
 void llvm_add_abi_version(llvm_obj_t *obj);
 void llvm_aot_compile(llvm_obj_t *obj, jit_t *j, jit_handle_t handle);
 void llvm_obj_finalise(llvm_obj_t *obj, llvm_opt_level_t level);
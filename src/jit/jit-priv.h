@@ -301,6 +301,7 @@ typedef struct _jit_func {
    jit_cfg_t      *cfg;
    ffi_spec_t      spec;
    object_t       *object;
+   jit_entry_fn_t  fallback;   // Generic implementation of intrinsic
 } jit_func_t;
 
 // The code generator knows the layout of this struct
@@ -358,10 +359,12 @@ void **jit_get_privdata_ptr(jit_t *j, jit_func_t *f);
 bool jit_has_runtime(jit_t *j);
 int jit_backedge_limit(jit_t *j);
 void jit_tier_up(jit_func_t *f);
+jit_entry_fn_t *jit_code_slot(jit_func_t *f);
 jit_thread_local_t *jit_thread_local(void);
 void jit_fill_irbuf(jit_func_t *f);
 int32_t *jit_get_cover_ptr(jit_t *j, jit_value_t addr);
 object_t *jit_get_locus(jit_value_t value);
+jit_entry_fn_t jit_bind_intrinsic(ident_t name);
 
 jit_cfg_t *jit_get_cfg(jit_func_t *f);
 void jit_free_cfg(jit_func_t *f);
@@ -390,6 +393,8 @@ void code_blob_finalise(code_blob_t *blob, jit_entry_fn_t *entry);
 void code_blob_mark(code_blob_t *blob, jit_label_t label);
 void code_blob_patch(code_blob_t *blob, jit_label_t label, code_patch_fn_t fn);
 void code_load_object(code_blob_t *blob, const void *data, size_t size);
+void code_load_archive(code_cache_t *code, ident_t name, const void *data,
+                       size_t size, shash_t *symbols);
 
 bool jit_pack_fill(jit_pack_t *jp, jit_t *j, jit_func_t *f);
 void jit_pack_put(jit_pack_t *jp, ident_t name, const uint8_t *cpool,
@@ -407,7 +412,7 @@ void __nvc_do_exit(jit_exit_t which, jit_anchor_t *anchor, jit_scalar_t *args,
                    tlab_t *tlab);
 void __nvc_do_fficall(jit_foreign_t *ff, jit_anchor_t *anchor,
                       jit_scalar_t *args);
-void *__nvc_mspace_alloc(uintptr_t size, jit_anchor_t *anchor);
+void *__nvc_mspace_alloc(uintptr_t size, int32_t noscan, jit_anchor_t *anchor);
 void _debug_out(intptr_t val, int32_t reg);
 
 #endif  // _JIT_PRIV_H
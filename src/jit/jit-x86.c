@@ -1398,7 +1398,10 @@ static void jit_x86_macro_lalloc(code_blob_t *blob, jit_x86_state_t *state,
 static void jit_x86_macro_galloc(code_blob_t *blob, jit_x86_state_t *state,
                                  jit_ir_t *ir)
 {
+   assert(ir->arg2.kind == JIT_VALUE_INT64);
+
    jit_x86_get(blob, __EAX, ir->arg1);
+   MOV(__R10, IMM(ir->arg2.int64), __DWORD);
 
    CALL(PTR(state->stubs[ALLOC_STUB]));
 
@@ -1822,7 +1825,7 @@ static void jit_x86_cgen(jit_t *j, jit_handle_t handle, void *context)
    LEAVE();
    RET();
 
-   code_blob_finalise(blob, &(f->entry));
+   code_blob_finalise(blob, jit_code_slot(f));
 }
 
 static void jit_x86_gen_exit_stub(jit_x86_state_t *state)
@@ -1888,9 +1891,10 @@ static void jit_x86_gen_alloc_stub(jit_x86_state_t *state)
 
    jit_x86_push_call_clobbered(blob);
 
-   // Size in EAX, clobbers FPTR
+   // Size in EAX, no-scan flag in R10, clobbers FPTR
    MOV(CARG0_REG, __EAX, __DWORD);
-   MOV(CARG1_REG, ANCHOR_REG, __QWORD);
+   MOV(CARG2_REG, ANCHOR_REG, __QWORD);
+   MOV(CARG1_REG, __R10, __DWORD);
 
    MOV(__EAX, PTR(__nvc_mspace_alloc), __QWORD);
    CALL(__EAX);
@@ -1932,7 +1936,8 @@ static void jit_x86_gen_tlab_stub(jit_x86_state_t *state)
    jit_x86_push_call_clobbered(blob);
 
    MOV(CARG0_REG, __EAX, __DWORD);
-   MOV(CARG1_REG, ANCHOR_REG, __QWORD);
+   MOV(CARG2_REG, ANCHOR_REG, __QWORD);
+   XOR(CARG1_REG, CARG1_REG, __DWORD);
 
    MOV(__EAX, PTR(__nvc_mspace_alloc), __QWORD);
    CALL(__EAX);
@@ -95,6 +95,7 @@ void jit_check_interrupt(jit_t *j);
 void jit_reset(jit_t *j);
 
 void *jit_mspace_alloc(size_t size) RETURNS_NONNULL;
+void *jit_mspace_alloc_noscan(size_t size) RETURNS_NONNULL;
 jit_stack_trace_t *jit_stack_trace(void);
 
 void jit_alloc_cover_mem(jit_t *j, int n_stmts, int n_branches, int n_toggles,
@@ -0,0 +1,1419 @@
+//
+//  Copyright (C) 2011-2023  Nick Gasson
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "util.h"
+#include "common.h"
+#include "diag.h"
+#include "option.h"
+#include "scan.h"
+#include "thread.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define KEYWORD_MAX_LEN 18
+#define KEYWORD_HASH_SZ 512
+
+typedef struct _lexer {
+   const char     *start;
+   const char     *end;
+   const char     *ptr;
+   const char     *line_start;
+   unsigned        lineno;
+   lex_mode_t      mode;
+   token_t         last_token;
+   loc_file_ref_t  file_ref;
+   yylval_t       *lval;
+   loc_t          *lloc;
+   unsigned        skip_line;
+   unsigned        skip_col;
+   unsigned        skip_len;
+   bool           *warned_kw;
+   uint16_t        warned_08;
+   bool            warned_comment;
+   bool            warned_utf8;
+   bool            printed_psl;
+} lexer_t;
+
+typedef struct {
+   const char      *name;
+   token_t          vhdl;
+   token_t          psl;
+   token_t          psl_bang;
+   vhdl_standard_t  lrm;
+} keyword_t;
+
+typedef enum {
+   CC_VHDL_START = (1 << 0),
+   CC_VHDL_ID    = (1 << 1),
+   CC_VLOG_START = (1 << 2),
+   CC_VLOG_ID    = (1 << 3),
+   CC_SPACE      = (1 << 4),
+   CC_DIGIT      = (1 << 5),
+   CC_HEX        = (1 << 6),
+} char_class_t;
+
+static keyword_t keywords[] = {
+   { "ENTITY", tENTITY },
+   { "IS", tIS, tIS },
+   { "END", tEND },
+   { "GENERIC", tGENERIC },
+   { "PORT", tPORT },
+   { "CONSTANT", tCONSTANT },
+   { "COMPONENT", tCOMPONENT },
+   { "CONFIGURATION", tCONFIGURATION },
+   { "ARCHITECTURE", tARCHITECTURE },
+   { "OF", tOF },
+   { "BEGIN", tBEGIN },
+   { "IN", tIN },
+   { "OUT", tOUT },
+   { "BUFFER", tBUFFER },
+   { "BUS", tBUS },
+   { "REGISTER", tREGISTER },
+   { "UNAFFECTED", tUNAFFECTED },
+   { "SIGNAL", tSIGNAL },
+   { "PROCESS", tPROCESS },
+   { "WAIT", tWAIT },
+   { "REPORT", tREPORT, tREPORT },
+   { "INOUT", tINOUT },
+   { "LINKAGE", tLINKAGE },
+   { "VARIABLE", tVARIABLE },
+   { "FOR", tFOR },
+   { "TYPE", tTYPE },
+   { "SUBTYPE", tSUBTYPE },
+   { "UNITS", tUNITS },
+   { "PACKAGE", tPACKAGE },
+   { "LIBRARY", tLIBRARY },
+   { "USE", tUSE },
+   { "FUNCTION", tFUNCTION },
+   { "IMPURE", tIMPURE },
+   { "PURE", tPURE },
+   { "RETURN", tRETURN },
+   { "ARRAY", tARRAY },
+   { "OTHERS", tOTHERS },
+   { "ASSERT", tASSERT, tASSERT },
+   { "SEVERITY", tSEVERITY, tSEVERITY },
+   { "ON", tON },
+   { "MAP", tMAP },
+   { "IF", tIF },
+   { "THEN", tTHEN },
+   { "ELSE", tELSE },
+   { "ELSIF", tELSIF },
+   { "BODY", tBODY },
+   { "WHILE", tWHILE },
+   { "LOOP", tLOOP },
+   { "AFTER", tAFTER },
+   { "ALIAS", tALIAS },
+   { "ATTRIBUTE", tATTRIBUTE },
+   { "PROCEDURE", tPROCEDURE },
+   { "POSTPONED", tPOSTPONED },
+   { "EXIT", tEXIT },
+   { "WHEN", tWHEN },
+   { "CASE", tCASE },
+   { "TRANSPORT", tTRANSPORT },
+   { "REJECT", tREJECT },
+   { "INERTIAL", tINERTIAL },
+   { "BLOCK", tBLOCK },
+   { "WITH", tWITH },
+   { "SELECT", tSELECT },
+   { "GENERATE", tGENERATE },
+   { "ACCESS", tACCESS },
+   { "FILE", tFILE },
+   { "OPEN", tOPEN },
+   { "UNTIL", tUNTIL },
+   { "RECORD", tRECORD },
+   { "NEW", tNEW },
+   { "SHARED", tSHARED },
+   { "NEXT", tNEXT, tNEXT, tNEXT1 },
+   { "LITERAL", tLITERAL },
+   { "GROUP", tGROUP },
+   { "LABEL", tLABEL },
+   { "GUARDED", tGUARDED },
+   { "DISCONNECT", tDISCONNECT },
+   { "REVERSE_RANGE", tREVRANGE },
+   { "PROTECTED", tPROTECTED, .lrm = STD_00 },
+   { "CONTEXT", tCONTEXT, .lrm = STD_08 },
+   { "FORCE", tFORCE, .lrm = STD_08 },
+   { "RELEASE", tRELEASE, .lrm = STD_08 },
+   { "PARAMETER", tPARAMETER, .lrm = STD_08 },
+   { "DEFAULT", tDEFAULT, tDEFAULT, .lrm = STD_08 },
+   { "VIEW", tVIEW, .lrm = STD_19 },
+   { "AND", tAND, tAND },
+   { "OR", tOR, tOR },
+   { "XOR", tXOR, tXOR },
+   { "XNOR", tXNOR, tXNOR },
+   { "NAND", tNAND, tNAND },
+   { "NOR", tNOR, tNOR },
+   { "ABS", tABS, tABS },
+   { "NOT", tNOT, tNOT },
+   { "ALL", tALL, tALL },
+   { "SLL", tSLL, tSLL },
+   { "SRL", tSRL, tSRL },
+   { "SLA", tSLA, tSLA },
+   { "SRA", tSRA, tSRA },
+   { "ROL", tROL, tROL },
+   { "ROR", tROR, tROR },
+   { "REM", tREM, tREM },
+   { "MOD", tMOD, tMOD },
+   { "NULL", tNULL, tNULL },
+   { "RANGE", tRANGE, tRANGE },
+   { "TO", tTO, tTO },
+   { "DOWNTO", tDOWNTO, tDOWNTO },
+   { "ASSUME", 0, tASSUME },
+   { "ASSUME_GUARANTEE", 0, tASSUMEG },
+   { "RESTRICT", 0, tRESTRICT },
+   { "RESTRICT_GUARANTEE", 0, tRESTRICTG },
+   { "STRONG", 0, tSTRONG },
+   { "FAIRNESS", 0, tFAIRNESS },
+   { "COVER", 0, tCOVER },
+   { "PROPERTY", 0, tPROPERTY },
+   { "SEQUENCE", 0, tSEQUENCE },
+   { "CONST", 0, tCONST },
+   { "MUTABLE", 0, tMUTABLE },
+   { "HDLTYPE", 0, tHDLTYPE },
+   { "BOOLEAN", 0, tBOOLEAN },
+   { "BIT", 0, tBIT },
+   { "BITVECTOR", 0, tBITVECTOR },
+   { "NUMERIC", 0, tNUMERIC },
+   { "STRING", 0, tSTRINGK },
+   { "ALWAYS", 0, tALWAYS },
+   { "CLOCK", 0, tCLOCK },
+   { "NEVER", 0, tNEVER },
+   { "EVENTUALLY", 0, 0, tEVENTUALLY },
+   { "NEXT_A", 0, tNEXTA, tNEXTA1 },
+   { "NEXT_E", 0, tNEXTE, tNEXTE1 },
+   { "NEXT_EVENT", 0, tNEXTEVENT, tNEXTEVENT1 },
+   { "WITHIN", 0, tWITHIN },
+};
+
+static const struct {
+   const char *name;
+   token_t     token;
+} vlog_keywords[] = {
+   { "module", tMODULE },
+   { "endmodule", tENDMODULE },
+   { "input", tINPUT },
+   { "output", tOUTPUT },
+   { "reg", tREG },
+   { "always", tALWAYS },
+   { "posedge", tPOSEDGE },
+   { "negedge", tNEGEDGE },
+   { "initial", tINITIAL },
+   { "begin", tBEGIN },
+   { "end", tEND },
+   { "wire", tWIRE },
+   { "assign", tASSIGN },
+};
+
+static const struct {
+   const char *name;
+   token_t     token;
+} directives[] = {
+   { "ELSIF", tCONDELSIF },
+   { "ELSE", tCONDELSE },
+   { "END", tCONDEND },
+   { "ERROR", tCONDERROR },
+   { "WARNING", tCONDWARN },
+   { "IF", tCONDIF },
+};
+
+static keyword_t   *keyword_hash[KEYWORD_HASH_SZ];
+static uint8_t      char_class[256];
+static bool         tables_ready = false;
+static nvc_lock_t   tables_lock = 0;
+
+static inline uint32_t keyword_hash_fn(const char *str, size_t len)
+{
+   uint32_t hash = 2166136261u;
+   for (size_t i = 0; i < len; i++)
+      hash = (hash ^ (uint8_t)str[i]) * 16777619u;
+   return hash;
+}
+
+static void init_tables(void)
+{
+   if (load_acquire(&tables_ready))
+      return;
+
+   SCOPED_LOCK(tables_lock);
+
+   if (tables_ready)
+      return;
+
+   for (int i = 0; i < ARRAY_LEN(keywords); i++) {
+      const size_t len = strlen(keywords[i].name);
+      assert(len <= KEYWORD_MAX_LEN);
+
+      uint32_t slot = keyword_hash_fn(keywords[i].name, len);
+      for (;; slot++) {
+         keyword_t **kw = &(keyword_hash[slot & (KEYWORD_HASH_SZ - 1)]);
+         if (*kw == NULL) {
+            *kw = &(keywords[i]);
+            break;
+         }
+      }
+   }
+
+   for (int ch = 0; ch < 256; ch++) {
+      uint8_t cc = 0;
+
+      const bool lower = (ch >= 'a' && ch <= 'z') || (ch >= 0xdf && ch != 0xf7);
+      const bool upper = (ch >= 'A' && ch <= 'Z')
+         || (ch >= 0xc0 && ch <= 0xde && ch != 0xd7);
+      const bool digit = ch >= '0' && ch <= '9';
+
+      if (lower || upper)
+         cc |= CC_VHDL_START | CC_VHDL_ID;
+      if (digit || ch == '_')
+         cc |= CC_VHDL_ID;
+      if ((ch < 0x80 && isalpha(ch)) || ch == '_')
+         cc |= CC_VLOG_START | CC_VLOG_ID;
+      if (digit || ch == '$')
+         cc |= CC_VLOG_ID;
+      if (ch == ' ' || ch == '\t' || ch == '\r')
+         cc |= CC_SPACE;
+      if (digit)
+         cc |= CC_DIGIT;
+      if (ch < 0x80 && isxdigit(ch))
+         cc |= CC_HEX;
+
+      char_class[ch] = cc;
+   }
+
+   store_release(&tables_ready, true);
+}
+
+static inline bool is_class(char ch, char_class_t cc)
+{
+   return char_class[(uint8_t)ch] & cc;
+}
+
+static const keyword_t *lookup_keyword(const char *upper, size_t len)
+{
+   uint32_t slot = keyword_hash_fn(upper, len);
+   for (;; slot++) {
+      const keyword_t *kw = keyword_hash[slot & (KEYWORD_HASH_SZ - 1)];
+      if (kw == NULL)
+         return NULL;
+      else if (strncmp(kw->name, upper, len) == 0 && kw->name[len] == '\0')
+         return kw;
+   }
+}
+
+static const char *skip_spaces(const char *p, const char *end)
+{
+#ifdef __SSE2__
+   const __m128i space = _mm_set1_epi8(' ');
+   const __m128i tab = _mm_set1_epi8('\t');
+   const __m128i cr = _mm_set1_epi8('\r');
+
+   while (p + 16 <= end) {
+      const __m128i v = _mm_loadu_si128((const __m128i *)p);
+      const __m128i match = _mm_or_si128(_mm_cmpeq_epi8(v, space),
+                                         _mm_or_si128(_mm_cmpeq_epi8(v, tab),
+                                                      _mm_cmpeq_epi8(v, cr)));
+      const unsigned mask = _mm_movemask_epi8(match);
+      if (mask != 0xffff)
+         return p + __builtin_ctz(~mask);
+
+      p += 16;
+   }
+#endif
+
+   while (p < end && is_class(*p, CC_SPACE))
+      p++;
+
+   return p;
+}
+
+static const char *skip_ident(const char *p, const char *end, char_class_t cc)
+{
+   for (;;) {
+#ifdef __SSE2__
+      // Fast path for runs of ASCII letters, digits, and underscores:
+      // bytes above 0x7f are negative as signed and never match
+      const __m128i under = _mm_set1_epi8('_');
+      const __m128i bit5 = _mm_set1_epi8(0x20);
+
+      while (p + 16 <= end) {
+         const __m128i v = _mm_loadu_si128((const __m128i *)p);
+         const __m128i lc = _mm_or_si128(v, bit5);
+         const __m128i alpha =
+            _mm_and_si128(_mm_cmpgt_epi8(lc, _mm_set1_epi8('a' - 1)),
+                          _mm_cmplt_epi8(lc, _mm_set1_epi8('z' + 1)));
+         const __m128i digit =
+            _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                          _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+         const __m128i match =
+            _mm_or_si128(alpha, _mm_or_si128(digit, _mm_cmpeq_epi8(v, under)));
+         const unsigned mask = _mm_movemask_epi8(match);
+         if (mask != 0xffff) {
+            p += __builtin_ctz(~mask);
+            break;
+         }
+
+         p += 16;
+      }
+#endif
+
+      // Slow path for non-ASCII letters and the end of the input
+      if (p == end || !is_class(*p, cc))
+         return p;
+
+      p++;
+   }
+}
+
+static bool match_nocase(const char *p, const char *end, const char *str)
+{
+   for (; *str; str++, p++) {
+      if (p == end || toupper_iso88591(*p) != *str)
+         return false;
+   }
+
+   return true;
+}
+
+static char *copy_text(const char *tok, size_t len)
+{
+   char *str = xmalloc(len + 1);
+   memcpy(str, tok, len);
+   str[len] = '\0';
+   return str;
+}
+
+static void lex_set_loc(lexer_t *lex, const char *tok, size_t len)
+{
+   const unsigned col = tok - lex->line_start;
+   *lex->lloc = get_loc(lex->lineno, col, lex->lineno, col + len - 1,
+                        lex->file_ref);
+
+   lex->skip_line = LINE_INVALID;
+}
+
+static token_t lex_token(lexer_t *lex, const char *tok, size_t len,
+                         token_t token)
+{
+   lex_set_loc(lex, tok, len);
+   lex->ptr = tok + len;
+   return (lex->last_token = token);
+}
+
+static void lex_skipped(lexer_t *lex, const char *from, size_t len)
+{
+   // Remember the location of the last ignored input which becomes the
+   // location of the end of file token
+   lex->skip_line = lex->lineno;
+   lex->skip_col  = from - lex->line_start;
+   lex->skip_len  = len;
+}
+
+static void lex_newline(lexer_t *lex, const char *nl)
+{
+   assert(*nl == '\n');
+
+   const unsigned col = nl - lex->line_start;
+
+   lex->lineno++;
+   lex->line_start = nl + 1;
+   lex->ptr = nl + 1;
+
+   lex->skip_line = lex->lineno;
+   lex->skip_col  = col;
+   lex->skip_len  = 1;
+}
+
+static void lex_skip_line(lexer_t *lex, const char *tok, const char *from)
+{
+   const char *nl = memchr(from, '\n', lex->end - from);
+   if (nl == NULL)
+      nl = lex->end;
+
+   if (nl > from)
+      lex_skipped(lex, from, nl - from);
+   else
+      lex_skipped(lex, tok, from - tok);
+
+   lex->ptr = nl;
+}
+
+static void lex_skip_block_comment(lexer_t *lex, const char *from)
+{
+   const char *p = from;
+   while (p < lex->end) {
+      if (*p == '\n') {
+         lex_newline(lex, p);
+         p++;
+      }
+      else if (*p == '*' && p + 1 < lex->end && p[1] == '/') {
+         lex_skipped(lex, p, 2);
+         p += 2;
+         break;
+      }
+      else
+         p++;
+   }
+
+   if (p == lex->end && p > from)
+      lex_skipped(lex, p - 1, 1);   // Unterminated comment
+
+   lex->ptr = p;
+}
+
+static void warn_lrm(lexer_t *lex, vhdl_standard_t std, const char *fmt, ...)
+{
+   va_list ap;
+   va_start(ap, fmt);
+
+   diag_t *d = diag_new(DIAG_WARN, lex->lloc);
+   diag_vprintf(d, fmt, ap);
+   diag_hint(d, NULL, "pass $bold$--std=%s$$ to enable this feature",
+             standard_text(std));
+   diag_emit(d);
+
+   va_end(ap);
+}
+
+static void warn_utf8(lexer_t *lex)
+{
+   if (!lex->warned_utf8) {
+      diag_t *d = diag_new(DIAG_WARN, lex->lloc);
+      diag_printf(d, "possible multi-byte UTF-8 character found in input");
+      diag_hint(d, NULL, "the native encoding of VHDL is ISO-8859-1");
+      diag_emit(d);
+
+      lex->warned_utf8 = true;
+   }
+}
+
+static bool begin_psl_comment(lexer_t *lex)
+{
+   if (opt_get_int(OPT_PSL_COMMENTS))
+      return true;
+   else if (!lex->printed_psl) {
+      note_at(lex->lloc, "pass $bold$--psl$$ to enable parsing of PSL "
+              "directives in comments");
+      lex->printed_psl = true;
+      return false;
+   }
+   else
+      return false;
+}
+
+static bool resolve_ir1045(lexer_t *lex)
+{
+   // See here for discussion:
+   //   http://www.eda-stds.org/isac/IRs-VHDL-93/IR1045.txt
+   // The set of tokens that may precede a character literal is
+   // disjoint from that which may precede a single tick token.
+
+   switch (lex->last_token) {
+   case tRSQUARE:
+   case tRPAREN:
+   case tALL:
+   case tID:
+      // Cannot be a character literal
+      return false;
+   default:
+      return true;
+   }
+}
+
+static token_t lex_token_08(lexer_t *lex, const char *tok, size_t len,
+                            token_t token)
+{
+   if (standard() < STD_08) {
+      lex_set_loc(lex, tok, len);
+      lex->ptr = tok + len;
+
+      const int index = token - tMEQ;
+      assert(index >= 0 && index < 16);
+
+      if (!(lex->warned_08 & (1 << index))) {
+         warn_lrm(lex, STD_08, "`%.*s' is a reserved word in VHDL-%s",
+                  (int)len, tok, standard_text(STD_08));
+         lex->warned_08 |= 1 << index;
+      }
+
+      return tERROR;
+   }
+   else
+      return lex_token(lex, tok, len, token);
+}
+
+static void strip_underscores(char *s)
+{
+   char *p;
+   for (p = s; *s != '\0'; s++)
+      if (*s != '_')
+         *p++ = *s;
+   *p = '\0';
+}
+
+static token_t parse_decimal_literal(lexer_t *lex, const char *str)
+{
+   // Transform a string into a literal as specified in LRM 13.4.1
+   //   decimal_literal ::= integer [.integer] [exponent]
+
+   int tok = tERROR;
+   char *tmp LOCAL = xstrdup(str);
+   strip_underscores(tmp);
+
+   char *dot = strpbrk(tmp, ".");
+
+   if (dot == NULL) {
+      char *sign = strpbrk(tmp, "-");
+      char *val  = strtok(tmp, "eE");
+      char *exp  = strtok(NULL, "eE");
+
+      errno = 0;
+      lex->lval->i64 = strtoll(val, NULL, 10);
+      bool overflow = (errno == ERANGE);
+
+      long long int e = (exp ? atoll(exp) : 0);
+
+      if (e >= 0) {  // Minus sign forbidden for an integer literal
+         for (; e > 0; e--) {
+            if (__builtin_mul_overflow(lex->lval->i64, INT64_C(10),
+                                       &lex->lval->i64))
+               overflow = true;
+         }
+         tok = (sign == NULL) ? tINT : tERROR;
+      }
+
+      if (overflow)
+         error_at(lex->lloc, "value %s is outside implementation defined "
+                  "range of universal_integer", str);
+   }
+   else {
+      lex->lval->real = strtod(tmp, NULL);
+      tok = tREAL;
+   }
+
+   return (lex->last_token = tok);
+}
+
+static token_t parse_based_literal(lexer_t *lex, const char *str)
+{
+   // Transform a string into a literal as specified in LRM 13.4.2
+   //   based_literal ::= base [#:] based_integer [.based_integer] [#:]
+   //     [exponent]
+
+   int tok = tERROR;
+   char *tmp LOCAL = xstrdup(str);
+   strip_underscores(tmp);
+
+   char *dot  = strpbrk(tmp, ".");
+   char *sign = strpbrk(tmp, "-");
+   char *base = strtok(tmp, "#:");
+   char *val  = strtok(NULL, "#:");
+   char *exp  = strtok(NULL, "eE");
+
+   // Base must be at least 2 and at most 16
+   if ((2 <= atoi(base)) && (atoi(base) <= 16)) {
+      if (dot == NULL) {
+         char *eptr;
+         lex->lval->i64 = strtoll(val, &eptr, atoi(base));
+
+         long long int e = (exp ? atoll(exp) : 0);
+
+         if (e >= 0) {  // Minus sign forbidden for an integer literal
+            for (; e > 0; e--) lex->lval->i64 *= atoi(base);
+            tok = ((*eptr == '\0') && (sign == NULL)) ? tINT : tERROR;
+         }
+      }
+      else {
+         char *eptr_integer, *eptr_rational;
+         char *integer  = strtok(val, ".");
+         char *rational = strtok(NULL, ".");
+
+         lex->lval->real = (double)strtoll(integer, &eptr_integer, atoi(base));
+
+         double tmp = (double)strtoll(rational, &eptr_rational, atoi(base));
+         tmp *= pow((double)atoi(base), (double)((long)(0 - strlen(rational))));
+
+         lex->lval->real += tmp;
+
+         long long int e = (exp ? atoll(exp) : 0);
+
+         if (e != 0)
+            lex->lval->real *= pow((double) atoi(base), (double) e);
+
+         if (*eptr_integer == '\0' && *eptr_rational == '\0')
+            tok = tREAL;
+         else
+            tok = tERROR;
+      }
+   }
+
+   return (lex->last_token = tok);
+}
+
+static size_t match_integer(const char *p, const char *end)
+{
+   //   integer ::= [0-9][0-9_]*
+   if (p == end || !is_class(*p, CC_DIGIT))
+      return 0;
+
+   const char *start = p++;
+   while (p < end && (is_class(*p, CC_DIGIT) || *p == '_'))
+      p++;
+
+   return p - start;
+}
+
+static size_t match_hex(const char *p, const char *end)
+{
+   if (p == end || !is_class(*p, CC_HEX))
+      return 0;
+
+   const char *start = p++;
+   while (p < end && (is_class(*p, CC_HEX) || *p == '_'))
+      p++;
+
+   return p - start;
+}
+
+static size_t match_exponent(const char *p, const char *end)
+{
+   //   exponent ::= [Ee][+-]?integer
+   if (p == end || (*p != 'e' && *p != 'E'))
+      return 0;
+
+   size_t len = 1;
+   if (p + len < end && (p[len] == '+' || p[len] == '-'))
+      len++;
+
+   const size_t ilen = match_integer(p + len, end);
+   return ilen > 0 ? len + ilen : 0;
+}
+
+static size_t match_decimal(const char *p, const char *end)
+{
+   size_t len = match_integer(p, end);
+   assert(len > 0);
+
+   if (p + len < end && p[len] == '.') {
+      const size_t frac = match_integer(p + len + 1, end);
+      if (frac > 0)
+         len += 1 + frac;
+   }
+
+   return len + match_exponent(p + len, end);
+}
+
+static size_t match_based(const char *p, const char *end)
+{
+   size_t len = match_integer(p, end);
+   assert(len > 0);
+
+   if (p + len == end || (p[len] != '#' && p[len] != ':'))
+      return 0;
+
+   const char delim = p[len++];
+
+   const size_t hlen = match_hex(p + len, end);
+   if (hlen == 0)
+      return 0;
+
+   len += hlen;
+
+   if (p + len < end && p[len] == '.') {
+      const size_t frac = match_hex(p + len + 1, end);
+      if (frac == 0)
+         return 0;
+
+      len += 1 + frac;
+   }
+
+   if (p + len == end || p[len] != delim)
+      return 0;
+
+   len++;
+
+   return len + match_exponent(p + len, end);
+}
+
+static size_t match_delimited(const char *p, const char *end, char delim,
+                              char forbid, bool allow_empty)
+{
+   // Match text between a pair of delimiters where a doubled delimiter
+   // represents a single character.  Literals cannot span lines.
+
+   assert(*p == delim);
+
+   const char *q = p + 1;
+   for (; q < end; q++) {
+      if (*q == '\n' || (forbid && *q == forbid))
+         return 0;
+      else if (*q == delim) {
+         if (q + 1 < end && q[1] == delim)
+            q++;
+         else
+            break;
+      }
+   }
+
+   if (q == end || (!allow_empty && q == p + 1))
+      return 0;
+
+   return q - p + 1;
+}
+
+static size_t match_bit_string(const char *p, const char *end)
+{
+   //   bit_string ::= [0-9]*[usUS]?[boxdBOXD]"[^"]+"
+   //                | [boxdBOXD]%[^%]+%
+
+   const char *q = p;
+   while (q < end && is_class(*q, CC_DIGIT))
+      q++;
+
+   const bool plain = (q == p);
+
+   if (q < end && strchr("usUS", *q) && *q != '\0')
+      q++;
+
+   if (q == end || *q == '\0' || !strchr("boxdBOXD", *q))
+      return 0;
+
+   const bool short_form = plain && (q == p);
+
+   if (++q == end)
+      return 0;
+   else if (*q == '"' || (*q == '%' && short_form)) {
+      const char delim = *q;
+      const char *r = q + 1;
+      while (r < end && *r != delim && *r != '\n')
+         r++;
+
+      if (r == end || *r != delim || r == q + 1)
+         return 0;
+
+      return r - p + 1;
+   }
+   else
+      return 0;
+}
+
+static token_t lex_bit_string(lexer_t *lex, const char *tok, size_t len)
+{
+   // Copy input, remove all '_' characters and replace all '\%'
+   // characters by '\"'.
+
+   char *p = (lex->lval->str = copy_text(tok, len));
+
+   strip_underscores(p);
+
+   for (; *p; p++) {
+      if (*p == '%')
+         *p = '\"';
+   }
+
+   return lex_token(lex, tok, len, tBITSTRING);
+}
+
+static token_t lex_string(lexer_t *lex, const char *tok, size_t len)
+{
+   // Replaces all double '\"' by single '\"' or all double '%' by
+   // single '%'.  In the case when '\%' is used as string brackets, the
+   // enclosed senquence of characters should not contain quotation
+   // marks!
+
+   char *s = (lex->lval->str = xmalloc(len + 1));
+   const char delim = *tok;
+
+   *s++ = delim;
+   for (size_t i = 1; i < len; i++) {
+      if (tok[i] == delim && i + 1 < len && tok[i + 1] == delim)
+         i++;
+      *s++ = tok[i];
+   }
+   *s = '\0';
+
+   return lex_token(lex, tok, len, tSTRING);
+}
+
+static token_t lex_ex_id(lexer_t *lex, const char *tok, size_t len)
+{
+   char *p = (lex->lval->str = xmalloc(len + 1));
+
+   // Replacing double '\\' character by single '\\'
+   *p++ = tok[0];
+   for (size_t i = 1; i < len; i++) {
+      if (tok[i] == '\\' && i + 1 < len && tok[i + 1] == '\\')
+         i++;
+      *p++ = tok[i];
+   }
+   *p = '\0';
+
+   return lex_token(lex, tok, len, tID);
+}
+
+static token_t lex_number(lexer_t *lex, const char *tok)
+{
+   const size_t dlen = match_decimal(tok, lex->end);
+   const size_t blen = match_based(tok, lex->end);
+   const size_t slen = match_bit_string(tok, lex->end);
+
+   if (slen > dlen && slen > blen)
+      return lex_bit_string(lex, tok, slen);
+
+   const size_t len = MAX(dlen, blen);
+   char *text LOCAL = copy_text(tok, len);
+
+   lex_set_loc(lex, tok, len);
+   lex->ptr = tok + len;
+
+   if (blen > dlen)
+      return parse_based_literal(lex, text);
+   else
+      return parse_decimal_literal(lex, text);
+}
+
+static token_t lex_vhdl_id(lexer_t *lex, const char *tok)
+{
+   const char *end = skip_ident(tok + 1, lex->end, CC_VHDL_ID);
+   const size_t len = end - tok;
+
+   char *upper, small[KEYWORD_MAX_LEN + 1];
+   if (len <= KEYWORD_MAX_LEN)
+      upper = small;
+   else
+      upper = xmalloc(len + 1);
+
+   for (size_t i = 0; i < len; i++)
+      upper[i] = toupper_iso88591(tok[i]);
+   upper[len] = '\0';
+
+   const keyword_t *kw = NULL;
+   if (len <= KEYWORD_MAX_LEN)
+      kw = lookup_keyword(upper, len);
+
+   if (kw != NULL && lex->mode == LEX_PSL) {
+      if (kw->psl_bang != 0 && end < lex->end && *end == '!')
+         return lex_token(lex, tok, len + 1, kw->psl_bang);
+      else if (kw->psl != 0)
+         return lex_token(lex, tok, len, kw->psl);
+   }
+   else if (kw != NULL && kw->vhdl != 0) {
+      if (standard() >= kw->lrm)
+         return lex_token(lex, tok, len, kw->vhdl);
+
+      lex_set_loc(lex, tok, len);
+
+      if (!lex->warned_kw[kw - keywords]) {
+         warn_lrm(lex, kw->lrm, "`%.*s' is a reserved word in VHDL-%s",
+                  (int)len, tok, standard_text(kw->lrm));
+         lex->warned_kw[kw - keywords] = true;
+      }
+   }
+
+   if (upper == small)
+      upper = xstrdup(small);
+
+   lex->lval->str = upper;
+   return lex_token(lex, tok, len, tID);
+}
+
+static bool lex_psl_continuation(lexer_t *lex)
+{
+   // Leading whitespace and comment characters are ignored at the
+   // start of each line of a multi-line PSL directive
+
+   const char *p = skip_spaces(lex->ptr, lex->end);
+   if (p + 1 >= lex->end || p[0] != '-' || p[1] != '-')
+      return false;
+
+   const char *q = skip_spaces(p + 2, lex->end);
+   if (match_nocase(q, lex->end, "PSL")
+       && q + 3 < lex->end && (q[3] == ' ' || q[3] == '\t'))
+      q = skip_spaces(q + 3, lex->end);
+   else if (p == lex->ptr)
+      return false;   // Handled as a regular comment
+   else
+      q = p + 2;
+
+   lex_skipped(lex, lex->ptr, q - lex->ptr);
+   lex->ptr = q;
+   return true;
+}
+
+static token_t lex_dash_dash(lexer_t *lex, const char *tok)
+{
+   // Check for special comments which are treated as tokens
+
+   static const struct {
+      const char *first;
+      const char *second;
+      token_t     token;
+   } pragmas[] = {
+      { "SYNTHESIS", "TRANSLATE_OFF", tSYNTHOFF },
+      { "SYNTHESIS", "TRANSLATE_ON", tSYNTHON },
+      { "COVERAGE", "OFF", tCOVERAGEOFF },
+      { "COVERAGE", "ON", tCOVERAGEON },
+   };
+
+   const char *start = skip_spaces(tok + 2, lex->end);
+
+   for (int i = 0; i < ARRAY_LEN(pragmas); i++) {
+      const char *p = start;
+      if (!match_nocase(p, lex->end, pragmas[i].first))
+         continue;
+
+      p += strlen(pragmas[i].first);
+      if (p == lex->end || (*p != ' ' && *p != '\t'))
+         continue;
+
+      p = skip_spaces(p, lex->end);
+      if (!match_nocase(p, lex->end, pragmas[i].second))
+         continue;
+
+      const char *nl = memchr(p, '\n', lex->end - p);
+      return lex_token(lex, tok, (nl ?: lex->end) - tok, pragmas[i].token);
+   }
+
+   if (match_nocase(start, lex->end, "PSL") && start + 3 < lex->end
+       && (start[3] == ' ' || start[3] == '\t')) {
+      const char *p = skip_spaces(start + 3, lex->end);
+
+      lex_set_loc(lex, tok, p - tok);
+
+      if (begin_psl_comment(lex)) {
+         lex->mode = LEX_PSL;
+         return lex_token(lex, tok, p - tok, tSTARTPSL);
+      }
+
+      lex_skip_line(lex, tok, p);
+      return -1;
+   }
+
+   lex_skip_line(lex, tok, tok + 2);
+   return -1;
+}
+
+static token_t lex_vhdl(lexer_t *lex, const char *tok)
+{
+   const bool psl = (lex->mode == LEX_PSL);
+   const char *end = lex->end;
+   const char next = tok + 1 < end ? tok[1] : '\0';
+   const char next2 = tok + 2 < end ? tok[2] : '\0';
+
+   switch (*tok) {
+   case '-':
+      if (next == '-') {
+         if (psl) {
+            lex_skip_line(lex, tok, tok + 2);
+            return -1;
+         }
+         else
+            return lex_dash_dash(lex, tok);
+      }
+      else if (next == '>')
+         return lex_token(lex, tok, 2, tIFIMPL);
+      else
+         return lex_token(lex, tok, 1, tMINUS);
+
+   case '/':
+      if (next == '*' && !psl) {
+         if (!lex->warned_comment && standard() < STD_08) {
+            lex_set_loc(lex, tok, 2);
+            warn_lrm(lex, STD_08, "%s are a VHDL-%s feature",
+                     "delimited comments", standard_text(STD_08));
+            lex->warned_comment = true;
+         }
+
+         lex_skipped(lex, tok, 2);
+         lex_skip_block_comment(lex, tok + 2);
+         return -1;
+      }
+      else if (next == '=')
+         return lex_token(lex, tok, 2, tNEQ);
+      else
+         return lex_token(lex, tok, 1, tOVER);
+
+   case '<':
+      if (next == '-' && next2 == '>')
+         return lex_token(lex, tok, 3, tIFFIMPL);
+      else if (next == '=')
+         return lex_token(lex, tok, 2, tLE);
+      else if (next == '>')
+         return lex_token(lex, tok, 2, tBOX);
+      else if (next == '<')
+         return lex_token(lex, tok, 2, tLTLT);
+      else
+         return lex_token(lex, tok, 1, tLT);
+
+   case '>':
+      if (next == '=')
+         return lex_token(lex, tok, 2, tGE);
+      else if (next == '>')
+         return lex_token(lex, tok, 2, tGTGT);
+      else
+         return lex_token(lex, tok, 1, tGT);
+
+   case '=':
+      if (next == '>')
+         return lex_token(lex, tok, 2, tASSOC);
+      else
+         return lex_token(lex, tok, 1, tEQ);
+
+   case '*':
+      if (next == '*')
+         return lex_token(lex, tok, 2, tPOWER);
+      else
+         return lex_token(lex, tok, 1, tTIMES);
+
+   case ':':
+      if (next == '=')
+         return lex_token(lex, tok, 2, tASSIGN);
+      else
+         return lex_token(lex, tok, 1, tCOLON);
+
+   case '?':
+      if (next == '?')
+         return lex_token_08(lex, tok, 2, tCCONV);
+      else if (next == '<' && next2 == '=')
+         return lex_token_08(lex, tok, 3, tMLE);
+      else if (next == '<')
+         return lex_token_08(lex, tok, 2, tMLT);
+      else if (next == '>' && next2 == '=')
+         return lex_token_08(lex, tok, 3, tMGE);
+      else if (next == '>')
+         return lex_token_08(lex, tok, 2, tMGT);
+      else if (next == '/' && next2 == '=')
+         return lex_token_08(lex, tok, 3, tMNEQ);
+      else if (next == '=')
+         return lex_token_08(lex, tok, 2, tMEQ);
+      else
+         return lex_token(lex, tok, 1, tQUESTION);
+
+   case '[':
+      if (next == '-' && next2 == '>')
+         return lex_token(lex, tok, 3, tARROWRPT);
+      else if (next == '+' && next2 == ']')
+         return lex_token(lex, tok, 3, tPLUSRPT);
+      else if (next == '*')
+         return lex_token(lex, tok, 2, tTIMESRPT);
+      else if (next == '=')
+         return lex_token(lex, tok, 2, tGOTORPT);
+      else
+         return lex_token(lex, tok, 1, tLSQUARE);
+
+   case '&':
+      if (psl && next == '&')
+         return lex_token(lex, tok, 2, tDBLAMP);
+      else
+         return lex_token(lex, tok, 1, tAMP);
+
+   case '^':
+      return lex_token(lex, tok, 1, tCARET);
+
+   case '\'':
+      if (tok + 2 < end && next != '\n' && next2 == '\''
+          && resolve_ir1045(lex)) {
+         lex->lval->str = copy_text(tok, 3);
+         return lex_token(lex, tok, 3, tID);
+      }
+      else
+         return lex_token(lex, tok, 1, tTICK);
+
+   case '"':
+   case '%':
+      {
+         const size_t len = match_delimited(tok, end, *tok,
+                                            *tok == '%' ? '"' : '\0', true);
+         if (len > 0)
+            return lex_string(lex, tok, len);
+         else
+            return lex_token(lex, tok, 1, tERROR);
+      }
+
+   case '\\':
+      if (!psl) {
+         const size_t len = match_delimited(tok, end, '\\', '\0', true);
+         if (len > 0)
+            return lex_ex_id(lex, tok, len);
+      }
+      return lex_token(lex, tok, 1, tERROR);
+
+   case '`':
+      if (!psl) {
+         for (int i = 0; i < ARRAY_LEN(directives); i++) {
+            if (match_nocase(tok + 1, end, directives[i].name))
+               return lex_token(lex, tok, strlen(directives[i].name) + 1,
+                                directives[i].token);
+         }
+      }
+      return lex_token(lex, tok, 1, tERROR);
+
+   case '0' ... '9':
+      return lex_number(lex, tok);
+
+   default:
+      if (is_class(*tok, CC_VHDL_START)) {
+         if (strchr("usUSboxdBOXD", *tok)) {
+            const size_t len = match_bit_string(tok, end);
+            if (len > 0)
+               return lex_bit_string(lex, tok, len);
+         }
+
+         if ((uint8_t)*tok >= 0x80)
+            goto utf8;
+
+         return lex_vhdl_id(lex, tok);
+      }
+      else if ((uint8_t)*tok >= 0x80)
+         goto utf8;
+      else
+         return -2;
+   }
+
+ utf8:
+   {
+      // Possible multi-byte UTF-8 character
+      size_t ulen = 1;
+      while (ulen < 4 && tok + ulen < end
+             && (uint8_t)tok[ulen] >= 0x80 && (uint8_t)tok[ulen] <= 0xbf)
+         ulen++;
+
+      const bool letter = is_class(*tok, CC_VHDL_START);
+      const size_t idlen =
+         letter ? skip_ident(tok + 1, end, CC_VHDL_ID) - tok : 1;
+
+      if (ulen > 1 && ulen >= idlen) {
+         lex_set_loc(lex, tok, ulen);
+         warn_utf8(lex);
+      }
+
+      if (letter)
+         return lex_vhdl_id(lex, tok);
+      else
+         return lex_token(lex, tok, 1, tERROR);
+   }
+}
+
+static token_t lex_verilog(lexer_t *lex, const char *tok)
+{
+   const char *end = lex->end;
+   const char next = tok + 1 < end ? tok[1] : '\0';
+
+   switch (*tok) {
+   case '/':
+      if (next == '/') {
+         lex_skip_line(lex, tok, tok + 2);
+         return -1;
+      }
+      else if (next == '*') {
+         lex_skipped(lex, tok, 2);
+         lex_skip_block_comment(lex, tok + 2);
+         return -1;
+      }
+      else
+         return lex_token(lex, tok, 1, tOVER);
+
+   case '<':
+      if (next == '=')
+         return lex_token(lex, tok, 2, tLE);
+      else
+         return lex_token(lex, tok, 1, tLT);
+
+   case '>':
+      if (next == '=')
+         return lex_token(lex, tok, 2, tGE);
+      else
+         return lex_token(lex, tok, 1, tGT);
+
+   case '-': return lex_token(lex, tok, 1, tMINUS);
+   case '*': return lex_token(lex, tok, 1, tTIMES);
+   case ':': return lex_token(lex, tok, 1, tCOLON);
+   case '?': return lex_token(lex, tok, 1, tQUESTION);
+   case '=': return lex_token(lex, tok, 1, tEQ);
+   case '&': return lex_token(lex, tok, 1, tAMP);
+   case '[': return lex_token(lex, tok, 1, tLSQUARE);
+
+   case '"':
+      {
+         const char *p = tok + 1;
+         while (p < end && *p != '"' && *p != '\n')
+            p++;
+
+         if (p == end || *p != '"')
+            return lex_token(lex, tok, 1, tERROR);
+
+         const size_t len = p - tok + 1;
+         lex_set_loc(lex, tok, len);
+
+         char *s = (lex->lval->str = xmalloc(len + 1));
+         for (const char *q = tok; q < tok + len; q++) {
+            if (*q == '\\') {
+               switch (*++q) {
+               case 'n': *s++ = '\n'; break;
+               case 'r': *s++ = '\r'; break;
+               case 't': *s++ = '\t'; break;
+               case 'b': *s++ = '\b'; break;
+               default:
+                  warn_at(lex->lloc, "unrecognised escaped character '%c'",
+                          *q);
+                  *s++ = *q;
+               }
+            }
+            else
+               *s++ = *q;
+         }
+         *s = '\0';
+
+         return lex_token(lex, tok, len, tSTRING);
+      }
+
+   case '$':
+      if (tok + 1 < end && (is_class(next, CC_VLOG_START) || next == '$')) {
+         const char *p = skip_ident(tok + 2, end, CC_VLOG_ID);
+         lex->lval->str = copy_text(tok, p - tok);
+         return lex_token(lex, tok, p - tok, tSYSTASK);
+      }
+      else
+         return lex_token(lex, tok, 1, tERROR);
+
+   case '0' ... '9':
+      {
+         const size_t len = match_integer(tok, end);
+         lex->lval->str = copy_text(tok, len);
+         return lex_token(lex, tok, len, tUNSIGNED);
+      }
+
+   default:
+      if (is_class(*tok, CC_VLOG_START)) {
+         const char *p = skip_ident(tok + 1, end, CC_VLOG_ID);
+         const size_t len = p - tok;
+
+         for (int i = 0; i < ARRAY_LEN(vlog_keywords); i++) {
+            const char *kw = vlog_keywords[i].name;
+            if (strncmp(kw, tok, len) == 0 && kw[len] == '\0')
+               return lex_token(lex, tok, len, vlog_keywords[i].token);
+         }
+
+         lex->lval->str = copy_text(tok, len);
+         return lex_token(lex, tok, len, tID);
+      }
+      else
+         return -2;
+   }
+}
+
+lexer_t *lexer_new(const char *text, size_t len, loc_file_ref_t file_ref)
+{
+   init_tables();
+
+   lexer_t *lex = xcalloc(sizeof(lexer_t));
+   lex->start      = text;
+   lex->end        = text + len;
+   lex->ptr        = text;
+   lex->line_start = text;
+   lex->lineno     = 1;
+   lex->mode       = LEX_VHDL;
+   lex->last_token = -1;
+   lex->file_ref   = file_ref;
+   lex->skip_line  = LINE_INVALID;
+   lex->warned_kw  = xcalloc_array(ARRAY_LEN(keywords), sizeof(bool));
+
+   return lex;
+}
+
+void lexer_free(lexer_t *lex)
+{
+   free(lex->warned_kw);
+   free(lex);
+}
+
+void lexer_set_mode(lexer_t *lex, lex_mode_t mode)
+{
+   lex->mode = mode;
+}
+
+token_t lexer_next(lexer_t *lex, yylval_t *lval, loc_t *lloc)
+{
+   lex->lval = lval;
+   lex->lloc = lloc;
+
+   for (;;) {
+      const char *tok = lex->ptr;
+
+      if (tok == lex->end) {
+         if (lex->skip_line != LINE_INVALID)
+            *lloc = get_loc(lex->skip_line, lex->skip_col, lex->skip_line,
+                            lex->skip_col + lex->skip_len - 1, lex->file_ref);
+         return tEOF;
+      }
+
+      if (lex->mode == LEX_PSL && tok == lex->line_start
+          && lex_psl_continuation(lex))
+         continue;
+
+      switch (*tok) {
+      case '\n':
+         lex_newline(lex, tok);
+         continue;
+
+      case ' ':
+      case '\t':
+      case '\r':
+         {
+            const char *p = skip_spaces(tok + 1, lex->end);
+            lex_skipped(lex, tok, p - tok);
+            lex->ptr = p;
+         }
+         continue;
+
+      case '(': return lex_token(lex, tok, 1, tLPAREN);
+      case ')': return lex_token(lex, tok, 1, tRPAREN);
+      case ']': return lex_token(lex, tok, 1, tRSQUARE);
+      case '{': return lex_token(lex, tok, 1, tLBRACE);
+      case '}': return lex_token(lex, tok, 1, tRBRACE);
+      case ',': return lex_token(lex, tok, 1, tCOMMA);
+      case ';': return lex_token(lex, tok, 1, tSEMI);
+      case '+': return lex_token(lex, tok, 1, tPLUS);
+      case '@': return lex_token(lex, tok, 1, tAT);
+      case '.': return lex_token(lex, tok, 1, tDOT);
+      case '|': return lex_token(lex, tok, 1, tBAR);
+      case '!': return lex_token(lex, tok, 1, tBAR);
+      }
+
+      token_t token;
+      if (lex->mode == LEX_VERILOG)
+         token = lex_verilog(lex, tok);
+      else
+         token = lex_vhdl(lex, tok);
+
+      if (token == -2) {
+         // Any other character is invalid
+         lex_set_loc(lex, tok, 1);
+         lex->ptr = tok + 1;
+         return (lex->last_token = tERROR);
+      }
+      else if (token != -1)
+         return token;
+   }
+}
@@ -16,6 +16,7 @@
 //
 
 #include "util.h"
+#include "array.h"
 #include "common.h"
 #include "diag.h"
 #include "hash.h"
@@ -45,7 +46,23 @@ typedef struct _lib_index   lib_index_t;
 typedef struct _lib_list    lib_list_t;
 typedef struct _lib_unit    lib_unit_t;
 
-#define INDEX_FILE_MAGIC 0x55225511
+#define INDEX_FILE_MAGIC 0x55225513
+
+typedef struct {
+   ident_t  name;
+   uint32_t checksum;
+} lib_dep_t;
+
+typedef A(lib_dep_t) dep_array_t;
+
+typedef struct {
+   ident_t  source;
+   uint32_t hash;
+   bool     warnings;
+   A(ident_t) units;
+} lib_file_t;
+
+typedef A(lib_file_t) file_array_t;
 
 struct _lib_unit {
    object_t     *object;
@@ -62,6 +79,10 @@ struct _lib_unit {
 struct _lib_index {
    ident_t      name;
    tree_kind_t  kind;
+   ident_t      source;
+   uint32_t     source_hash;
+   uint32_t     checksum;
+   dep_array_t  deps;
    lib_index_t *next;
 };
 
@@ -71,6 +92,8 @@ struct _lib {
    hash_t       *lookup;
    lib_unit_t   *units;
    lib_index_t  *index;
+   file_array_t  files;
+   file_array_t  analysed;
    lib_mtime_t   index_mtime;
    off_t         index_size;
    int           lock_fd;
@@ -143,7 +166,7 @@ static void lib_add_to_index(lib_t lib, ident_t name, tree_kind_t kind)
       (*it)->kind = kind;
    }
    else {
-      lib_index_t *new = xmalloc(sizeof(lib_index_t));
+      lib_index_t *new = xcalloc(sizeof(lib_index_t));
       new->name = name;
       new->kind = kind;
       new->next = *it;
@@ -152,6 +175,42 @@ static void lib_add_to_index(lib_t lib, ident_t name, tree_kind_t kind)
    }
 }
 
+static void lib_clear_files(file_array_t *files)
+{
+   for (int i = 0; i < files->count; i++)
+      ACLEAR(files->items[i].units);
+   ACLEAR(*files);
+}
+
+static lib_file_t *lib_find_file(file_array_t *files, ident_t source)
+{
+   for (int i = 0; i < files->count; i++) {
+      if (files->items[i].source == source)
+         return &(files->items[i]);
+   }
+
+   return NULL;
+}
+
+static void lib_read_index_entry(lib_index_t *entry, fbuf_t *f,
+                                 ident_rd_ctx_t ictx)
+{
+   entry->source      = ident_read(ictx);
+   entry->source_hash = read_u32(f);
+   entry->checksum    = read_u32(f);
+
+   ACLEAR(entry->deps);
+
+   const int ndeps = read_u32(f);
+   for (int i = 0; i < ndeps; i++) {
+      lib_dep_t dep = {
+         .name = ident_read(ictx),
+         .checksum = read_u32(f),
+      };
+      APUSH(entry->deps, dep);
+   }
+}
+
 static void lib_read_index(lib_t lib)
 {
    fbuf_t *f = lib_fbuf_open(lib, "_index", FBUF_IN, FBUF_CS_NONE);
@@ -184,24 +243,63 @@ static void lib_read_index(lib_t lib)
 
          if (*insert && (*insert)->name == name) {
             (*insert)->kind = kind;
+            lib_read_index_entry(*insert, f, ictx);
             insert = &((*insert)->next);
          }
          else {
-            lib_index_t *new = xmalloc(sizeof(lib_index_t));
+            lib_index_t *new = xcalloc(sizeof(lib_index_t));
             new->name = name;
             new->kind = kind;
             new->next = *insert;
+            lib_read_index_entry(new, f, ictx);
 
             *insert = new;
             insert = &(new->next);
          }
       }
 
+      lib_clear_files(&(lib->files));
+
+      const int nfiles = read_u32(f);
+      for (int i = 0; i < nfiles; i++) {
+         lib_file_t file = {
+            .source   = ident_read(ictx),
+            .hash     = read_u32(f),
+            .warnings = read_u8(f),
+         };
+
+         const int nunits = read_u32(f);
+         for (int j = 0; j < nunits; j++)
+            APUSH(file.units, ident_read(ictx));
+
+         APUSH(lib->files, file);
+      }
+
       ident_read_end(ictx);
       fbuf_close(f, NULL);
    }
 }
 
+static void lib_open_lock(lib_t lib)
+{
+   LOCAL_TEXT_BUF lock_path = lib_file_path(lib, "_NVC_LIB");
+
+   // Try to open the lock file read-write as this is required for
+   // exlusive locking on some NFS implementations
+   int mode = O_RDWR;
+   if (access(tb_get(lock_path), mode) != 0) {
+      if (errno == EACCES || errno == EPERM || errno == EROFS) {
+         mode = O_RDONLY;
+         lib->readonly = true;
+      }
+      else
+         fatal_errno("access: %s", tb_get(lock_path));
+   }
+
+   if ((lib->lock_fd = open(tb_get(lock_path), mode)) < 0)
+      fatal_errno("open: %s", tb_get(lock_path));
+}
+
 static lib_t lib_init(const char *name, const char *rpath, int lock_fd)
 {
    lib_t l = xcalloc(sizeof(struct _lib));
@@ -229,23 +327,7 @@ static lib_t lib_init(const char *name, const char *rpath, int lock_fd)
       debugf("library %s at %s", istr(l->name), l->path);
 
    if (l->lock_fd == -1 && rpath != NULL) {
-      LOCAL_TEXT_BUF lock_path = lib_file_path(l, "_NVC_LIB");
-
-      // Try to open the lock file read-write as this is required for
-      // exlusive locking on some NFS implementations
-      int mode = O_RDWR;
-      if (access(tb_get(lock_path), mode) != 0) {
-         if (errno == EACCES || errno == EPERM || errno == EROFS) {
-            mode = O_RDONLY;
-            l->readonly = true;
-         }
-         else
-            fatal_errno("access: %s", tb_get(lock_path));
-      }
-
-      if ((l->lock_fd = open(tb_get(lock_path), mode)) < 0)
-         fatal_errno("open: %s", tb_get(lock_path));
-
+      lib_open_lock(l);
       file_read_lock(l->lock_fd);
    }
 
@@ -661,10 +743,14 @@ void lib_free(lib_t lib)
 
    while (lib->index) {
       lib_index_t *tmp = lib->index->next;
+      ACLEAR(lib->index->deps);
       free(lib->index);
       lib->index = tmp;
    }
 
+   lib_clear_files(&(lib->files));
+   lib_clear_files(&(lib->analysed));
+
    for (lib_unit_t *lu = lib->units, *tmp; lu; lu = tmp) {
       tmp = lu->next;
       free(lu);
@@ -821,6 +907,42 @@ static lib_mtime_t lib_stat_mtime(struct stat *st)
    return mt;
 }
 
+static bool lib_source_hash(const char *file, uint32_t *hash)
+{
+   int fd = open(file, O_RDONLY);
+   if (fd < 0)
+      return false;
+
+   struct stat st;
+   if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+      close(fd);
+      return false;
+   }
+
+   uint32_t content;
+   if (st.st_size > 0) {
+      void *map = map_file(fd, st.st_size);
+      content = fbuf_checksum(FBUF_CS_ADLER32, map, st.st_size);
+      unmap_file(map, st.st_size);
+   }
+   else
+      content = fbuf_checksum(FBUF_CS_ADLER32, NULL, 0);
+
+   close(fd);
+
+   // Analysing the same text with different options may give a
+   // different result so include these in the hash too
+   const uint32_t options = standard()
+      | opt_get_int(OPT_RELAXED) << 8
+      | opt_get_int(OPT_PSL_COMMENTS) << 9
+      | opt_get_int(OPT_BOOTSTRAP) << 10
+      | opt_get_int(OPT_MISSING_BODY) << 11
+      | opt_get_int(OPT_WARN_HIDDEN) << 12;
+
+   *hash = content ^ (options << 16);
+   return true;
+}
+
 static lib_unit_t *lib_read_unit(lib_t lib, const char *fname)
 {
    fbuf_t *f = lib_fbuf_open(lib, fname, FBUF_IN, FBUF_CS_ADLER32);
@@ -915,6 +1037,14 @@ static lib_unit_t *lib_get_aux(lib_t lib, ident_t ident)
       if (stat(file, &st) == 0)
          stale = (lu->mtime < lib_stat_mtime(&st));
 
+      // The modification time may have changed without the contents
+      // changing, for example after a version control checkout
+      lib_index_t *entry;
+      uint32_t hash;
+      if (stale && (entry = lib_find_in_index(lib, ident)) != NULL
+          && entry->source != NULL && lib_source_hash(file, &hash))
+         stale = (hash != entry->source_hash);
+
       if (stale) {
          diag_t *d = diag_new(DIAG_WARN, NULL);
          diag_printf(d, "design unit %s is older than its source file "
@@ -1076,6 +1206,71 @@ static void lib_save_unit(lib_t lib, lib_unit_t *unit)
    unit->dirty = false;
 }
 
+static void lib_index_dep_cb(ident_t name, uint32_t checksum, void *ctx)
+{
+   dep_array_t *deps = ctx;
+   APUSH(*deps, ((lib_dep_t){ name, checksum }));
+}
+
+static void lib_index_saved_units(lib_t lib, lib_unit_t **units, int count)
+{
+   ident_t last_source = NULL;
+   uint32_t last_hash = 0;
+
+   for (int i = 0; i < count; i++) {
+      lib_index_t *entry = lib_find_in_index(lib, units[i]->name);
+      assert(entry != NULL);
+
+      object_arena_t *arena = object_arena(units[i]->object);
+      entry->checksum = arena_checksum(arena);
+
+      ACLEAR(entry->deps);
+      object_arena_walk_checksums(arena, lib_index_dep_cb, &(entry->deps));
+
+      // Elaborated units are not analysed from a source file
+      const char *file = NULL;
+      if (units[i]->kind != T_ELAB)
+         file = loc_file_str(&(units[i]->object->loc));
+
+      // Units from the same file are usually saved consecutively
+      ident_t source = file ? ident_new(file) : NULL;
+      if (source != NULL && source != last_source) {
+         if (!lib_source_hash(file, &last_hash))
+            source = NULL;
+      }
+
+      entry->source      = source;
+      entry->source_hash = source ? last_hash : 0;
+
+      last_source = source;
+   }
+
+   // Replace the record of each file analysed since the last save with
+   // the full list of units it produced so that a unit later replaced
+   // by one from another file makes this file stale
+   for (int i = 0; i < lib->analysed.count; i++) {
+      lib_file_t *a = &(lib->analysed.items[i]);
+
+      for (int j = 0; j < count; j++) {
+         lib_index_t *entry = lib_find_in_index(lib, units[j]->name);
+         if (entry->source == a->source) {
+            a->hash = entry->source_hash;
+            APUSH(a->units, units[j]->name);
+         }
+      }
+
+      lib_file_t *old = lib_find_file(&(lib->files), a->source);
+      if (old != NULL) {
+         ACLEAR(old->units);
+         *old = *a;
+      }
+      else
+         APUSH(lib->files, *a);
+   }
+
+   ACLEAR(lib->analysed);
+}
+
 void lib_save(lib_t lib)
 {
    assert(lib != NULL);
@@ -1086,13 +1281,17 @@ void lib_save(lib_t lib)
 
    freeze_global_arena();
 
+   A(lib_unit_t *) saved = AINIT;
+
    for (lib_unit_t *lu = lib->units; lu; lu = lu->next) {
       if (lu->dirty) {
          if (lu->error)
             fatal_trace("attempting to save unit %s with errors",
                         istr(lu->name));
-         else
+         else {
             lib_save_unit(lib, lu);
+            APUSH(saved, lu);
+         }
       }
    }
 
@@ -1106,6 +1305,9 @@ void lib_save(lib_t lib)
       lib_read_index(lib);
    }
 
+   lib_index_saved_units(lib, saved.items, saved.count);
+   ACLEAR(saved);
+
    int index_sz = lib_index_size(lib);
 
    fbuf_t *f = lib_fbuf_open(lib, "_index", FBUF_OUT, FBUF_CS_NONE);
@@ -1120,6 +1322,25 @@ void lib_save(lib_t lib)
    for (lib_index_t *it = lib->index; it != NULL; it = it->next) {
       ident_write(it->name, ictx);
       write_u16(it->kind, f);
+      ident_write(it->source, ictx);
+      write_u32(it->source_hash, f);
+      write_u32(it->checksum, f);
+      write_u32(it->deps.count, f);
+      for (int i = 0; i < it->deps.count; i++) {
+         ident_write(it->deps.items[i].name, ictx);
+         write_u32(it->deps.items[i].checksum, f);
+      }
+   }
+
+   write_u32(lib->files.count, f);
+   for (int i = 0; i < lib->files.count; i++) {
+      const lib_file_t *file = &(lib->files.items[i]);
+      ident_write(file->source, ictx);
+      write_u32(file->hash, f);
+      write_u8(file->warnings, f);
+      write_u32(file->units.count, f);
+      for (int j = 0; j < file->units.count; j++)
+         ident_write(file->units.items[j], ictx);
    }
 
    ident_write_end(ictx);
@@ -1134,6 +1355,102 @@ void lib_save(lib_t lib)
    file_unlock(lib->lock_fd);
 }
 
+void lib_refresh(lib_t lib)
+{
+   assert(lib != NULL);
+   assert(lib->path != NULL);
+
+   // Locks taken with flock(2) belong to the open file description
+   // which is shared with the parent after fork so open a new one
+   if (lib->lock_fd != -1)
+      close(lib->lock_fd);
+   lib_open_lock(lib);
+
+   file_read_lock(lib->lock_fd);
+   lib_read_index(lib);
+   file_unlock(lib->lock_fd);
+
+   // Units may have been rewritten by another process since they were
+   // loaded so drop them all and ensure the old arenas are never used
+   // to resolve dependencies of units subsequently read from disk
+   for (lib_unit_t *lu = lib->units, *tmp; lu; lu = tmp) {
+      tmp = lu->next;
+
+      assert(!lu->dirty);
+      arena_set_obsolete(object_arena(lu->object), true);
+
+      if (lu->vcode != NULL)
+         vcode_unit_unref(lu->vcode);
+
+      free(lu);
+   }
+
+   lib->units = NULL;
+
+   hash_free(lib->lookup);
+   lib->lookup = hash_new(128);
+}
+
+static bool lib_dep_current(const lib_dep_t *dep)
+{
+   lib_t lib = lib_find(ident_until(dep->name, '.'));
+   if (lib == NULL)
+      return false;
+
+   lib_unit_t *lu = hash_get(lib->lookup, dep->name);
+   if (lu != NULL && lu->dirty)
+      return false;   // Reanalysed but not yet saved
+
+   lib_index_t *entry = lib_find_in_index(lib, dep->name);
+   return entry != NULL && entry->checksum == dep->checksum;
+}
+
+void lib_analysed_file(lib_t lib, const char *file, bool warnings)
+{
+   ident_t source = ident_new(file);
+
+   lib_file_t *a = lib_find_file(&(lib->analysed), source);
+   if (a == NULL) {
+      APUSH(lib->analysed, ((lib_file_t){ .source = source }));
+      a = &(lib->analysed.items[lib->analysed.count - 1]);
+   }
+
+   a->warnings = warnings;
+}
+
+bool lib_up_to_date(lib_t lib, const char *file)
+{
+   // True if FILE was last analysed from the same text without
+   // warnings, every unit it produced is still the one from FILE, and
+   // the units they depend on have not changed since
+   ident_t source = ident_new(file);
+
+   const lib_file_t *rec = lib_find_file(&(lib->files), source);
+   if (rec == NULL || rec->warnings || rec->units.count == 0)
+      return false;
+
+   uint32_t hash;
+   if (!lib_source_hash(file, &hash) || hash != rec->hash)
+      return false;
+
+   for (int i = 0; i < rec->units.count; i++) {
+      lib_index_t *entry = lib_find_in_index(lib, rec->units.items[i]);
+      if (entry == NULL || entry->source != source)
+         return false;   // Replaced by a unit from another file
+
+      lib_unit_t *lu = hash_get(lib->lookup, entry->name);
+      if (lu != NULL && lu->dirty)
+         return false;
+
+      for (int j = 0; j < entry->deps.count; j++) {
+         if (!lib_dep_current(&(entry->deps.items[j])))
+            return false;
+      }
+   }
+
+   return true;
+}
+
 int lib_index_kind(lib_t lib, ident_t ident)
 {
    lib_index_t *it = lib_find_in_index(lib, ident);
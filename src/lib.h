@@ -41,6 +41,9 @@ void lib_realpath(lib_t lib, const char *name, char *buf, size_t buflen);
 void lib_destroy(lib_t lib);
 ident_t lib_name(lib_t lib);
 void lib_save(lib_t lib);
+void lib_refresh(lib_t lib);
+bool lib_up_to_date(lib_t lib, const char *file);
+void lib_analysed_file(lib_t lib, const char *file, bool warnings);
 void lib_mkdir(lib_t lib, const char *name);
 void lib_add_search_path(const char *path);
 bool lib_stat(lib_t lib, const char *name, lib_mtime_t *mt);
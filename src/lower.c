@@ -5263,11 +5263,12 @@ static void lower_sched_event_field_cb(lower_unit_t *lu, tree_t field,
       if (clear)
          emit_clear_event(nets_reg, count_reg);
       else
-         emit_sched_event(nets_reg, count_reg);
+         emit_sched_event(nets_reg, count_reg, VCODE_INVALID_REG);
    }
 }
 
-static void lower_sched_event(lower_unit_t *lu, tree_t on, vcode_reg_t wake)
+static void lower_sched_event(lower_unit_t *lu, tree_t on, vcode_reg_t wake,
+                              vcode_reg_t mask)
 {
    type_t type = tree_type(on);
 
@@ -5289,7 +5290,7 @@ static void lower_sched_event(lower_unit_t *lu, tree_t on, vcode_reg_t wake)
       if (wake != VCODE_INVALID_REG)
          emit_implicit_event(nets_reg, count_reg, wake);
       else
-         emit_sched_event(nets_reg, count_reg);
+         emit_sched_event(nets_reg, count_reg, mask);
    }
 }
 
@@ -5320,7 +5321,8 @@ static void lower_wait(lower_unit_t *lu, tree_t wait)
    if (!is_static) {
       // The _sched_event for static waits is emitted in the reset block
       for (int i = 0; i < ntriggers; i++)
-         lower_sched_event(lu, tree_trigger(wait, i), VCODE_INVALID_REG);
+         lower_sched_event(lu, tree_trigger(wait, i), VCODE_INVALID_REG,
+                           VCODE_INVALID_REG);
    }
 
    const bool has_delay = tree_has_delay(wait);
@@ -5384,7 +5386,8 @@ static void lower_wait(lower_unit_t *lu, tree_t wait)
       vcode_select_block(again_bb);
 
       for (int i = 0; i < ntriggers; i++)
-         lower_sched_event(lu, tree_trigger(wait, i), VCODE_INVALID_REG);
+         lower_sched_event(lu, tree_trigger(wait, i), VCODE_INVALID_REG,
+                           VCODE_INVALID_REG);
 
       emit_wait(resume, timeout_reg);
 
@@ -7054,8 +7057,10 @@ static void lower_stmt(lower_unit_t *lu, tree_t stmt, loop_stack_t *loops)
    cover_push_scope(lu->cover, stmt);
    if (cover_enabled(lu->cover, COVER_MASK_STMT) && cover_is_stmt(stmt)) {
       cover_tag_t *tag = cover_add_tag(stmt, NULL, lu->cover, TAG_STMT, 0);
-      if (tag != NULL)
-         emit_cover_stmt(tag->tag);
+      if (tag != NULL) {
+         const bool once = cover_enabled(lu->cover, COVER_MASK_STMT_HIT_ONCE);
+         emit_cover_stmt(tag->tag, once ? COV_FLAG_HIT_ONCE : 0);
+      }
    }
 
    emit_debug_info(tree_loc(stmt));
@@ -7597,7 +7602,7 @@ static void lower_build_wait_cb(tree_t expr, void *ctx)
    if (param->wake != VCODE_INVALID_REG)
       emit_implicit_event(data_reg, count_reg, param->wake);
    else
-      emit_sched_event(data_reg, count_reg);
+      emit_sched_event(data_reg, count_reg, VCODE_INVALID_REG);
 }
 
 static void lower_implicit_decl(lower_unit_t *parent, tree_t decl)
@@ -10040,6 +10045,210 @@ static void lower_driver_cb(tree_t t, void *__ctx)
    }
 }
 
+static uint64_t lower_literal_mask(type_t type, const char *name)
+{
+   type_t base = type_base_recur(type);
+   ident_t id = ident_new(name);
+
+   const int nlits = type_enum_literals(base);
+   for (int i = 0; i < nlits; i++) {
+      if (tree_ident(type_enum_literal(base, i)) == id)
+         return UINT64_C(1) << i;
+   }
+
+   return 0;
+}
+
+static bool lower_is_trigger_arg(tree_t fcall, int nth, tree_t trigger)
+{
+   if (nth >= tree_params(fcall))
+      return false;
+
+   tree_t p = tree_param(fcall, nth);
+   if (tree_subkind(p) != P_POS)
+      return false;
+
+   tree_t value = tree_value(p);
+   return tree_kind(value) == T_REF && tree_ref(value) == tree_ref(trigger);
+}
+
+static bool lower_is_side_effect_free(tree_t expr)
+{
+   // Evaluating the expression cannot print a message, fail, or modify
+   // any state so it is safe to skip when the process is not woken
+   switch (tree_kind(expr)) {
+   case T_LITERAL:
+      return true;
+   case T_REF:
+      return tree_has_ref(expr);
+   case T_ATTR_REF:
+      switch (tree_subkind(expr)) {
+      case ATTR_EVENT:
+      case ATTR_ACTIVE:
+         return tree_kind(tree_name(expr)) == T_REF;
+      default:
+         return false;
+      }
+   case T_FCALL:
+      break;
+   default:
+      return false;
+   }
+
+   if (!tree_has_ref(expr))
+      return false;
+
+   tree_t decl = tree_ref(expr);
+   switch (tree_subkind(decl)) {
+   case S_SCALAR_LT:
+   case S_SCALAR_LE:
+   case S_SCALAR_GT:
+   case S_SCALAR_GE:
+   case S_SCALAR_EQ:
+   case S_SCALAR_NEQ:
+   case S_SCALAR_AND:
+   case S_SCALAR_OR:
+   case S_SCALAR_XOR:
+   case S_SCALAR_NAND:
+   case S_SCALAR_NOR:
+   case S_SCALAR_XNOR:
+   case S_SCALAR_NOT:
+   case S_RISING_EDGE:
+   case S_FALLING_EDGE:
+      break;
+   case S_USER:
+      if (!tree_has_ident2(decl))
+         return false;
+
+      switch (is_well_known(tree_ident2(decl))) {
+      case W_IEEE_1164_RISING:
+      case W_IEEE_1164_FALLING:
+         break;
+      default:
+         return false;
+      }
+      break;
+   default:
+      return false;
+   }
+
+   const int nparams = tree_params(expr);
+   for (int i = 0; i < nparams; i++) {
+      tree_t p = tree_param(expr, i);
+      if (tree_subkind(p) != P_POS || !lower_is_side_effect_free(tree_value(p)))
+         return false;
+   }
+
+   return true;
+}
+
+static uint64_t lower_edge_mask(tree_t expr, tree_t trigger)
+{
+   // Conservative set of values of the trigger signal for which the
+   // condition may be true after an event
+   if (tree_kind(expr) != T_FCALL || !tree_has_ref(expr))
+      return UINT64_MAX;
+
+   type_t type = tree_type(trigger);
+   tree_t decl = tree_ref(expr);
+
+   switch (tree_subkind(decl)) {
+   case S_RISING_EDGE:
+      if (lower_is_trigger_arg(expr, 0, trigger))
+         return lower_literal_mask(type, "'1'")
+            | lower_literal_mask(type, "TRUE");
+      break;
+   case S_FALLING_EDGE:
+      if (lower_is_trigger_arg(expr, 0, trigger))
+         return lower_literal_mask(type, "'0'")
+            | lower_literal_mask(type, "FALSE");
+      break;
+   case S_SCALAR_AND:
+      {
+         // The right operand is only evaluated when the left is true so
+         // can only narrow the mask if skipping the left has no effect
+         tree_t left = tree_value(tree_param(expr, 0));
+         tree_t right = tree_value(tree_param(expr, 1));
+         uint64_t mask = lower_edge_mask(left, trigger);
+         if (lower_is_side_effect_free(left))
+            mask &= lower_edge_mask(right, trigger);
+         return mask;
+      }
+   case S_SCALAR_OR:
+      return lower_edge_mask(tree_value(tree_param(expr, 0)), trigger)
+         | lower_edge_mask(tree_value(tree_param(expr, 1)), trigger);
+   case S_SCALAR_EQ:
+      for (int i = 0; i < 2; i++) {
+         if (!lower_is_trigger_arg(expr, i, trigger))
+            continue;
+
+         tree_t other = tree_value(tree_param(expr, 1 - i));
+         if (tree_kind(other) == T_REF && tree_has_ref(other)
+             && tree_kind(tree_ref(other)) == T_ENUM_LIT)
+            return UINT64_C(1) << tree_pos(tree_ref(other));
+      }
+      break;
+   case S_USER:
+      if (!tree_has_ident2(decl) || !lower_is_trigger_arg(expr, 0, trigger))
+         break;
+
+      switch (is_well_known(tree_ident2(decl))) {
+      case W_IEEE_1164_RISING:
+         return lower_literal_mask(type, "'1'")
+            | lower_literal_mask(type, "'H'");
+      case W_IEEE_1164_FALLING:
+         return lower_literal_mask(type, "'0'")
+            | lower_literal_mask(type, "'L'");
+      default:
+         break;
+      }
+      break;
+   default:
+      break;
+   }
+
+   return UINT64_MAX;
+}
+
+static vcode_reg_t lower_process_edge_mask(tree_t proc, tree_t wait)
+{
+   // A process whose body is a single if statement guarded on an edge
+   // of its only trigger only needs to be woken for some values of
+   // that signal: the kernel keeps these in separate per-value lists
+   if (tree_flags(proc) & TREE_F_POSTPONED)
+      return VCODE_INVALID_REG;
+   else if (tree_stmts(proc) != 2 || tree_triggers(wait) != 1)
+      return VCODE_INVALID_REG;
+
+   tree_t trigger = tree_trigger(wait, 0);
+   if (tree_kind(trigger) != T_REF || !tree_has_ref(trigger))
+      return VCODE_INVALID_REG;
+
+   const tree_kind_t kind = tree_kind(tree_ref(trigger));
+   if (kind != T_SIGNAL_DECL && kind != T_PORT_DECL)
+      return VCODE_INVALID_REG;
+
+   type_t type = tree_type(trigger);
+   if (!type_is_enum(type) || type_enum_literals(type_base_recur(type)) > 63)
+      return VCODE_INVALID_REG;
+
+   tree_t stmt = tree_stmt(proc, 0);
+   if (tree_kind(stmt) != T_IF || tree_conds(stmt) != 1)
+      return VCODE_INVALID_REG;
+
+   tree_t c0 = tree_cond(stmt, 0);
+   if (!tree_has_value(c0))
+      return VCODE_INVALID_REG;
+
+   const int nlits = type_enum_literals(type_base_recur(type));
+   const uint64_t all = (UINT64_C(1) << nlits) - 1;
+   const uint64_t mask = lower_edge_mask(tree_value(c0), trigger) & all;
+   if (mask == 0 || mask == all)
+      return VCODE_INVALID_REG;
+
+   return emit_const(vtype_int(0, INT64_MAX), mask);
+}
+
 void lower_process(lower_unit_t *parent, tree_t proc)
 {
    mode = LOWER_NORMAL;
@@ -10071,9 +10280,12 @@ void lower_process(lower_unit_t *parent, tree_t proc)
        && tree_kind((wait = tree_stmt(proc, nstmts - 1))) == T_WAIT
        && (tree_flags(wait) & TREE_F_STATIC_WAIT)) {
 
+      vcode_reg_t mask_reg = lower_process_edge_mask(proc, wait);
+
       const int ntriggers = tree_triggers(wait);
       for (int i = 0; i < ntriggers; i++)
-         lower_sched_event(lu, tree_trigger(wait, i), VCODE_INVALID_REG);
+         lower_sched_event(lu, tree_trigger(wait, i), VCODE_INVALID_REG,
+                           mask_reg);
    }
 
    emit_return(VCODE_INVALID_REG);
@@ -16,13 +16,16 @@
 //
 
 #include "util.h"
+#include "array.h"
 #include "common.h"
 #include "diag.h"
 #include "hash.h"
 #include "ident.h"
+#include "jit/jit.h"
 #include "lib.h"
 #include "option.h"
 #include "phase.h"
+#include "scan.h"
 
 #include <limits.h>
 #include <unistd.h>
@@ -30,10 +33,15 @@
 #include <string.h>
 #include <ctype.h>
 #include <assert.h>
+#include <errno.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
+#ifndef __MINGW32__
+#include <sys/wait.h>
+#endif
+
 typedef enum {
    MAKE_TREE,
    MAKE_LIB,
@@ -49,20 +57,39 @@ struct ident_list {
 
 typedef struct rule rule_t;
 
+typedef A(rule_t *) rule_array_t;
+
 typedef enum {
    RULE_ANALYSE,
    RULE_ELABORATE
 } rule_kind_t;
 
+typedef enum {
+   RULE_UNVISITED,
+   RULE_VISITING,
+   RULE_VISITED
+} rule_state_t;
+
 struct rule {
    rule_t       *next;
    rule_kind_t   kind;
    ident_list_t *outputs;
    ident_list_t *inputs;
    ident_t       source;
+   rule_state_t  state;
+   bool          stale;
+   int           blocked;
+   rule_array_t  waiters;
+   pid_t         pid;
 };
 
+typedef struct {
+   tree_t   entity;
+   rule_t **rules;
+} arch_ctx_t;
+
 static hash_t *rule_map = NULL;
+static bool    building = false;
 
 static void make_rule(tree_t t, rule_t **rules);
 
@@ -150,9 +177,7 @@ static rule_t *make_rule_for_source(rule_t **all, rule_kind_t kind,
          break;
    }
 
-   rule_t *new = xmalloc(sizeof(rule_t));
-   new->inputs  = NULL;
-   new->outputs = NULL;
+   rule_t *new = xcalloc(sizeof(rule_t));
    new->kind    = kind;
    new->next    = *ins;
    new->source  = ident;
@@ -167,6 +192,7 @@ static void make_free_rules(rule_t *list)
       rule_t *tmp = list->next;
       ident_list_free(list->inputs);
       ident_list_free(list->outputs);
+      ACLEAR(list->waiters);
       free(list);
       list = tmp;
    }
@@ -220,6 +246,23 @@ static void make_dep_rules_cb(ident_t name, void *__ctx)
       make_rule(unit, rules);
 }
 
+static void make_arch_rules_cb(lib_t lib, ident_t name, int kind, void *__ctx)
+{
+   arch_ctx_t *ctx = __ctx;
+
+   if (kind != T_ARCH)
+      return;
+
+   const char *entity = istr(tree_ident(ctx->entity));
+   const size_t len = strlen(entity);
+   if (strncmp(istr(name), entity, len) != 0 || istr(name)[len] != '-')
+      return;
+
+   tree_t arch = lib_get(lib, name);
+   if (arch != NULL)
+      make_rule(arch, ctx->rules);
+}
+
 static void make_rule(tree_t t, rule_t **rules)
 {
    if (hash_get(rule_map, t))
@@ -284,6 +327,13 @@ static void make_rule(tree_t t, rule_t **rules)
    }
 
    tree_walk_deps(t, make_dep_rules_cb, rules);
+
+   if (kind == T_ENTITY && building) {
+      // Architectures are not dependencies of their entity but must
+      // also be brought up to date when building
+      arch_ctx_t ctx = { t, rules };
+      lib_walk_index(work, make_arch_rules_cb, &ctx);
+   }
 }
 
 static void make_header(tree_t *targets, int count, FILE *out)
@@ -424,3 +474,213 @@ void make(tree_t *targets, int count, FILE *out)
    hash_free(rule_map);
    rule_map = NULL;
 }
+
+static void make_check_stale(rule_t *r, hash_t *products)
+{
+   if (r->state != RULE_UNVISITED)
+      return;
+
+   r->state = RULE_VISITING;
+
+   // Source files are compared with the content hashes recorded in
+   // the library rather than modification times
+   r->stale = !lib_up_to_date(lib_work(), istr(r->source));
+
+   for (ident_list_t *it = r->inputs; it != NULL; it = it->next) {
+      rule_t *dep = hash_get(products, it->ident);
+      if (dep != NULL && dep != r && dep->state != RULE_VISITING) {
+         // Circular dependencies between source files are ignored here
+         // in the same way as an external make would drop them
+         make_check_stale(dep, products);
+
+         if (dep->stale) {
+            APUSH(dep->waiters, r);
+            r->blocked++;
+            r->stale = true;
+         }
+      }
+   }
+
+   r->state = RULE_VISITED;
+}
+
+static bool make_analyse(rule_t *r, bool verbose)
+{
+   // Any unit in the work library may have been reanalysed by an
+   // earlier job so discard the cached copies: units in other libraries
+   // are still shared
+   lib_t work = lib_work();
+   lib_refresh(work);
+
+   const int errors = error_count();
+   const unsigned warnings = warning_count();
+
+   input_from_file(istr(r->source));
+
+   switch (source_kind()) {
+   case SOURCE_VERILOG:
+      analyse_verilog(verbose);
+      break;
+
+   case SOURCE_VHDL:
+      {
+         jit_t *jit = jit_new();
+         analyse_vhdl(jit, verbose);
+         jit_free(jit);
+      }
+      break;
+   }
+
+   if (error_count() > errors)
+      return false;
+
+   lib_analysed_file(work, istr(r->source), warning_count() > warnings);
+   lib_save(work);
+   return true;
+}
+
+static void make_finished(rule_t *r, rule_array_t *ready)
+{
+   for (int i = 0; i < r->waiters.count; i++) {
+      if (--(r->waiters.items[i]->blocked) == 0)
+         APUSH(*ready, r->waiters.items[i]);
+   }
+}
+
+#ifdef __MINGW32__
+
+static bool make_execute(rule_t *rules, int jobs, bool verbose)
+{
+   // There is no fork on Windows so analyse each file in turn
+   rule_array_t ready = AINIT;
+   for (rule_t *r = rules; r != NULL; r = r->next) {
+      if (r->stale && r->blocked == 0)
+         APUSH(ready, r);
+   }
+
+   bool failed = false;
+   while (!failed && ready.count > 0) {
+      rule_t *r = ready.items[--ready.count];
+      if (make_analyse(r, verbose))
+         make_finished(r, &ready);
+      else
+         failed = true;
+   }
+
+   ACLEAR(ready);
+   return !failed;
+}
+
+#else  // __MINGW32__
+
+static rule_t *make_wait(rule_array_t *running, int *status)
+{
+   for (;;) {
+      const pid_t pid = waitpid(-1, status, 0);
+      if (pid < 0 && errno == EINTR)
+         continue;
+      else if (pid < 0)
+         fatal_errno("waitpid");
+
+      for (int i = 0; i < running->count; i++) {
+         rule_t *r = running->items[i];
+         if (r->pid == pid) {
+            running->items[i] = running->items[--running->count];
+            return r;
+         }
+      }
+   }
+}
+
+static bool make_execute(rule_t *rules, int jobs, bool verbose)
+{
+   rule_array_t ready = AINIT, running = AINIT;
+   for (rule_t *r = rules; r != NULL; r = r->next) {
+      if (r->stale && r->blocked == 0)
+         APUSH(ready, r);
+   }
+
+   bool failed = false;
+   while (ready.count > 0 || running.count > 0) {
+      while (!failed && ready.count > 0 && running.count < jobs) {
+         rule_t *r = ready.items[--ready.count];
+
+         fflush(stdout);
+         fflush(stderr);
+
+         // Each job inherits a copy of all the libraries already
+         // loaded by the parent
+         if ((r->pid = fork()) == 0) {
+            const bool success = make_analyse(r, verbose);
+
+            fflush(stdout);
+            fflush(stderr);
+
+            exit(success ? EXIT_SUCCESS : EXIT_FAILURE);
+         }
+         else if (r->pid < 0)
+            fatal_errno("fork");
+
+         APUSH(running, r);
+      }
+
+      if (running.count == 0)
+         break;
+
+      // Let any jobs already started run to completion after a failure
+      int status;
+      rule_t *r = make_wait(&running, &status);
+      if (WIFSIGNALED(status)) {
+         errorf("analysis of %s terminated by signal %d",
+                istr(r->source), WTERMSIG(status));
+         failed = true;
+      }
+      else if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+         failed = true;
+      else
+         make_finished(r, &ready);
+   }
+
+   ACLEAR(ready);
+   ACLEAR(running);
+
+   return !failed;
+}
+
+#endif  // __MINGW32__
+
+bool make_build(tree_t *targets, int count, int jobs, bool verbose)
+{
+   rule_map = hash_new(256);
+   building = true;
+
+   rule_t *rules = NULL;
+   for (int i = 0; i < count; i++)
+      make_rule(targets[i], &rules);
+
+   hash_t *products = hash_new(256);
+   for (rule_t *r = rules; r != NULL; r = r->next) {
+      for (ident_list_t *it = r->outputs; it != NULL; it = it->next)
+         hash_put(products, it->ident, r);
+   }
+
+   // Elaboration is left to a subsequent -e command
+   for (rule_t *r = rules; r != NULL; r = r->next) {
+      if (r->kind == RULE_ANALYSE)
+         make_check_stale(r, products);
+   }
+
+   const bool success = make_execute(rules, jobs, verbose);
+
+   // Reload units from the work library as they may have changed
+   lib_refresh(lib_work());
+
+   hash_free(products);
+   make_free_rules(rules);
+
+   hash_free(rule_map);
+   rule_map = NULL;
+   building = false;
+
+   return success;
+}
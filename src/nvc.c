@@ -28,6 +28,7 @@
 #include "rt/model.h"
 #include "rt/mspace.h"
 #include "rt/rt.h"
+#include "rt/server.h"
 #include "rt/shell.h"
 #include "rt/wave.h"
 #include "scan.h"
@@ -85,7 +86,8 @@ static int scan_cmd(int start, int argc, char **argv)
 {
    const char *commands[] = {
       "-a", "-e", "-r", "-c", "--dump", "--make", "--syntax", "--list",
-      "--init", "--install", "--print-deps", "--aotgen", "--do", "-i"
+      "--init", "--install", "--print-deps", "--aotgen", "--do", "-i",
+      "--server"
    };
 
    for (int i = start; i < argc; i++) {
@@ -137,6 +139,7 @@ static int analyse(int argc, char **argv)
    const int next_cmd = scan_cmd(2, argc, argv);
    int c, index = 0;
    const char *spec = ":D:";
+   bool defines = false;
 
    while ((c = getopt_long(next_cmd, argv, spec, long_options, &index)) != -1) {
       switch (c) {
@@ -169,6 +172,7 @@ static int analyse(int argc, char **argv)
          break;
       case 'D':
          parse_pp_define(optarg);
+         defines = true;
          break;
       default:
          abort();
@@ -179,6 +183,13 @@ static int analyse(int argc, char **argv)
    jit_t *jit = jit_new();
 
    for (int i = optind; i < next_cmd; i++) {
+      // Skip files that have not changed since they were last analysed
+      // unless preprocessor definitions might change the result
+      if (!defines && lib_up_to_date(work, argv[i]))
+         continue;
+
+      const unsigned warnings = warning_count();
+
       input_from_file(argv[i]);
 
       switch (source_kind()) {
@@ -190,6 +201,9 @@ static int analyse(int argc, char **argv)
          analyse_vhdl(jit, false);
          break;
       }
+
+      // Files with warnings are always reanalysed so they are not hidden
+      lib_analysed_file(work, argv[i], warning_count() > warnings);
    }
 
    jit_free(jit);
@@ -249,7 +263,8 @@ static void parse_cover_options(const char *str, cover_mask_t *mask,
       { "count-from-undefined",  COVER_MASK_TOGGLE_COUNT_FROM_UNDEFINED },
       { "count-from-to-z",       COVER_MASK_TOGGLE_COUNT_FROM_TO_Z      },
       { "include-mems",          COVER_MASK_TOGGLE_INCLUDE_MEMS         },
-      { "exclude-unreachable",   COVER_MASK_EXCLUDE_UNREACHABLE         }
+      { "exclude-unreachable",   COVER_MASK_EXCLUDE_UNREACHABLE         },
+      { "hit-once",              COVER_MASK_STMT_HIT_ONCE               }
    };
 
    for (const char *start = str; ; str++) {
@@ -305,6 +320,8 @@ static int elaborate(int argc, char **argv)
       { "verbose",         no_argument,       0, 'V' },
       { "no-save",         no_argument,       0, 'N' },
       { "jit",             no_argument,       0, 'j' },
+      { "no-link",         no_argument,       0, 'n' },
+      { "fuse-processes",  optional_argument, 0, 'F' },
       { 0, 0, 0, 0 }
    };
 
@@ -341,6 +358,21 @@ static int elaborate(int argc, char **argv)
       case 'j':
          use_jit = true;
          break;
+      case 'n':
+#if defined __APPLE__ || defined __MINGW32__
+         fatal("$bold$--no-link$$ is not supported on this platform");
+#else
+         opt_set_int(OPT_NO_LINK, 1);
+#endif
+         break;
+      case 'F':
+         if (optarg == NULL)
+            opt_set_int(OPT_FUSE_PROCESSES, 1);
+         else if (strcmp(optarg, "chains") == 0)
+            opt_set_int(OPT_FUSE_PROCESSES, 2);
+         else
+            fatal("invalid argument %s to $bold$--fuse-processes$$", optarg);
+         break;
       case 'g':
          parse_generic(optarg);
          break;
@@ -505,6 +537,46 @@ static jit_t *get_jit(void)
    return jit;
 }
 
+static wave_dumper_t *open_wave_dumper(tree_t top, wave_format_t wave_fmt,
+                                       const char *wave_fname,
+                                       const char *gtkw_fname,
+                                       uint64_t wave_start, uint64_t wave_stop)
+{
+   if (wave_fname == NULL) {
+      if (gtkw_fname != NULL)
+         warnf("$bold$--gtkw$$ option has no effect without $bold$--wave$$");
+      if (wave_start != 0 || wave_stop != TIME_HIGH)
+         warnf("$bold$--wave-start$$ and $bold$--wave-stop$$ options have "
+               "no effect without $bold$--wave$$");
+      return NULL;
+   }
+
+   if (wave_start >= wave_stop)
+      fatal("$bold$--wave-start$$ time must be less than "
+            "$bold$--wave-stop$$ time");
+
+   const char *name_map[] = { "FST", "VCD" };
+   const char *ext_map[]  = { "fst", "vcd" };
+   char *tmp LOCAL = NULL, *tmp2 LOCAL = NULL;
+
+   if (*wave_fname == '\0') {
+      tmp = xasprintf("%s.%s", top_level_orig, ext_map[wave_fmt]);
+      wave_fname = tmp;
+      notef("writing %s waveform data to %s", name_map[wave_fmt], tmp);
+   }
+
+   if (gtkw_fname != NULL && *gtkw_fname == '\0') {
+      tmp2 = xasprintf("%s.gtkw", top_level_orig);
+      gtkw_fname = tmp2;
+   }
+
+   wave_include_file(top_level_orig);
+
+   wave_dumper_t *wd = wave_dumper_new(wave_fname, gtkw_fname, top, wave_fmt);
+   wave_dumper_set_window(wd, wave_start, wave_stop);
+   return wd;
+}
+
 static int run(int argc, char **argv)
 {
    static struct option long_options[] = {
@@ -523,14 +595,20 @@ static int run(int argc, char **argv)
       { "load",          required_argument, 0, 'l' },
       { "vhpi-trace",    no_argument,       0, 'T' },
       { "gtkw",          optional_argument, 0, 'g' },
+      { "wave-start",    required_argument, 0, 'b' },
+      { "wave-stop",     required_argument, 0, 'E' },
+      { "connect",       required_argument, 0, 'C' },
       { 0, 0, 0, 0 }
    };
 
    wave_format_t wave_fmt = WAVE_FORMAT_FST;
    uint64_t      stop_time = TIME_HIGH;
+   uint64_t      wave_start = 0;
+   uint64_t      wave_stop = TIME_HIGH;
    const char   *wave_fname = NULL;
    const char   *gtkw_fname = NULL;
    const char   *vhpi_plugins = NULL;
+   const char   *connect_path = NULL;
 
    static bool have_run = false;
    if (have_run)
@@ -586,6 +664,12 @@ static int run(int argc, char **argv)
          else
             gtkw_fname = optarg;
          break;
+      case 'b':
+         wave_start = parse_time(optarg);
+         break;
+      case 'E':
+         wave_stop = parse_time(optarg);
+         break;
       case 'd':
          opt_set_int(OPT_STOP_DELTA, parse_int(optarg));
          break;
@@ -607,11 +691,39 @@ static int run(int argc, char **argv)
       case 'a':
          opt_set_int(OPT_DUMP_ARRAYS, 1);
          break;
+      case 'C':
+         connect_path = optarg;
+         break;
       default:
          abort();
       }
    }
 
+   if (connect_path != NULL) {
+      // Forward the remaining options to the server unchanged: getopt
+      // preserves the relative order of options when permuting.  The
+      // option argument points into the argument vector which finds
+      // --connect however it was spelled on the command line.
+      char **args LOCAL = xmalloc_array(next_cmd, sizeof(char *));
+      int nargs = 0;
+      for (int i = 2; i < next_cmd; i++) {
+         const char *end = argv[i] + strlen(argv[i]);
+         if (connect_path > argv[i] && connect_path <= end)
+            continue;   // Path follows an equals sign
+         else if (i + 1 < next_cmd && argv[i + 1] == connect_path)
+            i++;   // Path is the following argument
+         else
+            args[nargs++] = argv[i];
+      }
+
+      const int rc = server_connect(connect_path, nargs, args);
+
+      argc -= next_cmd - 1;
+      argv += next_cmd - 1;
+
+      return rc == 0 && argc > 1 ? process_command(argc, argv) : rc;
+   }
+
    set_top_level(argv, next_cmd);
 
    ident_t ename = ident_prefix(top_level, well_known(W_ELAB), '.');
@@ -619,28 +731,9 @@ static int run(int argc, char **argv)
    if (top == NULL)
       fatal("%s not elaborated", istr(top_level));
 
-   wave_dumper_t *dumper = NULL;
-   if (wave_fname != NULL) {
-      const char *name_map[] = { "FST", "VCD" };
-      const char *ext_map[]  = { "fst", "vcd" };
-      char *tmp LOCAL = NULL, *tmp2 LOCAL = NULL;
-
-      if (*wave_fname == '\0') {
-         tmp = xasprintf("%s.%s", top_level_orig, ext_map[wave_fmt]);
-         wave_fname = tmp;
-         notef("writing %s waveform data to %s", name_map[wave_fmt], tmp);
-      }
-
-      if (gtkw_fname != NULL && *gtkw_fname == '\0') {
-         tmp2 = xasprintf("%s.gtkw", top_level_orig);
-         gtkw_fname = tmp2;
-      }
-
-      wave_include_file(argv[optind]);
-      dumper = wave_dumper_new(wave_fname, gtkw_fname, top, wave_fmt);
-   }
-   else if (gtkw_fname != NULL)
-      warnf("$bold$--gtkw$$ option has no effect without $bold$--wave$$");
+   wave_dumper_t *dumper =
+      open_wave_dumper(top, wave_fmt, wave_fname, gtkw_fname,
+                       wave_start, wave_stop);
 
    if (opt_get_size(OPT_HEAP_SIZE) < 0x100000)
       warnf("recommended heap size is at least 1M");
@@ -678,6 +771,228 @@ static int run(int argc, char **argv)
    return rc == 0 && argc > 1 ? process_command(argc, argv) : rc;
 }
 
+typedef struct {
+   tree_t      top;
+   jit_t      *jit;
+   rt_model_t *model;
+} server_ctx_t;
+
+static int server_run(int argc, char **argv, void *ctx)
+{
+   static struct option long_options[] = {
+      { "stop-time",     required_argument, 0, 's' },
+      { "stats",         no_argument,       0, 'S' },
+      { "wave",          optional_argument, 0, 'w' },
+      { "format",        required_argument, 0, 'f' },
+      { "include",       required_argument, 0, 'i' },
+      { "exclude",       required_argument, 0, 'e' },
+      { "exit-severity", required_argument, 0, 'x' },
+      { "dump-arrays",   no_argument,       0, 'a' },
+      { "gtkw",          optional_argument, 0, 'g' },
+      { "wave-start",    required_argument, 0, 'b' },
+      { "wave-stop",     required_argument, 0, 'E' },
+      { "trace",         no_argument,       0, 'F' },
+      { "profile",       no_argument,       0, 'F' },
+      { "stop-delta",    required_argument, 0, 'F' },
+      { "ieee-warnings", required_argument, 0, 'F' },
+      { "load",          required_argument, 0, 'F' },
+      { "vhpi-trace",    no_argument,       0, 'F' },
+      { 0, 0, 0, 0 }
+   };
+
+   server_ctx_t *sc = ctx;
+
+   wave_format_t wave_fmt = WAVE_FORMAT_FST;
+   uint64_t      stop_time = TIME_HIGH;
+   uint64_t      wave_start = 0;
+   uint64_t      wave_stop = TIME_HIGH;
+   const char   *wave_fname = NULL;
+   const char   *gtkw_fname = NULL;
+
+   opterr = 0;
+   optind = 1;
+
+   int c, index = 0;
+   const char *spec = ":w::l:gi";
+   while ((c = getopt_long(argc, argv, spec, long_options, &index)) != -1) {
+      switch (c) {
+      case '?':
+         bad_option("run", argv);
+      case ':':
+         missing_argument("run", argv);
+      case 'l':
+      case 'F':
+         fatal("option $bold$%s$$ must be passed when the server is "
+               "started", argv[optind - 1]);
+      case 's':
+         stop_time = parse_time(optarg);
+         break;
+      case 'f':
+         if (strcmp(optarg, "vcd") == 0)
+            wave_fmt = WAVE_FORMAT_VCD;
+         else if (strcmp(optarg, "fst") == 0)
+            wave_fmt = WAVE_FORMAT_FST;
+         else
+            fatal("invalid waveform format: %s", optarg);
+         break;
+      case 'S':
+         opt_set_int(OPT_RT_STATS, 1);
+         break;
+      case 'w':
+         if (optarg == NULL)
+            wave_fname = "";
+         else
+            wave_fname = optarg;
+         break;
+      case 'g':
+         if (optarg == NULL)
+            gtkw_fname = "";
+         else
+            gtkw_fname = optarg;
+         break;
+      case 'b':
+         wave_start = parse_time(optarg);
+         break;
+      case 'E':
+         wave_stop = parse_time(optarg);
+         break;
+      case 'i':
+         wave_include_glob(optarg);
+         break;
+      case 'e':
+         wave_exclude_glob(optarg);
+         break;
+      case 'x':
+         set_exit_severity(parse_severity(optarg));
+         break;
+      case 'a':
+         opt_set_int(OPT_DUMP_ARRAYS, 1);
+         break;
+      default:
+         abort();
+      }
+   }
+
+   if (optind < argc && to_unit_name(argv[optind]) != top_level)
+      fatal("server is running %s not %s", top_level_orig, argv[optind]);
+   else if (optind + 1 < argc)
+      fatal("unexpected argument $bold$%s$$", argv[optind + 1]);
+
+   wave_dumper_t *dumper =
+      open_wave_dumper(sc->top, wave_fmt, wave_fname, gtkw_fname,
+                       wave_start, wave_stop);
+
+   set_ctrl_c_handler(ctrl_c_handler, sc->model);
+
+   if (dumper != NULL)
+      wave_dumper_restart(dumper, sc->model);
+
+   model_run(sc->model, stop_time);
+
+   set_ctrl_c_handler(NULL, NULL);
+
+   const int rc = jit_exit_status(sc->jit);
+
+   if (dumper != NULL)
+      wave_dumper_free(dumper);
+
+   model_free(sc->model);
+   jit_free(sc->jit);
+
+   return rc;
+}
+
+static int server_cmd(int argc, char **argv)
+{
+   static struct option long_options[] = {
+      { "socket",        required_argument, 0, 's' },
+      { "trace",         no_argument,       0, 't' },
+      { "profile",       no_argument,       0, 'p' },
+      { "stop-delta",    required_argument, 0, 'd' },
+      { "ieee-warnings", required_argument, 0, 'I' },
+      { "load",          required_argument, 0, 'l' },
+      { "vhpi-trace",    no_argument,       0, 'T' },
+      { 0, 0, 0, 0 }
+   };
+
+   const char *socket_path = NULL;
+   const char *vhpi_plugins = NULL;
+
+   const int next_cmd = scan_cmd(2, argc, argv);
+
+   int c, index = 0;
+   const char *spec = ":l:";
+   while ((c = getopt_long(next_cmd, argv, spec, long_options, &index)) != -1) {
+      switch (c) {
+      case '?':
+         bad_option("server", argv);
+      case ':':
+         missing_argument("server", argv);
+      case 's':
+         socket_path = optarg;
+         break;
+      case 't':
+         opt_set_int(OPT_RT_TRACE, 1);
+         break;
+      case 'p':
+         opt_set_int(OPT_RT_PROFILE, 1);
+         break;
+      case 'T':
+         opt_set_str(OPT_VHPI_TRACE, "1");
+         break;
+      case 'd':
+         opt_set_int(OPT_STOP_DELTA, parse_int(optarg));
+         break;
+      case 'l':
+         vhpi_plugins = optarg;
+         break;
+      case 'I':
+         opt_set_int(OPT_IEEE_WARNINGS, parse_on_off(optarg));
+         break;
+      default:
+         abort();
+      }
+   }
+
+   set_top_level(argv, next_cmd);
+
+   ident_t ename = ident_prefix(top_level, well_known(W_ELAB), '.');
+   tree_t top = lib_get(lib_work(), ename);
+   if (top == NULL)
+      fatal("%s not elaborated", istr(top_level));
+
+   char *tmp LOCAL = NULL;
+   if (socket_path == NULL)
+      socket_path = tmp = xasprintf("%s.sock", top_level_orig);
+
+   if (opt_get_size(OPT_HEAP_SIZE) < 0x100000)
+      warnf("recommended heap size is at least 1M");
+
+   jit_t *jit = get_jit();
+   AOT_ONLY(jit_load_dll(jit, tree_ident(top)));
+
+   rt_model_t *model = model_new(top, jit);
+
+   if (vhpi_plugins != NULL)
+      vhpi_load_plugins(top, model, vhpi_plugins);
+
+   // Everything up to and including initialisation is shared between
+   // runs and each request then continues from a fresh copy of this
+   // process
+   model_reset(model);
+
+   server_ctx_t ctx = { top, jit, model };
+   server_listen(socket_path, server_run, &ctx);
+
+   model_free(model);
+   jit_free(jit);
+
+   argc -= next_cmd - 1;
+   argv += next_cmd - 1;
+
+   return argc > 1 ? process_command(argc, argv) : EXIT_SUCCESS;
+}
+
 static int print_deps_cmd(int argc, char **argv)
 {
    static struct option long_options[] = {
@@ -724,18 +1039,19 @@ static int print_deps_cmd(int argc, char **argv)
 static int make_cmd(int argc, char **argv)
 {
    static struct option long_options[] = {
-      { "deps-only", no_argument, 0, 'd' },
-      { "posix",     no_argument, 0, 'p' },
+      { "deps-only", no_argument,       0, 'd' },
+      { "posix",     no_argument,       0, 'p' },
+      { "jobs",      required_argument, 0, 'j' },
+      { "verbose",   no_argument,       0, 'V' },
       { 0, 0, 0, 0 }
    };
 
-   warnf("the $bold$--make$$ command is deprecated and may be repurposed in a "
-         "future release");
-   notef("use $bold$--print-deps$$ to print Makefile dependencies instead");
+   int jobs = nvc_nprocs();
+   bool verbose = false;
 
    const int next_cmd = scan_cmd(2, argc, argv);
    int c, index = 0;
-   const char *spec = ":";
+   const char *spec = ":j:V";
    while ((c = getopt_long(next_cmd, argv, spec, long_options, &index)) != -1) {
       switch (c) {
       case 0:
@@ -747,6 +1063,13 @@ static int make_cmd(int argc, char **argv)
       case 'p':
          // Does nothing
          break;
+      case 'j':
+         if ((jobs = parse_int(optarg)) < 1)
+            fatal("invalid number of jobs %s", optarg);
+         break;
+      case 'V':
+         verbose = true;
+         break;
       case '?':
          bad_option("make", argv);
       case ':':
@@ -756,6 +1079,13 @@ static int make_cmd(int argc, char **argv)
       }
    }
 
+   const bool deps_only = opt_get_int(OPT_MAKE_DEPS_ONLY);
+
+   // Source file timestamps are checked when deciding what to rebuild
+   const int ignore_time = opt_get_int(OPT_IGNORE_TIME);
+   if (!deps_only)
+      opt_set_int(OPT_IGNORE_TIME, 1);
+
    const int count = next_cmd - optind;
    tree_t *targets = xmalloc_array(count, sizeof(tree_t));
 
@@ -771,7 +1101,17 @@ static int make_cmd(int argc, char **argv)
       }
    }
 
-   make(targets, count, stdout);
+   if (deps_only)
+      make(targets, count, stdout);
+   else {
+      const bool success = make_build(targets, count, jobs, verbose);
+      free(targets);
+
+      opt_set_int(OPT_IGNORE_TIME, ignore_time);
+
+      if (!success)
+         return EXIT_FAILURE;
+   }
 
    argc -= next_cmd - 1;
    argv += next_cmd - 1;
@@ -1252,23 +1592,20 @@ static int coverage(int argc, char **argv)
    if (optind == argc)
       fatal("no input coverage database FILE specified");
 
-   cover_tagging_t *cover = NULL;
-
-   // Rest of inputs are coverage input files
-   for (int i = optind; i < argc; i++) {
-      fbuf_t *f = fbuf_open(argv[i], FBUF_IN, FBUF_CS_NONE);
+   // First input defines the set of tags, rest are merged into it
+   fbuf_t *in = fbuf_open(argv[optind], FBUF_IN, FBUF_CS_NONE);
+   if (in == NULL)
+      fatal("Could not open coverage database: %s", argv[optind]);
 
-      if (f != NULL) {
-         progress("Loading input coverage database: %s", argv[i]);
-         if (i == optind)
-            cover = cover_read_tags(f, rpt_mask);
-         else
-            cover_merge_tags(f, cover);
-      }
-      else
-         fatal("Could not open coverage database: %s", argv[i]);
+   progress("Loading input coverage database: %s", argv[optind]);
+   cover_tagging_t *cover = cover_read_tags(in, rpt_mask);
+   fbuf_close(in, NULL);
 
-      fbuf_close(f, NULL);
+   if (optind + 1 < argc) {
+      const int nmerge = argc - optind - 1;
+      progress("Merging %d input coverage database%s", nmerge,
+               nmerge > 1 ? "s" : "");
+      cover_merge_files(cover, (const char **)argv + optind + 1, nmerge);
    }
 
    if (out_db) {
@@ -1306,10 +1643,13 @@ static void usage(void)
           " --init\t\t\t\tInitialise work library directory\n"
           " --install PKG\t\t\tInstall third-party packages\n"
           " --list\t\t\t\tPrint all units in the library\n"
+          " --make [OPTION]... UNIT...\tReanalyse out-of-date files for UNITs\n"
           " --print-deps [UNIT]...\t\tPrint dependencies in Makefile format\n"
+          " --server [OPTION]... UNIT\tServe repeated runs of UNIT\n"
           " --syntax FILE...\t\tCheck FILEs for syntax errors only\n"
           "\n"
           "Global options may be placed before COMMAND:\n"
+          "     --gc-generational\tUse generational garbage collection\n"
           " -h, --help\t\tDisplay this message and exit\n"
           " -H SIZE\t\tSet the maximum heap size to SIZE bytes\n"
           "     --ignore-time\tSkip source file timestamp check\n"
@@ -1348,6 +1688,7 @@ static void usage(void)
           " -V, --verbose\t\tPrint resource usage at each step\n"
           "\n"
           "Run options:\n"
+          "     --connect=PATH\tRun on the server listening at PATH\n"
           "     --dump-arrays\tInclude nested arrays in waveform dump\n"
           "     --exclude=GLOB\tExclude signals matching GLOB from wave dump\n"
           "     --exit-severity=\tExit after assertion failure of "
@@ -1364,6 +1705,19 @@ static void usage(void)
           "     --trace\t\tTrace simulation events\n"
           "     --vhpi-trace\tTrace VHPI calls and events\n"
           " -w, --wave=FILE\tWrite waveform data; file name is optional\n"
+          "     --wave-start=T\tOnly record waveform data from time T\n"
+          "     --wave-stop=T\tStop recording waveform data at time T\n"
+          "\n"
+          "Make options:\n"
+          " -j, --jobs=NUM\t\tRun NUM analysis jobs in parallel (default\n"
+          "               \t\tis the number of processors)\n"
+          " -V, --verbose\t\tPrint the name of each unit analysed\n"
+          "\n"
+          "Server options:\n"
+          "     --socket=PATH\tListen for requests on PATH (default is\n"
+          "                  \tUNIT.sock)\n"
+          "Also accepts the run options --ieee-warnings, --load, --profile,\n"
+          "--stop-delta, --trace, and --vhpi-trace.\n"
           "\n"
           "Coverage processing options:\n"
           "     --merge=OUTPUT\tMerge all input coverage databases from FILEs\n"
@@ -1487,6 +1841,7 @@ static int process_command(int argc, char **argv)
       { "print-deps", no_argument, 0, 'P' },
       { "aotgen",     no_argument, 0, 'A' },
       { "do",         no_argument, 0, 'D' },
+      { "server",     no_argument, 0, 'S' },
       { 0, 0, 0, 0 }
    };
 
@@ -1524,6 +1879,8 @@ static int process_command(int argc, char **argv)
       return do_cmd(argc, argv);
    case 'i':
       return interact_cmd(argc, argv);
+   case 'S':
+      return server_cmd(argc, argv);
    default:
       fatal("missing command, try %s --help for usage", PACKAGE);
       return EXIT_FAILURE;
@@ -1552,6 +1909,7 @@ int main(int argc, char **argv)
       { "ignore-time", no_argument,       0, 'i' },
       { "force-init",  no_argument,       0, 'f' },   // DEPRECATED 1.7
       { "stderr",      required_argument, 0, 'E' },
+      { "gc-generational", no_argument,   0, 'Y' },
       { 0, 0, 0, 0 }
    };
 
@@ -1608,6 +1966,9 @@ int main(int argc, char **argv)
       case 'H':
          opt_set_size(OPT_HEAP_SIZE, parse_size(optarg));
          break;
+      case 'Y':
+         opt_set_int(OPT_GC_GENERATIONAL, 1);
+         break;
       case 'E':
          set_stderr_severity(parse_severity(optarg));
          break;
@@ -36,12 +36,20 @@ typedef A(object_t **) object_ptr_array_t;
 
 typedef enum { OBJ_DISK, OBJ_FRESH } obj_src_t;
 
+typedef struct {
+   arena_key_t arena;
+   uint32_t    offset;
+} far_ref_t;
+
+typedef A(far_ref_t) far_ref_array_t;
+
 typedef struct _object_arena {
    void           *base;
    void           *alloc;
    void           *limit;
    bool            frozen;
    bool            has_locus;
+   bool            obsolete;
    uint32_t       *forward;
    mark_mask_t    *mark_bits;
    size_t          mark_sz;
@@ -58,6 +66,8 @@ typedef struct _object_arena {
 #define OBJECT_UNMAP_UNUSED 1
 #endif
 
+#define MAX_ARENA_SZ  ((size_t)OBJECT_FAR_REF << OBJECT_ALIGN_BITS)
+
 #define ITEM_IDENT       (I_IDENT | I_IDENT2)
 #define ITEM_OBJECT      (I_VALUE | I_SEVERITY | I_MESSAGE | I_TARGET   \
                           | I_DELAY | I_REJECT | I_REF | I_FILE_MODE    \
@@ -96,6 +106,10 @@ static uint32_t        format_digest;
 static generation_t    next_generation = 1;
 static arena_array_t   all_arenas;
 static object_arena_t *global_arena = NULL;
+static far_ref_array_t far_refs;
+static hash_t         *far_map = NULL;
+
+arena_base_array_t arena_bases;
 
 static inline bool object_in_arena_p(object_arena_t *arena, object_t *object)
 {
@@ -109,6 +123,52 @@ static inline object_arena_t *__object_arena(object_t *object)
    return all_arenas.items[object->arena];
 }
 
+static object_ref_t object_encode_ref(arena_key_t arena, object_t *object)
+{
+   if (object == NULL)
+      return 0;
+
+   // Avoid dereferencing the object here as it may not have been
+   // initialised yet when reading an arena from disk
+   object_arena_t *home = all_arenas.items[arena];
+   if (object_in_arena_p(home, object))
+      return (((void *)object - home->base) >> OBJECT_ALIGN_BITS) + 1;
+
+   // References to another arena always point into a frozen arena so
+   // the object cannot move and the side table entry can be shared
+   object_arena_t *oa = __object_arena(object);
+   assert(oa->frozen);
+
+   const uint32_t offset = ((void *)object - oa->base) >> OBJECT_ALIGN_BITS;
+
+   if (far_map == NULL)
+      far_map = hash_new(256);
+
+   uintptr_t index = (uintptr_t)hash_get(far_map, object);
+   if (index == 0) {
+      const far_ref_t far = { object->arena, offset };
+      APUSH(far_refs, far);
+
+      if (far_refs.count == OBJECT_FAR_REF)
+         fatal_trace("too many cross-arena references");
+
+      index = far_refs.count;
+      hash_put(far_map, object, (void *)index);
+   }
+
+   return OBJECT_FAR_REF | (index - 1);
+}
+
+object_t *obj_array_far_ref(object_ref_t ref)
+{
+   assert(ref & OBJECT_FAR_REF);
+   const far_ref_t *far = &(far_refs.items[ref & ~OBJECT_FAR_REF]);
+
+   assert(far->arena > 0 && far->arena < arena_bases.count);
+   const size_t offset = (size_t)far->offset << OBJECT_ALIGN_BITS;
+   return (object_t *)((char *)arena_bases.items[far->arena] + offset);
+}
+
 static ident_t object_arena_name(object_arena_t *arena)
 {
    if (arena->alloc > arena->base) {
@@ -159,6 +219,16 @@ void arena_set_checksum(object_arena_t *arena, uint32_t checksum)
    arena->checksum = checksum;
 }
 
+uint32_t arena_checksum(object_arena_t *arena)
+{
+   return arena->checksum;
+}
+
+void arena_set_obsolete(object_arena_t *arena, bool obsolete)
+{
+   arena->obsolete = obsolete;
+}
+
 object_t *arena_root(object_arena_t *arena)
 {
    return arena->root ?: (object_t *)arena->base;
@@ -226,21 +296,29 @@ void item_without_type(imask_t mask)
    fatal_trace("item %s does not have a type", item_text_map[item]);
 }
 
-void obj_array_add(obj_array_t **a, object_t *o)
+static obj_array_t *obj_array_new(arena_key_t arena, unsigned count)
 {
-   if (*a == NULL) {
-      const int defsz = 8;
-      *a = xmalloc_flex(sizeof(obj_array_t), defsz, sizeof(object_t *));
-      (*a)->count = 0;
-      (*a)->limit = defsz;
-   }
+   obj_array_t *a = xmalloc_flex(sizeof(obj_array_t), count,
+                                 sizeof(object_ref_t));
+   a->count = 0;
+   a->limit = count;
+   a->arena = arena;
+
+   return a;
+}
+
+void obj_array_add(obj_array_t **a, object_t *owner, object_t *o)
+{
+   if (*a == NULL)
+      *a = obj_array_new(owner->arena, 8);
    else if ((*a)->count == (*a)->limit) {
       (*a)->limit *= 2;
       *a = xrealloc_flex(*a, sizeof(obj_array_t),
-                         (*a)->limit, sizeof(object_t *));
+                         (*a)->limit, sizeof(object_ref_t));
    }
 
-   (*a)->items[(*a)->count++] = o;
+   assert((*a)->arena == owner->arena);
+   (*a)->items[(*a)->count++] = object_encode_ref((*a)->arena, o);
 }
 
 void obj_array_free(obj_array_t **a)
@@ -368,6 +446,16 @@ static void check_frozen_object_fault(int sig, void *addr,
    }
 }
 
+static void object_cleanup(void)
+{
+   ACLEAR(far_refs);
+
+   if (far_map != NULL) {
+      hash_free(far_map);
+      far_map = NULL;
+   }
+}
+
 void object_one_time_init(void)
 {
    extern object_class_t tree_object;
@@ -390,6 +478,7 @@ void object_one_time_init(void)
       format_digest += format_fudge * UINT32_C(2654435761);
 
       add_fault_handler(check_frozen_object_fault, NULL);
+      atexit(object_cleanup);
 
       done = true;
    }
@@ -447,6 +536,14 @@ static void gc_forward_one_pointer(object_t **pobject, object_arena_t *arena,
    }
 }
 
+static void gc_forward_one_ref(object_ref_t *ref, uint32_t *forward)
+{
+   // Only references within the same arena can point to objects that
+   // are moved by the GC
+   if (*ref != 0 && !(*ref & OBJECT_FAR_REF))
+      *ref = (forward[*ref - 1] >> OBJECT_ALIGN_BITS) + 1;
+}
+
 static void gc_forward_pointers(object_t *object, object_arena_t *arena,
                                 const object_class_t *class, uint32_t *forward)
 {
@@ -460,8 +557,7 @@ static void gc_forward_pointers(object_t *object, object_arena_t *arena,
             gc_forward_one_pointer(&(item->object), arena, forward);
          else if ((ITEM_OBJ_ARRAY & mask) && item->obj_array != NULL) {
             for (unsigned j = 0; j < item->obj_array->count; j++)
-               gc_forward_one_pointer(&(item->obj_array->items[j]),
-                                      arena, forward);
+               gc_forward_one_ref(&(item->obj_array->items[j]), forward);
          }
 
          i++;
@@ -636,7 +732,7 @@ void object_visit(object_t *object, object_visit_ctx_t *ctx)
          else if (ITEM_OBJ_ARRAY & mask) {
             if (item->obj_array != NULL) {
                for (unsigned j = 0; j < item->obj_array->count; j++)
-                  object_visit(item->obj_array->items[j], ctx);
+                  object_visit(obj_array_nth(item->obj_array, j), ctx);
             }
          }
          else if (ITEM_INT64 & mask)
@@ -743,10 +839,11 @@ object_t *object_rewrite(object_t *object, object_rewrite_ctx_t *ctx)
                // array pointer cannot be cached between iterations
                unsigned wptr = 0;
                for (size_t i = 0; i < object->items[n].obj_array->count; i++) {
-                  object_t *o = object->items[n].obj_array->items[i];
+                  object_t *o = obj_array_nth(object->items[n].obj_array, i);
                   if ((o = object_rewrite(o, ctx))) {
                      object_write_barrier(object, o);
-                     object->items[n].obj_array->items[wptr++] = o;
+                     object->items[n].obj_array->items[wptr++] =
+                        object_encode_ref(object->arena, o);
                   }
                }
 
@@ -858,7 +955,7 @@ void object_write(object_t *root, fbuf_t *f, ident_wr_ctx_t ident_ctx,
                   const unsigned count = item->obj_array->count;
                   fbuf_put_uint(f, count);
                   for (unsigned i = 0; i < count; i++)
-                     object_write_ref(item->obj_array->items[i], f);
+                     object_write_ref(obj_array_nth(item->obj_array, i), f);
                }
                else
                   fbuf_put_uint(f, 0);
@@ -955,7 +1052,9 @@ object_t *object_read(fbuf_t *f, object_load_fn_t loader_fn,
 
       object_arena_t *a = NULL;
       for (unsigned j = 1; a == NULL && j < all_arenas.count; j++) {
-         if (dep == object_arena_name(all_arenas.items[j]))
+         if (all_arenas.items[j]->obsolete)
+            continue;
+         else if (dep == object_arena_name(all_arenas.items[j]))
             a = all_arenas.items[j];
       }
 
@@ -1021,13 +1120,12 @@ object_t *object_read(fbuf_t *f, object_load_fn_t loader_fn,
             else if (ITEM_OBJ_ARRAY & mask) {
                const unsigned count = fbuf_get_uint(f);
                if (count > 0) {
-                  item->obj_array = xmalloc_flex(sizeof(obj_array_t),
-                                                 count, sizeof(object_t *));
-                  item->obj_array->count =
-                     item->obj_array->limit = count;
+                  item->obj_array = obj_array_new(arena->key, count);
+                  item->obj_array->count = count;
                   for (unsigned i = 0; i < count; i++) {
                      object_t *o = object_read_ref(f, key_map);
-                     item->obj_array->items[i] = o;
+                     item->obj_array->items[i] =
+                        object_encode_ref(arena->key, o);
                   }
                }
             }
@@ -1106,7 +1204,7 @@ static bool object_copy_mark(object_t *object, object_copy_ctx_t *ctx)
          else if (ITEM_OBJ_ARRAY & mask) {
             if (item->obj_array != NULL) {
                for (unsigned i = 0; i < item->obj_array->count; i++) {
-                  object_t *o = item->obj_array->items[i];
+                  object_t *o = obj_array_nth(item->obj_array, i);
                   marked |= object_copy_mark(o, ctx);
                }
             }
@@ -1174,16 +1272,14 @@ void object_copy(object_copy_ctx_t *ctx)
                to->dval = from->dval;
             else if (ITEM_OBJ_ARRAY & mask) {
                if (from->obj_array != NULL) {
-                  // TODO: make a resize macro
-                  to->obj_array = xmalloc_flex(sizeof(obj_array_t),
-                                               from->obj_array->count,
-                                               sizeof(object_t *));
-                  to->obj_array->count =
-                     to->obj_array->limit = from->obj_array->count;
-                  for (size_t i = 0; i < from->obj_array->count; i++) {
+                  const unsigned count = from->obj_array->count;
+                  to->obj_array = obj_array_new(copy->arena, count);
+                  to->obj_array->count = count;
+                  for (size_t i = 0; i < count; i++) {
                      object_t *o =
-                        object_copy_map(from->obj_array->items[i], ctx);
-                     to->obj_array->items[i] = o;
+                        object_copy_map(obj_array_nth(from->obj_array, i), ctx);
+                     to->obj_array->items[i] =
+                        object_encode_ref(copy->arena, o);
                      object_write_barrier(copy, o);
                   }
                }
@@ -1224,8 +1320,14 @@ size_t object_arena_default_size(void)
 
 object_arena_t *object_arena_new(size_t size, unsigned std)
 {
-   if (all_arenas.count == 0)
+   if (all_arenas.count == 0) {
       APUSH(all_arenas, NULL);   // Dummy null arena
+      APUSH(arena_bases, NULL);
+   }
+
+   if (size > MAX_ARENA_SZ)
+      fatal("object arena size %zu exceeds maximum of %zu bytes",
+            size, MAX_ARENA_SZ);
 
    object_arena_t *arena = xcalloc(sizeof(object_arena_t));
    arena->base   = nvc_memalign(OBJECT_PAGE_SZ, size);
@@ -1236,6 +1338,7 @@ object_arena_t *object_arena_new(size_t size, unsigned std)
    arena->std    = std;
 
    APUSH(all_arenas, arena);
+   APUSH(arena_bases, arena->base);
 
    if (all_arenas.count == UINT16_MAX - 1)
       fatal_trace("too many object arenas");
@@ -1278,6 +1381,15 @@ void object_arena_walk_deps(object_arena_t *arena, object_arena_deps_fn_t fn,
       (*fn)(object_arena_name(arena->deps.items[i]), context);
 }
 
+void object_arena_walk_checksums(object_arena_t *arena,
+                                 object_arena_checksum_fn_t fn, void *context)
+{
+   for (unsigned i = 0; i < arena->deps.count; i++) {
+      object_arena_t *dep = arena->deps.items[i];
+      (*fn)(object_arena_name(dep), dep->checksum, context);
+   }
+}
+
 void object_locus(object_t *object, ident_t *module, ptrdiff_t *offset)
 {
    object_arena_t *arena = __object_arena(object);
@@ -1296,7 +1408,9 @@ static object_arena_t *arena_by_name(ident_t module)
    // Search backwards to ensure we find the most recent arena with the
    // given name
    for (int j = all_arenas.count - 1; j > 0; j--) {
-      if (module == object_arena_name(all_arenas.items[j]))
+      if (all_arenas.items[j]->obsolete)
+         continue;
+      else if (module == object_arena_name(all_arenas.items[j]))
          return all_arenas.items[j];
    }
 
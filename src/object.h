@@ -130,24 +130,47 @@ STATIC_ASSERT(OBJECT_ALIGN >= sizeof(double));
 typedef uint16_t generation_t;
 typedef uint16_t arena_key_t;
 
+// Arrays hold 32-bit references relative to the arena of the object
+// that owns the array with a side table for references to objects in
+// other arenas
+typedef uint32_t object_ref_t;
+
+#define OBJECT_FAR_REF (UINT32_C(1) << 31)
+
+typedef A(void *) arena_base_array_t;
+
+extern arena_base_array_t arena_bases;
+
 typedef struct {
-   unsigned  count;
-   unsigned  limit;
-   object_t *items[0];
+   unsigned      count;
+   unsigned      limit;
+   arena_key_t   arena;
+   object_ref_t  items[0];
 } obj_array_t;
 
-#define obj_array_nth(a, n) ({                  \
-         assert((a) != NULL);                   \
-         assert((n) < (a)->count);              \
-         (a)->items[(n)];                       \
-      })
-
 #define obj_array_count(a) ({                   \
          obj_array_t *_a = (a);                 \
          (_a == NULL ? 0 : _a->count);          \
       })
 
-void obj_array_add(obj_array_t **a, object_t *o);
+void obj_array_add(obj_array_t **a, object_t *owner, object_t *o);
+object_t *obj_array_far_ref(object_ref_t ref);
+
+static inline object_t *obj_array_nth(obj_array_t *a, unsigned n)
+{
+   assert(a != NULL);
+   assert(n < a->count);
+
+   const object_ref_t ref = a->items[n];
+   if (ref == 0)
+      return NULL;
+   else if (unlikely(ref & OBJECT_FAR_REF))
+      return obj_array_far_ref(ref);
+   else {
+      const size_t offset = (size_t)(ref - 1) << OBJECT_ALIGN_BITS;
+      return (object_t *)((char *)arena_bases.items[a->arena] + offset);
+   }
+}
 
 typedef union {
    ident_t       ident;
@@ -244,6 +267,8 @@ object_arena_t *object_arena(object_t *object);
 size_t object_arena_default_size(void);
 object_t *arena_root(object_arena_t *arena);
 void arena_set_checksum(object_arena_t *arena, uint32_t checksum);
+uint32_t arena_checksum(object_arena_t *arena);
+void arena_set_obsolete(object_arena_t *arena, bool obsolete);
 bool arena_frozen(object_arena_t *arena);
 
 void object_write(object_t *object, fbuf_t *f, ident_wr_ctx_t ident_ctx,
@@ -267,6 +292,10 @@ typedef void (*object_arena_deps_fn_t)(ident_t, void *);
 void object_arena_walk_deps(object_arena_t *arena, object_arena_deps_fn_t fn,
                             void *context);
 
+typedef void (*object_arena_checksum_fn_t)(ident_t, uint32_t, void *);
+void object_arena_walk_checksums(object_arena_t *arena,
+                                 object_arena_checksum_fn_t fn, void *context);
+
 void object_locus(object_t *object, ident_t *module, ptrdiff_t *offset);
 object_t *object_from_locus(ident_t module, ptrdiff_t offset,
                             object_load_fn_t loader);
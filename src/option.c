@@ -156,6 +156,8 @@ void set_default_options(void)
    opt_set_int(OPT_JIT_LOG, get_int_env("NVC_JIT_LOG", 0));
    opt_set_int(OPT_WARN_HIDDEN, 0);
    opt_set_int(OPT_NO_SAVE, 0);
+   opt_set_int(OPT_NO_LINK, 0);
+   opt_set_int(OPT_FUSE_PROCESSES, 0);
    opt_set_str(OPT_LLVM_VERBOSE, getenv("NVC_LLVM_VERBOSE"));
    opt_set_int(OPT_JIT_THRESHOLD, get_int_env("NVC_JIT_THRESHOLD", 100));
    opt_set_str(OPT_ASM_VERBOSE, getenv("NVC_ASM_VERBOSE"));
@@ -164,4 +166,5 @@ void set_default_options(void)
    opt_set_str(OPT_LIB_VERBOSE, getenv("NVC_LIB_VERBOSE"));
    opt_set_str(OPT_PSL_VERBOSE, getenv("NVC_PSL_VERBOSE"));
    opt_set_int(OPT_PSL_COMMENTS, 0);
+   opt_set_int(OPT_GC_GENERATIONAL, get_int_env("NVC_GC_GENERATIONAL", 0));
 }
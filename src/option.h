@@ -52,6 +52,8 @@ typedef enum {
    OPT_JIT_LOG,
    OPT_WARN_HIDDEN,
    OPT_NO_SAVE,
+   OPT_NO_LINK,
+   OPT_FUSE_PROCESSES,
    OPT_LLVM_VERBOSE,
    OPT_JIT_THRESHOLD,
    OPT_ASM_VERBOSE,
@@ -60,6 +62,7 @@ typedef enum {
    OPT_LIB_VERBOSE,
    OPT_PSL_VERBOSE,
    OPT_PSL_COMMENTS,
+   OPT_GC_GENERATIONAL,
 
    OPT_LAST_NAME
 } opt_name_t;
@@ -60,6 +60,10 @@ void vhdl_dump(tree_t t, int indent);
 // Generate a makefile for the givein unit
 void make(tree_t *targets, int count, FILE *out);
 
+// Reanalyse out-of-date source files for the given units using up to
+// JOBS parallel processes
+bool make_build(tree_t *targets, int count, int jobs, bool verbose);
+
 // Read the next unit from the input file
 tree_t parse(void);
 
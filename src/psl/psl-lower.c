@@ -35,7 +35,7 @@ static void psl_wait_cb(tree_t t, void *ctx)
 
    vcode_reg_t nets_reg = lower_lvalue(lu, t);
    vcode_reg_t count_reg = emit_const(vtype_offset(), type_width(tree_type(t)));
-   emit_sched_event(nets_reg, count_reg);
+   emit_sched_event(nets_reg, count_reg, VCODE_INVALID_REG);
 }
 
 static vcode_reg_t psl_lower_boolean(lower_unit_t *lu, psl_node_t p)
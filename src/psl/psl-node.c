@@ -122,9 +122,9 @@ static inline psl_node_t psl_array_nth(item_t *item, unsigned n)
    return container_of(o, struct _psl_node, object);
 }
 
-static inline void psl_array_add(item_t *item, psl_node_t p)
+static inline void psl_array_add(object_t *owner, item_t *item, psl_node_t p)
 {
-   obj_array_add(&(item->obj_array), &(p->object));
+   obj_array_add(&(item->obj_array), owner, &(p->object));
 }
 
 static inline tree_t tree_array_nth(item_t *item, unsigned n)
@@ -133,9 +133,9 @@ static inline tree_t tree_array_nth(item_t *item, unsigned n)
    return container_of(o, struct _tree, object);
 }
 
-static inline void tree_array_add(item_t *item, tree_t t)
+static inline void tree_array_add(object_t *owner, item_t *item, tree_t t)
 {
-   obj_array_add(&(item->obj_array), &(t->object));
+   obj_array_add(&(item->obj_array), owner, &(t->object));
 }
 
 psl_node_t psl_new(psl_kind_t kind)
@@ -229,7 +229,7 @@ psl_node_t psl_operand(psl_node_t p, unsigned n)
 void psl_add_operand(psl_node_t p, psl_node_t o)
 {
    assert(o != NULL);
-   psl_array_add(lookup_item(&psl_object, p, I_PARAMS), o);
+   psl_array_add(&(p->object), lookup_item(&psl_object, p, I_PARAMS), o);
    object_write_barrier(&(p->object), &(o->object));
 }
 
@@ -285,7 +285,7 @@ tree_t psl_port(psl_node_t p, unsigned n)
 void psl_add_port(psl_node_t p, tree_t o)
 {
    assert(o != NULL);
-   tree_array_add(lookup_item(&psl_object, p, I_PORTS), o);
+   tree_array_add(&(p->object), lookup_item(&psl_object, p, I_PORTS), o);
    object_write_barrier(&(p->object), &(o->object));
 }
 
@@ -315,7 +315,7 @@ unsigned psl_decls(psl_node_t p)
 void psl_add_decl(psl_node_t p, tree_t r)
 {
    assert(r != NULL);
-   tree_array_add(lookup_item(&psl_object, p, I_DECLS), r);
+   tree_array_add(&(p->object), lookup_item(&psl_object, p, I_DECLS), r);
    object_write_barrier(&(p->object), &(r->object));
 }
 
@@ -19,11 +19,13 @@
 #include "array.h"
 #include "common.h"
 #include "cover.h"
+#include "hash.h"
 #include "lib.h"
 #include "option.h"
 #include "rt/model.h"
 #include "rt/rt.h"
 #include "rt/structs.h"
+#include "thread.h"
 #include "type.h"
 
 #include <assert.h>
@@ -36,6 +38,10 @@
 #include <time.h>
 #include <ctype.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 //#define COVER_DEBUG_EMIT
 //#define COVER_DEBUG_DUMP
 //#define COVER_DEBUG_SCOPE
@@ -721,11 +727,59 @@ cover_tagging_t *cover_read_tags(fbuf_t *f, uint32_t pre_mask)
    return tagging;
 }
 
-void cover_merge_tags(fbuf_t *f, cover_tagging_t *tagging)
+typedef struct _merge_job merge_job_t;
+
+typedef struct _merge_job {
+   int32_t      *data;
+   merge_job_t  *peer;
+} merge_job_t;
+
+typedef struct {
+   cover_tagging_t  *tagging;
+   hash_t           *index;
+   const char      **files;
+   int               nfiles;
+   int               next;
+} merge_ctx_t;
+
+static hash_t *cover_build_index(cover_tagging_t *tagging)
 {
-   assert (tagging != NULL);
+   // Each statement / branch / signal has a unique hierarchical name
+   // and identifiers are interned so the pointer itself is the key
+   hash_t *index = hash_new(MAX(tagging->tags.count * 2, 16));
 
-   cover_read_header(f, tagging);
+   for (int i = 0; i < tagging->tags.count; i++) {
+      const ident_t hier = tagging->tags.items[i].hier;
+      if (hash_get(index, hier) == NULL)
+         hash_put(index, hier, (void *)(uintptr_t)(i + 1));
+   }
+
+   return index;
+}
+
+static inline void cover_merge_data(tag_kind_t kind, int32_t *to,
+                                    int32_t from)
+{
+   switch (kind) {
+   case TAG_STMT:
+      *to += from;
+      break;
+   case TAG_TOGGLE:
+   case TAG_BRANCH:
+   case TAG_EXPRESSION:
+      *to |= from;
+      break;
+   default:
+      break;
+   }
+}
+
+static void cover_merge_one_file(fbuf_t *f, cover_tagging_t *tagging,
+                                 hash_t *index, int32_t *data)
+{
+   // The header must match the first database so is not used here
+   cover_tagging_t header;
+   cover_read_header(f, &header);
 
    loc_rd_ctx_t *loc_rd = loc_read_begin(f);
    ident_rd_ctx_t ident_ctx = ident_read_begin(f);
@@ -737,43 +791,113 @@ void cover_merge_tags(fbuf_t *f, cover_tagging_t *tagging)
       if (new.kind == TAG_LAST)
          break;
 
-      // TODO: Could merging be done more efficiently?
-      bool found = false;
-      for (int i = 0; i < tagging->tags.count; i++) {
-         cover_tag_t *old = AREF(tagging->tags, i);
-
-         // Compare based on hierarchical path, each
-         // statement / branch / signal has unique hierarchical name
-         if (new.hier == old->hier) {
-            assert(new.kind == old->kind);
-#ifdef COVER_DEBUG_MERGE
-            printf("Merging coverage tag: %s\n", istr(old->hier));
-#endif
-            switch (new.kind) {
-            case TAG_STMT:
-               old->data += new.data;
-               break;
-            case TAG_TOGGLE:
-            case TAG_BRANCH:
-            case TAG_EXPRESSION:
-               old->data |= new.data;
-               break;
-            default:
-               break;
-            }
-
-            found = true;
-            break;
-         }
-      }
+      const uintptr_t pos = (uintptr_t)hash_get(index, new.hier);
 
       // TODO: Append the new tag just before popping hierarchy tag
       //       with longest common prefix of new tag. That will allow to
       //       merge coverage of IPs from different configurations of
       //       generics which form hierarchy differently!
-      if (!found)
+      if (pos == 0) {
          warnf("Dropping coverage tag: %s\n", istr(new.hier));
+         continue;
+      }
+
+      const cover_tag_t *old = AREF(tagging->tags, pos - 1);
+      assert(new.kind == old->kind);
+#ifdef COVER_DEBUG_MERGE
+      printf("Merging coverage tag: %s\n", istr(old->hier));
+#endif
+      cover_merge_data(new.kind, &(data[pos - 1]), new.data);
    }
+
+   ident_read_end(ident_ctx);
+   loc_read_end(loc_rd);
+}
+
+static void cover_merge_files_task(void *context, void *arg)
+{
+   merge_ctx_t *ctx = context;
+   merge_job_t *job = arg;
+
+   // Files are handed out one at a time so that workers which finish
+   // early pick up the remaining databases
+   int next;
+   while ((next = atomic_fetch_add(&ctx->next, 1)) < ctx->nfiles) {
+      const char *fname = ctx->files[next];
+      fbuf_t *f = fbuf_open(fname, FBUF_IN, FBUF_CS_NONE);
+      if (f == NULL)
+         fatal("Could not open coverage database: %s", fname);
+
+      cover_merge_one_file(f, ctx->tagging, ctx->index, job->data);
+
+      fbuf_close(f, NULL);
+   }
+}
+
+static void cover_reduce_task(void *context, void *arg)
+{
+   merge_ctx_t *ctx = context;
+   merge_job_t *job = arg;
+
+   for (int i = 0; i < ctx->tagging->tags.count; i++) {
+      const tag_kind_t kind = ctx->tagging->tags.items[i].kind;
+      cover_merge_data(kind, &(job->data[i]), job->peer->data[i]);
+   }
+
+   free(job->peer->data);
+   job->peer->data = NULL;
+}
+
+void cover_merge_files(cover_tagging_t *tagging, const char **files,
+                       int nfiles)
+{
+   assert(tagging != NULL);
+
+   if (nfiles == 0)
+      return;
+
+   merge_ctx_t ctx = {
+      .tagging = tagging,
+      .index   = cover_build_index(tagging),
+      .files   = files,
+      .nfiles  = nfiles,
+   };
+
+   // Each job accumulates into a private array indexed by the position
+   // of the tag in the first database and these are then combined
+   // pairwise to avoid any synchronisation on the tag data
+   const int njobs = MIN(nfiles, nvc_nprocs());
+   merge_job_t *jobs = xcalloc_array(njobs, sizeof(merge_job_t));
+
+   workq_t *wq = workq_new(&ctx);
+
+   for (int i = 0; i < njobs; i++) {
+      jobs[i].data = xcalloc_array(tagging->tags.count, sizeof(int32_t));
+      workq_do(wq, cover_merge_files_task, &(jobs[i]));
+   }
+
+   workq_start(wq);
+   workq_drain(wq);
+
+   for (int stride = 1; stride < njobs; stride *= 2) {
+      for (int i = 0; i + stride < njobs; i += 2 * stride) {
+         jobs[i].peer = &(jobs[i + stride]);
+         workq_do(wq, cover_reduce_task, &(jobs[i]));
+      }
+
+      workq_start(wq);
+      workq_drain(wq);
+   }
+
+   for (int i = 0; i < tagging->tags.count; i++) {
+      cover_tag_t *tag = &(tagging->tags.items[i]);
+      cover_merge_data(tag->kind, &(tag->data), jobs[0].data[i]);
+   }
+
+   workq_free(wq);
+   hash_free(ctx.index);
+   free(jobs[0].data);
+   free(jobs);
 }
 
 void cover_count_tags(cover_tagging_t *tagging, int32_t *n_stmts,
@@ -952,19 +1076,56 @@ static inline void cover_toggle_check_0_1_u_z(uint8_t old, uint8_t new,
 #endif
 
 
+static inline int cover_next_toggle(const uint8_t *old, const uint8_t *new,
+                                    int pos, int end)
+{
+   // A toggle requires the value to change so skip over runs of
+   // unchanged bytes a word at a time
+#ifdef __SSE2__
+   for (; pos + 16 <= end; pos += 16) {
+      const __m128i a = _mm_loadu_si128((const __m128i *)(old + pos));
+      const __m128i b = _mm_loadu_si128((const __m128i *)(new + pos));
+      const unsigned neq = _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) ^ 0xffff;
+      if (neq != 0)
+         return pos + __builtin_ctz(neq);
+   }
+#endif
+
+   for (; pos + 8 <= end; pos += 8) {
+      uint64_t a, b;
+      memcpy(&a, old + pos, sizeof(uint64_t));
+      memcpy(&b, new + pos, sizeof(uint64_t));
+      if (a != b)
+         break;
+   }
+
+   for (; pos < end; pos++) {
+      if (old[pos] != new[pos])
+         return pos;
+   }
+
+   return end;
+}
+
+// Only nexuses with an event in this cycle are scanned: the toggle
+// bits are sticky so revisiting an older change would have no effect
 #define DEFINE_COVER_TOGGLE_CB(name, check_fnc)                               \
    static void name(uint64_t now, rt_signal_t *s, rt_watch_t *w, void *user)  \
    {                                                                          \
-      uint32_t s_size = s->shared.size;                                       \
+      const uint8_t *new = signal_value(s);                                   \
+      const uint8_t *old = signal_last_value(s);                              \
       int32_t *toggle_mask = ((int32_t *)user);                               \
       COVER_TGL_CB_MSG(s)                                                     \
-      for (int i = 0; i < s_size; i++) {                                      \
-         uint8_t new = ((uint8_t*)signal_value(s))[i];                        \
-         uint8_t old = ((uint8_t*)signal_last_value(s))[i];                   \
-         check_fnc(old, new, toggle_mask);                                    \
-         toggle_mask++;                                                       \
+      rt_nexus_t *n = &(s->nexus);                                            \
+      for (unsigned i = 0; i < s->n_nexus; i++, n = n->chain) {               \
+         if (n->last_event != now)                                            \
+            continue;                                                         \
+         const int end = n->offset + n->width * n->size;                      \
+         for (int pos = cover_next_toggle(old, new, n->offset, end);          \
+              pos < end; pos = cover_next_toggle(old, new, pos + 1, end))     \
+            check_fnc(old[pos], new[pos], &(toggle_mask[pos]));               \
       }                                                                       \
-      COVER_TGL_SIGNAL_DETAILS(s, s_size)                                     \
+      COVER_TGL_SIGNAL_DETAILS(s, s->shared.size)                             \
    }                                                                          \
 
 
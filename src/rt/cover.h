@@ -130,6 +130,7 @@ typedef enum {
    COV_FLAG_TOGGLE_SIGNAL  = (1 << 17),
    COV_FLAG_TOGGLE_PORT    = (1 << 18),
    COV_FLAG_CONST_DRIVEN   = (1 << 19),
+   COV_FLAG_HIT_ONCE       = (1 << 20),
    COV_FLAG_EXPR_STD_LOGIC = (1 << 24)
 } cover_flags_t;
 
@@ -156,6 +157,7 @@ typedef enum {
    COVER_MASK_TOGGLE_COUNT_FROM_TO_Z      = (1 << 9),
    COVER_MASK_TOGGLE_INCLUDE_MEMS         = (1 << 10),
    COVER_MASK_EXCLUDE_UNREACHABLE         = (1 << 11),
+   COVER_MASK_STMT_HIT_ONCE               = (1 << 12),
    COVER_MASK_DONT_PRINT_COVERED          = (1 << 16),
    COVER_MASK_DONT_PRINT_UNCOVERED        = (1 << 17),
    COVER_MASK_DONT_PRINT_EXCLUDED         = (1 << 18)
@@ -200,6 +202,7 @@ void cover_dump_tags(cover_tagging_t *ctx, fbuf_t *f, cover_dump_t dt,
 
 cover_tagging_t *cover_read_tags(fbuf_t *f, uint32_t pre_mask);
 
-void cover_merge_tags(fbuf_t *f, cover_tagging_t *tagging);
+void cover_merge_files(cover_tagging_t *tagging, const char **files,
+                       int nfiles);
 
 #endif  // _COVER_H
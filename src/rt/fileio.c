@@ -235,6 +235,167 @@ int8_t __nvc_file_canseek(FILE **fp)
    return fseek(*fp, 0, SEEK_CUR) == 0;
 }
 
+#ifdef __MINGW32__
+#define getc_unlocked _getc_nolock
+#define putc_unlocked _putc_nolock
+#define flockfile _lock_file
+#define funlockfile _unlock_file
+#endif
+
+static inline bool textio_is_whitespace(uint8_t ch)
+{
+   return ch == ' ' || ch == '\r' || ch == '\n' || ch == '\t' || ch == 160;
+}
+
+static int64_t textio_skip_whitespace(const uint8_t *str, int64_t len)
+{
+   int64_t pos = 0;
+   while (pos < len && textio_is_whitespace(str[pos]))
+      pos++;
+   return pos;
+}
+
+static int textio_digit(uint8_t ch, int log_base)
+{
+   int digit;
+   if (ch >= '0' && ch <= '9')
+      digit = ch - '0';
+   else if (ch >= 'a' && ch <= 'f')
+      digit = ch - 'a' + 10;
+   else if (ch >= 'A' && ch <= 'F')
+      digit = ch - 'A' + 10;
+   else
+      return -1;
+
+   return digit < (1 << log_base) ? digit : -1;
+}
+
+DLLEXPORT
+void _std_textio_readline(FILE **fp, ffi_uarray_t *u)
+{
+   if (*fp == NULL)
+      jit_msg(NULL, DIAG_FATAL, "READLINE called on closed file");
+
+   static __thread char *buf = NULL;
+   static __thread size_t bufsz = 0;
+
+   size_t len = 0;
+   int ch;
+
+   flockfile(*fp);
+
+   while ((ch = getc_unlocked(*fp)) != EOF && ch != '\n') {
+      if (ch == '\r')
+         continue;
+      else if (len == bufsz) {
+         bufsz = MAX(bufsz * 2, 256);
+         buf = xrealloc(buf, bufsz);
+      }
+
+      buf[len++] = ch;
+   }
+
+   funlockfile(*fp);
+
+   char *line = jit_mspace_alloc_noscan(MAX(len, 1));
+   memcpy(line, buf, len);
+
+   *u = ffi_wrap(line, 1, len);
+}
+
+DLLEXPORT
+void _std_textio_writeline(FILE **fp, const uint8_t *ptr, int64_t len)
+{
+   if (*fp == NULL)
+      jit_msg(NULL, DIAG_FATAL, "WRITELINE called on closed file");
+
+   flockfile(*fp);
+   fwrite(ptr, 1, len, *fp);
+   putc_unlocked('\n', *fp);
+   funlockfile(*fp);
+}
+
+DLLEXPORT
+void _std_textio_read_integer(const uint8_t *ptr, int64_t len, int32_t *value,
+                              int8_t *good, int32_t *used)
+{
+   int64_t pos = textio_skip_whitespace(ptr, len);
+   const int64_t start = pos;
+
+   const bool negative = pos < len && ptr[pos] == '-';
+   if (pos < len && (ptr[pos] == '-' || ptr[pos] == '+'))
+      pos++;
+
+   const int64_t first_digit = pos;
+   int64_t result = 0;
+   for (; pos < len && ptr[pos] >= '0' && ptr[pos] <= '9'; pos++) {
+      result = result * 10 + (ptr[pos] - '0');
+      if (result > (int64_t)INT32_MAX + negative)
+         break;
+   }
+
+   *value = 0;
+   *good  = 0;
+
+   if (pos == first_digit && (negative || first_digit == start))
+      *used = start;   // A sign without any digits is not good
+   else if (pos < len && ptr[pos] >= '0' && ptr[pos] <= '9')
+      *used = start;   // Overflow
+   else {
+      *value = negative ? -result : result;
+      *good  = 1;
+      *used  = pos;
+   }
+}
+
+DLLEXPORT
+void _std_textio_read_bits(const uint8_t *ptr, int64_t len, uint8_t *value,
+                           int64_t value_len, int32_t log_base, int8_t *good,
+                           int32_t *used)
+{
+   // Reads a bit vector written in octal or hexadecimal with the same
+   // rules as the original VHDL implementation of OREAD and HREAD
+
+   const int64_t ndigits = (value_len + log_base - 1) / log_base;
+   uint8_t *digits LOCAL = xmalloc(MAX(ndigits, 1));
+
+   memset(value, 0, value_len);
+   *good = 0;
+
+   int64_t ipos = textio_skip_whitespace(ptr, len), opos = 0;
+   bool underscore = false;
+   while (ipos < len && opos < ndigits) {
+      const uint8_t ch = ptr[ipos++];
+      const int digit = textio_digit(ch, log_base);
+      if (ch == '_' && underscore)
+         underscore = false;
+      else if (digit >= 0) {
+         digits[opos++] = digit;
+         underscore = true;
+      }
+      else
+         break;
+   }
+
+   *used = ipos;
+
+   if (opos != ndigits)
+      return;
+
+   const int remainder = value_len % log_base;
+   uint8_t *out = value;
+   for (int64_t i = 0; i < ndigits; i++) {
+      const int nbits = (i == 0 && remainder != 0) ? remainder : log_base;
+      for (int j = nbits - 1; j >= 0; j--)
+         *out++ = (digits[i] >> j) & 1;
+
+      if (digits[i] >> nbits)
+         return;   // Value does not fit
+   }
+
+   *good = 1;
+}
+
 void _file_io_init(void)
 {
    // Dummy function to force linking
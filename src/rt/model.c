@@ -54,6 +54,12 @@ typedef enum {
    EVENT_DISCONNECT,
 } event_kind_t;
 
+typedef enum {
+   LOOKUP_SIGNAL,
+   LOOKUP_PROC,
+   LOOKUP_SCOPE,
+} lookup_tag_t;
+
 #define MEMBLOCK_LINE_SZ 64
 #define MEMBLOCK_PAGE_SZ 0x800000
 
@@ -106,11 +112,12 @@ typedef struct _rt_model {
    ptr_list_t         eventsigs;
 } rt_model_t;
 
-#define FMT_VALUES_SZ   128
-#define NEXUS_INDEX_MIN 8
-#define TRACE_SIGNALS   1
-#define WAVEFORM_CHUNK  256
-#define PENDING_MIN     4
+#define FMT_VALUES_SZ    128
+#define NEXUS_INDEX_MIN  8
+#define TRACE_SIGNALS    1
+#define WAVEFORM_CHUNK   256
+#define PENDING_MIN      4
+#define SCOPE_LOOKUP_MIN 16
 
 #define TRACE(...) do {                                 \
       if (unlikely(__trace_on))                         \
@@ -150,6 +157,8 @@ static void async_fast_driver(void *context, void *arg);
 static void async_fast_all_drivers(void *context, void *arg);
 static void async_update_driving(void *context, void *arg);
 static void async_disconnect(void *context, void *arg);
+static void flush_inline_driver(rt_model_t *m, rt_signal_t *s);
+static void flush_process_inline_drivers(rt_model_t *m, rt_proc_t *proc);
 
 static int fmt_time_r(char *buf, size_t len, int64_t t, const char *sep)
 {
@@ -617,6 +626,12 @@ static void free_waveform(rt_model_t *m, waveform_t *w)
    thread->free_waveforms = w;
 }
 
+static void free_pending(void *pending)
+{
+   if (pending != NULL && pointer_tag(pending) == 0)
+      free(pending);
+}
+
 static void cleanup_nexus(rt_model_t *m, rt_nexus_t *n)
 {
    for (rt_source_t *s = &(n->sources), *tmp; s; s = tmp) {
@@ -645,8 +660,15 @@ static void cleanup_nexus(rt_model_t *m, rt_nexus_t *n)
    }
 
 
-   if (n->pending != NULL && pointer_tag(n->pending) == 0)
-      free(n->pending);
+   if (pointer_tag(n->pending) == 2) {
+      rt_edge_list_t *e = untag_pointer(n->pending, rt_edge_list_t);
+      free_pending(e->pending);
+      for (int i = 0; i < e->count; i++)
+         free_pending(e->edges[i].pending);
+      free(e);
+   }
+   else
+      free_pending(n->pending);
 }
 
 static void cleanup_signal(rt_model_t *m, rt_signal_t *s)
@@ -665,6 +687,7 @@ static void cleanup_scope(rt_model_t *m, rt_scope_t *scope)
    list_foreach(rt_proc_t *, it, scope->procs) {
       mptr_free(m->mspace, &(it->privdata));
       tlab_release(&(it->tlab));
+      list_free(&(it->inlinesigs));
       free(it);
    }
    list_free(&scope->procs);
@@ -691,6 +714,9 @@ static void cleanup_scope(rt_model_t *m, rt_scope_t *scope)
    }
    list_free(&scope->children);
 
+   if (scope->lookup != NULL)
+      hash_free(scope->lookup);
+
    mptr_free(m->mspace, &(scope->privdata));
    free(scope);
 }
@@ -760,8 +786,79 @@ void model_free(rt_model_t *m)
    free(m);
 }
 
+static hash_t *scope_lookup_table(rt_scope_t *scope)
+{
+   // Small scopes are cheaper to search linearly
+   const unsigned count = list_size(scope->signals)
+      + list_size(scope->aliases) + list_size(scope->procs)
+      + list_size(scope->children);
+   if (count < SCOPE_LOOKUP_MIN)
+      return NULL;
+   else if (scope->lookup != NULL && scope->nlookup == count)
+      return scope->lookup;
+
+   // Rebuild the index if objects were added since it was created
+   if (scope->lookup != NULL)
+      hash_free(scope->lookup);
+
+   scope->lookup  = hash_new(count * 2);
+   scope->nlookup = count;
+
+   // Keep the first entry for each tree to match the linear search
+#define SCOPE_LOOKUP_ADD(where, obj, tag) do {                          \
+      if (hash_get(scope->lookup, (where)) == NULL)                     \
+         hash_put(scope->lookup, (where), tag_pointer((obj), (tag)));   \
+   } while (0)
+
+   list_foreach(rt_signal_t *, s, scope->signals)
+      SCOPE_LOOKUP_ADD(s->where, s, LOOKUP_SIGNAL);
+
+   list_foreach(rt_alias_t *, a, scope->aliases)
+      SCOPE_LOOKUP_ADD(a->where, a->signal, LOOKUP_SIGNAL);
+
+   list_foreach(rt_proc_t *, p, scope->procs)
+      SCOPE_LOOKUP_ADD(p->where, p, LOOKUP_PROC);
+
+   list_foreach(rt_scope_t *, s, scope->children)
+      SCOPE_LOOKUP_ADD(s->where, s, LOOKUP_SCOPE);
+
+#undef SCOPE_LOOKUP_ADD
+
+   return scope->lookup;
+}
+
+static void *scope_lookup(rt_scope_t *scope, tree_t where, lookup_tag_t tag,
+                          bool *found)
+{
+   hash_t *h = scope_lookup_table(scope);
+   if (h == NULL) {
+      *found = false;
+      return NULL;
+   }
+
+   void *entry = hash_get(h, where);
+   if (entry == NULL) {
+      *found = true;
+      return NULL;
+   }
+   else if (pointer_tag(entry) == tag) {
+      *found = true;
+      return untag_pointer(entry, void);
+   }
+   else {
+      // Another kind of object has the same tree
+      *found = false;
+      return NULL;
+   }
+}
+
 rt_signal_t *find_signal(rt_scope_t *scope, tree_t decl)
 {
+   bool found;
+   rt_signal_t *s = scope_lookup(scope, decl, LOOKUP_SIGNAL, &found);
+   if (found)
+      return s;
+
    list_foreach(rt_signal_t *, s, scope->signals) {
       if (s->where == decl)
          return s;
@@ -777,6 +874,11 @@ rt_signal_t *find_signal(rt_scope_t *scope, tree_t decl)
 
 rt_proc_t *find_proc(rt_scope_t *scope, tree_t proc)
 {
+   bool found;
+   rt_proc_t *p = scope_lookup(scope, proc, LOOKUP_PROC, &found);
+   if (found)
+      return p;
+
    list_foreach(rt_proc_t *, p, scope->procs) {
       if (p->where == proc)
          return p;
@@ -792,6 +894,11 @@ rt_scope_t *find_scope(rt_model_t *m, tree_t container)
 
 rt_scope_t *child_scope(rt_scope_t *scope, tree_t decl)
 {
+   bool found;
+   rt_scope_t *s = scope_lookup(scope, decl, LOOKUP_SCOPE, &found);
+   if (found)
+      return s;
+
    list_foreach(rt_scope_t *, s, scope->children) {
       if (s->where == decl)
          return s;
@@ -810,6 +917,16 @@ const void *signal_last_value(rt_signal_t *s)
    return s->shared.data + s->shared.size;
 }
 
+size_t signal_width(rt_signal_t *s)
+{
+   return s->shared.size / s->nexus.size;
+}
+
+size_t signal_size(rt_signal_t *s)
+{
+   return s->shared.size;
+}
+
 size_t signal_expand(rt_signal_t *s, uint64_t *buf, size_t max)
 {
    const size_t total = s->shared.size / s->nexus.size;
@@ -996,6 +1113,10 @@ static void run_process(rt_model_t *m, rt_proc_t *proc)
    if (!jit_fastcall(m->jit, proc->handle, &result, state, context, tlab))
       m->force_stop = true;
 
+   // Schedule any driver updates made directly by the generated code
+   if (proc->inlinesigs != NULL)
+      flush_process_inline_drivers(m, proc);
+
    thread->active_obj = NULL;
    thread->active_scope = NULL;
 
@@ -1234,8 +1355,10 @@ static rt_source_t *add_source(rt_model_t *m, rt_nexus_t *n, source_kind_t kind)
    if (n->n_sources < UINT8_MAX)
       n->n_sources++;
 
-   if (n->n_sources > 1)
+   if (n->n_sources > 1) {
       n->flags &= ~NET_F_FAST_DRIVER;
+      n->signal->shared.flags &= ~SIG_F_INLINE_DRV;
+   }
 
    src->chain_input  = NULL;
    src->chain_output = NULL;
@@ -1525,6 +1648,9 @@ static rt_nexus_t *clone_nexus(rt_model_t *m, rt_nexus_t *old, int offset)
    old->chain = new;
    old->width = offset;
 
+   // Edge lists are only created for single element nexuses
+   assert(pointer_tag(old->pending) != 2);
+
    if (old->pending == NULL)
       new->pending = NULL;
    else if (pointer_tag(old->pending) == 1)
@@ -2176,6 +2302,26 @@ static void check_undriven_std_logic(rt_nexus_t *n)
    n->signal->shared.flags &= ~SIG_F_STD_LOGIC;
 }
 
+static void enable_inline_driver(rt_nexus_t *n)
+{
+   // Zero-delay assignments to a scalar signal with a single fast
+   // driver may write the driver value directly from generated code
+   rt_signal_t *s = n->signal;
+   if (s->n_nexus != 1 || n->width != 1 || n->n_sources != 1)
+      return;
+   else if (!(n->flags & NET_F_FAST_DRIVER) || n->sources.tag != SOURCE_DRIVER)
+      return;
+   else if (s->shared.flags & SIG_F_IMPLICIT)
+      return;
+
+   rt_proc_t *proc = n->sources.u.driver.proc;
+   if (proc == NULL || proc->wakeable.postponed)
+      return;
+
+   s->shared.flags |= SIG_F_INLINE_DRV;
+   list_add(&proc->inlinesigs, s);
+}
+
 void model_reset(rt_model_t *m)
 {
    MODEL_ENTRY(m);
@@ -2210,6 +2356,8 @@ void model_reset(rt_model_t *m)
                copy_value_ptr(n, &(s->u.driver.waveforms.value),
                               nexus_effective(n));
          }
+
+         enable_inline_driver(n);
       }
 
       heap_insert(q, nexus_rank(n), n);
@@ -2298,22 +2446,22 @@ static void update_property(rt_model_t *m, rt_prop_t *prop)
    mask_copy(&prop->state, &prop->newstate);
 }
 
-static void sched_event(rt_model_t *m, rt_nexus_t *n, rt_wakeable_t *obj)
+static void add_pending(void **where, rt_wakeable_t *obj)
 {
-   if (n->pending == NULL)
-      n->pending = tag_pointer(obj, 1);
-   else if (pointer_tag(n->pending) == 1) {
+   if (*where == NULL)
+      *where = tag_pointer(obj, 1);
+   else if (pointer_tag(*where) == 1) {
       rt_pending_t *p = xmalloc_flex(sizeof(rt_pending_t), PENDING_MIN,
                                      sizeof(rt_wakeable_t *));
       p->max = PENDING_MIN;
       p->count = 2;
-      p->wake[0] = untag_pointer(n->pending, rt_wakeable_t);
+      p->wake[0] = untag_pointer(*where, rt_wakeable_t);
       p->wake[1] = obj;
 
-      n->pending = tag_pointer(p, 0);
+      *where = tag_pointer(p, 0);
    }
    else {
-      rt_pending_t *p = untag_pointer(n->pending, rt_pending_t);
+      rt_pending_t *p = untag_pointer(*where, rt_pending_t);
 
       for (int i = 0; i < p->count; i++) {
          if (p->wake[i] == NULL || p->wake[i] == obj) {
@@ -2326,22 +2474,22 @@ static void sched_event(rt_model_t *m, rt_nexus_t *n, rt_wakeable_t *obj)
          p->max = MAX(PENDING_MIN, p->max * 2);
          p = xrealloc_flex(p, sizeof(rt_pending_t), p->max,
                            sizeof(rt_wakeable_t *));
-         n->pending = tag_pointer(p, 0);
+         *where = tag_pointer(p, 0);
       }
 
       p->wake[p->count++] = obj;
    }
 }
 
-static void clear_event(rt_model_t *m, rt_nexus_t *n, rt_wakeable_t *obj)
+static void remove_pending(void **where, rt_wakeable_t *obj)
 {
-   if (pointer_tag(n->pending) == 1) {
-      rt_wakeable_t *wake = untag_pointer(n->pending, rt_wakeable_t);
+   if (pointer_tag(*where) == 1) {
+      rt_wakeable_t *wake = untag_pointer(*where, rt_wakeable_t);
       if (wake == obj)
-         n->pending = NULL;
+         *where = NULL;
    }
-   else if (n->pending != NULL) {
-      rt_pending_t *p = untag_pointer(n->pending, rt_pending_t);
+   else if (*where != NULL) {
+      rt_pending_t *p = untag_pointer(*where, rt_pending_t);
       for (int i = 0; i < p->count; i++) {
          if (p->wake[i] == obj) {
             p->wake[i] = NULL;
@@ -2351,6 +2499,64 @@ static void clear_event(rt_model_t *m, rt_nexus_t *n, rt_wakeable_t *obj)
    }
 }
 
+static void sched_event(rt_model_t *m, rt_nexus_t *n, rt_wakeable_t *obj,
+                        uint64_t mask)
+{
+   if (mask == UINT64_MAX && pointer_tag(n->pending) == 2) {
+      rt_edge_list_t *e = untag_pointer(n->pending, rt_edge_list_t);
+      add_pending(&(e->pending), obj);
+      return;
+   }
+   else if (mask == UINT64_MAX) {
+      add_pending(&(n->pending), obj);
+      return;
+   }
+
+   // Wakeables that only care about some values of the signal are kept
+   // in separate lists grouped by mask so that notify_event can skip
+   // them entirely on the other edge
+   assert(n->width == 1 && n->size == 1);
+
+   rt_edge_list_t *e;
+   if (pointer_tag(n->pending) == 2)
+      e = untag_pointer(n->pending, rt_edge_list_t);
+   else {
+      e = xmalloc_flex(sizeof(rt_edge_list_t), 1, sizeof(rt_edge_t));
+      e->pending = n->pending;
+      e->count = 0;
+   }
+
+   for (int i = 0; i < e->count; i++) {
+      if (e->edges[i].mask == mask) {
+         add_pending(&(e->edges[i].pending), obj);
+         return;
+      }
+   }
+
+   if (e->count > 0)
+      e = xrealloc_flex(e, sizeof(rt_edge_list_t), e->count + 1,
+                        sizeof(rt_edge_t));
+
+   rt_edge_t *edge = &(e->edges[e->count++]);
+   edge->mask = mask;
+   edge->pending = NULL;
+   add_pending(&(edge->pending), obj);
+
+   n->pending = tag_pointer(e, 2);
+}
+
+static void clear_event(rt_model_t *m, rt_nexus_t *n, rt_wakeable_t *obj)
+{
+   if (pointer_tag(n->pending) == 2) {
+      rt_edge_list_t *e = untag_pointer(n->pending, rt_edge_list_t);
+      remove_pending(&(e->pending), obj);
+      for (int i = 0; i < e->count; i++)
+         remove_pending(&(e->edges[i].pending), obj);
+   }
+   else
+      remove_pending(&(n->pending), obj);
+}
+
 static rt_source_t *find_driver(rt_nexus_t *nexus, rt_proc_t *proc)
 {
    // Try to find this process in the list of existing drivers
@@ -2403,38 +2609,81 @@ static inline bool insert_transaction(rt_model_t *m, rt_nexus_t *nexus,
    return already_scheduled;
 }
 
-static void sched_driver(rt_model_t *m, rt_nexus_t *nexus, uint64_t after,
-                         uint64_t reject, const void *value, rt_proc_t *proc)
+static waveform_t *sched_fast_driver(rt_model_t *m, rt_nexus_t *nexus)
 {
-   if (after == 0 && (nexus->flags & NET_F_FAST_DRIVER)) {
-      rt_source_t *d = &(nexus->sources);
-      assert(nexus->n_sources == 1);
+   rt_source_t *d = &(nexus->sources);
+   assert(nexus->n_sources == 1);
 
-      waveform_t *w = &d->u.driver.waveforms;
-      w->when = m->now;
-      assert(w->next == NULL);
+   waveform_t *w = &d->u.driver.waveforms;
+   w->when = m->now;
+   assert(w->next == NULL);
 
-      rt_signal_t *signal = nexus->signal;
-      rt_source_t *d0 = &(signal->nexus.sources);
+   rt_signal_t *signal = nexus->signal;
+   rt_source_t *d0 = &(signal->nexus.sources);
 
-      if (d->fastqueued)
-         assert(m->next_is_delta);
-      else if ((signal->shared.flags & NET_F_FAST_DRIVER) && d0->sigqueued) {
-         assert(m->next_is_delta);
-         d->fastqueued = 1;
-      }
-      else if (signal->shared.flags & NET_F_FAST_DRIVER) {
-         workq_do(m->delta_driverq, async_fast_all_drivers, signal);
-         m->next_is_delta = true;
-         d0->sigqueued = 1;
-         d->fastqueued = 1;
-      }
-      else {
-         workq_do(m->delta_driverq, async_fast_driver, d);
-         m->next_is_delta = true;
-         d->fastqueued = 1;
-      }
+   if (d->fastqueued)
+      assert(m->next_is_delta);
+   else if ((signal->shared.flags & NET_F_FAST_DRIVER) && d0->sigqueued) {
+      assert(m->next_is_delta);
+      d->fastqueued = 1;
+   }
+   else if (signal->shared.flags & NET_F_FAST_DRIVER) {
+      workq_do(m->delta_driverq, async_fast_all_drivers, signal);
+      m->next_is_delta = true;
+      d0->sigqueued = 1;
+      d->fastqueued = 1;
+   }
+   else {
+      workq_do(m->delta_driverq, async_fast_driver, d);
+      m->next_is_delta = true;
+      d->fastqueued = 1;
+   }
+
+   return w;
+}
+
+static void flush_inline_driver(rt_model_t *m, rt_signal_t *s)
+{
+   // Generated code has already written the new value into the driver
+   // waveform but the update has not yet been scheduled
+   assert(s->shared.flags & SIG_F_INLINE_DRV);
+   s->shared.flags &= ~SIG_F_INLINE_PEND;
+
+   sched_fast_driver(m, &(s->nexus));
+}
 
+static inline void sync_inline_driver(rt_model_t *m, rt_signal_t *s)
+{
+   if (unlikely(s->shared.flags & SIG_F_INLINE_PEND))
+      flush_inline_driver(m, s);
+}
+
+static void flush_process_inline_drivers(rt_model_t *m, rt_proc_t *proc)
+{
+   // Signals that acquired another driver or a delayed assignment are
+   // never written inline again so drop them from the list and stop
+   // checking once it is empty
+   unsigned wptr = 0;
+   for (unsigned i = 0; i < proc->inlinesigs->count; i++) {
+      rt_signal_t *s = proc->inlinesigs->items[i];
+      if (s->shared.flags & SIG_F_INLINE_PEND)
+         flush_inline_driver(m, s);
+
+      if (s->shared.flags & SIG_F_INLINE_DRV)
+         proc->inlinesigs->items[wptr++] = s;
+   }
+
+   if (wptr == 0)
+      list_free(&(proc->inlinesigs));
+   else
+      proc->inlinesigs->count = wptr;
+}
+
+static void sched_driver(rt_model_t *m, rt_nexus_t *nexus, uint64_t after,
+                         uint64_t reject, const void *value, rt_proc_t *proc)
+{
+   if (after == 0 && (nexus->flags & NET_F_FAST_DRIVER)) {
+      waveform_t *w = sched_fast_driver(m, nexus);
       copy_value_ptr(nexus, &w->value, value);
    }
    else {
@@ -2456,6 +2705,7 @@ static void sched_driver(rt_model_t *m, rt_nexus_t *nexus, uint64_t after,
       }
 
       nexus->flags &= ~NET_F_FAST_DRIVER;
+      nexus->signal->shared.flags &= ~SIG_F_INLINE_DRV;
 
       waveform_t *w = alloc_waveform(m);
       w->when  = m->now + after;
@@ -2602,16 +2852,14 @@ static void wakeup_one(rt_model_t *m, rt_wakeable_t *obj)
    set_pending(obj);
 }
 
-static void notify_event(rt_model_t *m, rt_nexus_t *nexus)
+static void wakeup_pending(rt_model_t *m, void *pending)
 {
-   nexus->last_event = m->now;
-
-   if (pointer_tag(nexus->pending) == 1) {
-      rt_wakeable_t *wake = untag_pointer(nexus->pending, rt_wakeable_t);
+   if (pointer_tag(pending) == 1) {
+      rt_wakeable_t *wake = untag_pointer(pending, rt_wakeable_t);
       wakeup_one(m, wake);
    }
-   else if (nexus->pending != NULL) {
-      rt_pending_t *p = untag_pointer(nexus->pending, rt_pending_t);
+   else if (pending != NULL) {
+      rt_pending_t *p = untag_pointer(pending, rt_pending_t);
       for (int i = 0; i < p->count; i++) {
          if (p->wake[i] != NULL)
             wakeup_one(m, p->wake[i]);
@@ -2619,6 +2867,26 @@ static void notify_event(rt_model_t *m, rt_nexus_t *nexus)
    }
 }
 
+static void notify_event(rt_model_t *m, rt_nexus_t *nexus)
+{
+   nexus->last_event = m->now;
+
+   if (pointer_tag(nexus->pending) == 2) {
+      rt_edge_list_t *e = untag_pointer(nexus->pending, rt_edge_list_t);
+      wakeup_pending(m, e->pending);
+
+      const uint8_t value = *(uint8_t *)nexus_effective(nexus);
+      const uint64_t bit = value < 64 ? UINT64_C(1) << value : 0;
+
+      for (int i = 0; i < e->count; i++) {
+         if (e->edges[i].mask & bit)
+            wakeup_pending(m, e->edges[i].pending);
+      }
+   }
+   else
+      wakeup_pending(m, nexus->pending);
+}
+
 static void update_effective(rt_model_t *m, rt_nexus_t *nexus)
 {
    const void *value = effective_value(nexus);
@@ -3067,6 +3335,37 @@ static inline void check_delay(int64_t delay)
    }
 }
 
+bool force_signal_raw(rt_signal_t *s, const void *buf, size_t size)
+{
+   RT_LOCK(s->lock);
+
+   TRACE("force signal %s with %zu bytes", istr(tree_ident(s->where)), size);
+
+   rt_model_t *m = get_model();
+   assert(m->can_create_delta);
+
+   if (size != s->shared.size)
+      return false;
+
+   // Values are stored in the same layout as the signal so each nexus
+   // can be copied directly without widening every element
+   const uint8_t *sp = buf;
+   rt_nexus_t *n = &(s->nexus);
+   for (int offset = 0; offset < size; n = n->chain) {
+      n->flags |= NET_F_FORCED;
+
+      rt_source_t *src = get_forcing_source(m, n);
+      const int bytes = n->width * n->size;
+      memcpy(value_ptr(n, &(src->u.forcing)), sp + offset, bytes);
+
+      deltaq_insert_force_release(m, n);
+
+      offset += bytes;
+   }
+
+   return true;
+}
+
 bool force_signal(rt_signal_t *s, const uint64_t *buf, size_t count)
 {
    RT_LOCK(s->lock);
@@ -3176,12 +3475,25 @@ rt_watch_t *model_set_event_cb(rt_model_t *m, rt_signal_t *s, sig_event_fn_t fn,
 
       rt_nexus_t *n = &(w->signal->nexus);
       for (int i = 0; i < s->n_nexus; i++, n = n->chain)
-         sched_event(m, n, &(w->wakeable));
+         sched_event(m, n, &(w->wakeable), UINT64_MAX);
 
       return w;
    }
 }
 
+void model_enable_event_cb(rt_model_t *m, rt_watch_t *w, bool enable)
+{
+   // Removing the watch from the pending lists means a disabled
+   // callback adds no overhead to events on the signal
+   rt_nexus_t *n = &(w->signal->nexus);
+   for (int i = 0; i < w->signal->n_nexus; i++, n = n->chain) {
+      if (enable)
+         sched_event(m, n, &(w->wakeable), UINT64_MAX);
+      else
+         clear_event(m, n, &(w->wakeable));
+   }
+}
+
 static void handle_interrupt_cb(jit_t *j, void *ctx)
 {
    rt_proc_t *proc = get_active_proc();
@@ -3369,6 +3681,8 @@ void x_sched_waveform_s(sig_shared_t *ss, uint32_t offset, uint64_t scalar,
    check_reject_limit(s, after, reject);
 
    rt_model_t *m = get_model();
+   sync_inline_driver(m, s);
+
    rt_nexus_t *n = split_nexus(m, s, offset, 1);
 
    sched_driver(m, n, after, reject, &scalar, proc);
@@ -3391,6 +3705,8 @@ void x_sched_waveform(sig_shared_t *ss, uint32_t offset, void *values,
    check_reject_limit(s, after, reject);
 
    rt_model_t *m = get_model();
+   sync_inline_driver(m, s);
+
    rt_nexus_t *n = split_nexus(m, s, offset, count);
    char *vptr = values;
    for (; count > 0; n = n->chain) {
@@ -3453,20 +3769,25 @@ int32_t x_test_net_active(sig_shared_t *ss, uint32_t offset, int32_t count)
    return 0;
 }
 
-void x_sched_event(sig_shared_t *ss, uint32_t offset, int32_t count)
+void x_sched_event(sig_shared_t *ss, uint32_t offset, int32_t count,
+                   uint64_t mask)
 {
    rt_signal_t *s = container_of(ss, rt_signal_t, shared);
    RT_LOCK(s->lock);
 
-   TRACE("_sched_event %s+%d count=%d", istr(tree_ident(s->where)),
-         offset, count);
+   TRACE("_sched_event %s+%d count=%d mask=%"PRIx64,
+         istr(tree_ident(s->where)), offset, count, mask);
 
    rt_wakeable_t *obj = get_active_wakeable();
 
    rt_model_t *m = get_model();
    rt_nexus_t *n = split_nexus(m, s, offset, count);
+
+   if (count != 1 || n->width != 1 || n->size != 1)
+      mask = UINT64_MAX;   // Only filter events on simple scalars
+
    for (; count > 0; n = n->chain) {
-      sched_event(m, n, obj);
+      sched_event(m, n, obj, mask);
 
       count -= n->width;
       assert(count >= 0);
@@ -3489,7 +3810,7 @@ void x_implicit_event(sig_shared_t *ss, uint32_t offset, int32_t count,
    rt_model_t *m = get_model();
    rt_nexus_t *n = split_nexus(m, s, offset, count);
    for (; count > 0; n = n->chain) {
-      sched_event(m, n, &(wake_s->wakeable));
+      sched_event(m, n, &(wake_s->wakeable), UINT64_MAX);
 
       count -= n->width;
       assert(count >= 0);
@@ -3873,6 +4194,8 @@ void x_disconnect(sig_shared_t *ss, uint32_t offset, int32_t count,
    check_reject_limit(s, after, reject);
 
    rt_model_t *m = get_model();
+   sync_inline_driver(m, s);
+
    rt_nexus_t *n = split_nexus(m, s, offset, count);
    for (; count > 0; n = n->chain) {
       count -= n->width;
@@ -3895,6 +4218,8 @@ void x_force(sig_shared_t *ss, uint32_t offset, int32_t count, void *values)
    check_postponed(0, proc);
 
    rt_model_t *m = get_model();
+   sync_inline_driver(m, s);
+
    rt_nexus_t *n = split_nexus(m, s, offset, count);
    char *vptr = values;
    for (; count > 0; n = n->chain) {
@@ -3923,6 +4248,8 @@ void x_release(sig_shared_t *ss, uint32_t offset, int32_t count)
    check_postponed(0, proc);
 
    rt_model_t *m = get_model();
+   sync_inline_driver(m, s);
+
    rt_nexus_t *n = split_nexus(m, s, offset, count);
    for (; count > 0; n = n->chain) {
       count -= n->width;
@@ -35,6 +35,7 @@ void model_set_global_cb(rt_model_t *m, rt_event_t event, rt_event_fn_t fn,
                          void *user);
 rt_watch_t *model_set_event_cb(rt_model_t *m, rt_signal_t *s, sig_event_fn_t fn,
                                void *user, bool postponed);
+void model_enable_event_cb(rt_model_t *m, rt_watch_t *w, bool enable);
 void model_set_timeout_cb(rt_model_t *m, uint64_t when, rt_event_fn_t fn,
                           void *user);
 
@@ -50,8 +51,11 @@ rt_proc_t *find_proc(rt_scope_t *scope, tree_t proc);
 
 const void *signal_value(rt_signal_t *s);
 const void *signal_last_value(rt_signal_t *s);
+size_t signal_width(rt_signal_t *s);
+size_t signal_size(rt_signal_t *s);
 size_t signal_expand(rt_signal_t *s, uint64_t *buf, size_t max);
 size_t signal_string(rt_signal_t *s, const char *map, char *buf, size_t max);
 bool force_signal(rt_signal_t *s, const uint64_t *buf, size_t count);
+bool force_signal_raw(rt_signal_t *s, const void *buf, size_t size);
 
 #endif  // _RT_MODEL_H
@@ -29,6 +29,10 @@
 #include <stdio.h>
 #include <string.h>
 
+#ifndef __MINGW32__
+#include <unistd.h>
+#endif
+
 #if __SANITIZE_ADDRESS__
 #include <sanitizer/asan_interface.h>
 
@@ -39,8 +43,18 @@
 #define MSPACE_UNPOISON(addr, size)
 #endif
 
-#define LINE_SIZE  32
-#define LINE_WORDS (LINE_SIZE / sizeof(intptr_t))
+#define LINE_SIZE      32
+#define LINE_WORDS     (LINE_SIZE / sizeof(intptr_t))
+#define MARK_BATCH     64
+#define PARALLEL_LINES 0x10000
+
+// Minor collections rely on write-protecting pages holding old objects
+// to find pointers from the old to the young generation: this is only
+// enabled with --gc-generational as system calls that write into a
+// protected page fail with EFAULT rather than faulting
+#if !defined __MINGW32__ && !__SANITIZE_ADDRESS__
+#define GENERATIONAL 1
+#endif
 
 typedef A(uint64_t)     work_list_t;
 
@@ -54,10 +68,20 @@ struct _mptr {
 };
 
 typedef struct {
-   bit_mask_t  markmask;
-   work_list_t worklist;
+   mspace_t    *mspace;
+   bit_mask_t   markmask;
+   bool         minor;
+   bool         parallel;
+   nvc_lock_t   lock;
+   work_list_t  shared;
+   int          active;
 } gc_state_t;
 
+typedef struct {
+   gc_state_t  *state;
+   work_list_t  worklist;
+} gc_marker_t;
+
 typedef struct _free_list free_list_t;
 
 struct _free_list {
@@ -76,9 +100,24 @@ struct _mspace {
    mptr_t           free_mptrs;
    mspace_oom_fn_t  oomfn;
    free_list_t     *free_list;
+   bit_mask_t       oldmask;
+   bit_mask_t       noscanmask;
+   unsigned         old_lines;
+   unsigned         new_lines;
+   unsigned         major_limit;
+   unsigned         skip_minor;
+   unsigned         minor_backoff;
    uint64_t         create_us;
    unsigned         total_gc;
    unsigned         num_cycles;
+   unsigned         num_minor;
+#ifdef GENERATIONAL
+   bool             generational;
+   size_t           cardsize;
+   unsigned         ncards;
+   bit_mask_t       protmask;
+   bit_mask_t       dirtymask;
+#endif
 #ifdef DEBUG
    bool             stress;
 #endif
@@ -86,9 +125,36 @@ struct _mspace {
 
 static intptr_t *stack_limit[MAX_THREADS];
 
-static void mspace_gc(mspace_t *m);
+static void mspace_gc(mspace_t *m, bool full);
 static bool is_mspace_ptr(mspace_t *m, char *p);
 
+static inline uint64_t *mask_word(bit_mask_t *m, int bit)
+{
+   return m->size > 64 ? &(m->ptr[bit / 64]) : &(m->bits);
+}
+
+#ifdef GENERATIONAL
+static bool mspace_guard_handler(void *addr, void *context)
+{
+   mspace_t *m = context;
+
+   if (!is_mspace_ptr(m, addr))
+      return false;
+
+   const int card = ((char *)addr - m->space) / m->cardsize;
+   if (!mask_test(&(m->protmask), card))
+      return false;   // Not protected by us
+
+   // The card must be writeable before it is marked dirty otherwise a
+   // collection in between could protect it again without scanning
+   nvc_memprotect(m->space + card * m->cardsize, m->cardsize, MEM_RW);
+
+   const uint64_t bit = UINT64_C(1) << (card % 64);
+   relaxed_fetch_or(mask_word(&(m->dirtymask), card), bit);
+   return true;
+}
+#endif
+
 mspace_t *mspace_new(size_t size)
 {
    mspace_t *m = xcalloc(sizeof(mspace_t));
@@ -104,6 +170,23 @@ mspace_t *mspace_new(size_t size)
    mask_init(&(m->headmask), m->maxlines);
    mask_setall(&(m->headmask));
 
+   mask_init(&(m->oldmask), m->maxlines);
+   mask_init(&(m->noscanmask), m->maxlines);
+   m->major_limit = m->maxlines / 2;
+
+#ifdef GENERATIONAL
+   if ((m->generational = opt_get_int(OPT_GC_GENERATIONAL))) {
+      m->cardsize = sysconf(_SC_PAGESIZE);
+      m->ncards   = (m->maxsize + m->cardsize - 1) / m->cardsize;
+      assert(m->cardsize % (64 * LINE_SIZE) == 0);
+
+      mask_init(&(m->protmask), m->ncards);
+      mask_init(&(m->dirtymask), m->ncards);
+
+      add_guard_handler(mspace_guard_handler, m);
+   }
+#endif
+
    free_list_t *f = xmalloc(sizeof(free_list_t));
    f->next = NULL;
    f->ptr  = m->space;
@@ -130,9 +213,19 @@ void mspace_destroy(mspace_t *m)
    if (opt_get_verbose(OPT_GC_VERBOSE, NULL) && m->num_cycles > 0) {
       const uint64_t destroy_us = get_timestamp_us();
       const double gc_frac = m->total_gc / (double)(destroy_us - m->create_us);
-      debugf("GC: %d collection cycles; %d us total; %.1f%% of overall "
-             "run time", m->num_cycles, m->total_gc, gc_frac * 100.0);
+      debugf("GC: %d collection cycles (%d minor); %d us total; %.1f%% of "
+             "overall run time", m->num_cycles, m->num_minor, m->total_gc,
+             gc_frac * 100.0);
+   }
+
+#ifdef GENERATIONAL
+   if (m->generational) {
+      remove_guard_handler(mspace_guard_handler, m);
+
+      mask_free(&(m->protmask));
+      mask_free(&(m->dirtymask));
    }
+#endif
 
    for (free_list_t *it = m->free_list, *tmp; it; it = tmp) {
       tmp = it->next;
@@ -145,6 +238,8 @@ void mspace_destroy(mspace_t *m)
    }
 
    mask_free(&(m->headmask));
+   mask_free(&(m->oldmask));
+   mask_free(&(m->noscanmask));
    nvc_munmap(m->space, m->maxsize);
    free(m);
 }
@@ -155,7 +250,7 @@ void mspace_stack_limit(void *limit)
    atomic_store(&(stack_limit[thread_id()]), limit);
 }
 
-static void *mspace_try_alloc(mspace_t *m, size_t size)
+static void *mspace_try_alloc(mspace_t *m, size_t size, bool noscan)
 {
    // Add one to size before rounding up to LINE_SIZE to allow a valid
    // pointer to point at one element past the end of an array
@@ -177,6 +272,13 @@ static void *mspace_try_alloc(mspace_t *m, size_t size)
          if (nlines > 1)
             mask_clear_range(&(m->headmask), line + 1, nlines - 1);
 
+         if (noscan)
+            mask_set_range(&(m->noscanmask), line, nlines);
+         else
+            mask_clear_range(&(m->noscanmask), line, nlines);
+
+         m->new_lines += nlines;
+
          if ((*it)->size == asize) {
             free_list_t *next = (*it)->next;
             free(*it);
@@ -198,7 +300,7 @@ static void *mspace_try_alloc(mspace_t *m, size_t size)
    return NULL;
 }
 
-void *mspace_alloc(mspace_t *m, size_t size)
+static void *mspace_alloc_common(mspace_t *m, size_t size, bool noscan)
 {
    if (size == 0)
       return NULL;
@@ -207,17 +309,20 @@ void *mspace_alloc(mspace_t *m, size_t size)
    if (stack_limit[thread_id()] == NULL)
       fatal_trace("cannot allocate without setting stack limit");
    else if (m->stress)
-      mspace_gc(m);
+      mspace_gc(m, false);
 #endif
 
-   int retry = 1;
-   do {
-      void *ptr = mspace_try_alloc(m, size);
+   // Try a minor collection first and then a full collection if that
+   // did not free enough space
+   for (int attempt = 0;; attempt++) {
+      void *ptr = mspace_try_alloc(m, size, noscan);
       if (ptr != NULL)
          return ptr;
+      else if (attempt == 2)
+         break;
 
-      mspace_gc(m);
-   } while (retry--);
+      mspace_gc(m, attempt > 0);
+   }
 
    if (m->oomfn) {
       (*m->oomfn)(m, size);
@@ -227,6 +332,18 @@ void *mspace_alloc(mspace_t *m, size_t size)
       fatal_trace("out of memory attempting to allocate %zu byte object", size);
 }
 
+void *mspace_alloc(mspace_t *m, size_t size)
+{
+   return mspace_alloc_common(m, size, false);
+}
+
+void *mspace_alloc_noscan(mspace_t *m, size_t size)
+{
+   // The object must not contain any pointers into the heap as it will
+   // never be scanned by the collector
+   return mspace_alloc_common(m, size, true);
+}
+
 static void mspace_return_memory(mspace_t *m, char *ptr, size_t size)
 {
    assert(is_mspace_ptr(m, ptr));
@@ -264,6 +381,7 @@ static void mspace_return_memory(mspace_t *m, char *ptr, size_t size)
 
    int line = (ptr - m->space) / LINE_SIZE;
    mask_set_range(&(m->headmask), line, nlines);
+   mask_clear_range(&(m->oldmask), line, nlines);
 }
 
 void *mspace_alloc_array(mspace_t *m, int nelems, size_t size)
@@ -385,7 +503,30 @@ static bool is_mspace_ptr(mspace_t *m, char *p)
    return p >= m->space && p < m->space + m->maxsize;
 }
 
-static void mspace_mark_root(mspace_t *m, intptr_t p, gc_state_t *state)
+static bool mspace_mark_object(bit_mask_t *markmask, int line, int objlen)
+{
+   uint64_t *word = mask_word(markmask, line);
+   const uint64_t bit = UINT64_C(1) << (line % 64);
+
+   if (relaxed_load(word) & bit)
+      return false;
+   else if (relaxed_fetch_or(word, bit) & bit)
+      return false;   // Marked by another thread
+
+   // Objects never overlap so only the first line needs to be claimed
+   // atomically but other threads may be updating the same words
+   for (int i = line + 1, end = line + objlen; i < end;) {
+      const int n = MIN(64 - i % 64, end - i);
+      const uint64_t bits = n == 64 ? ~UINT64_C(0)
+         : ((UINT64_C(1) << n) - 1) << (i % 64);
+      relaxed_fetch_or(mask_word(markmask, i), bits);
+      i += n;
+   }
+
+   return true;
+}
+
+static void mspace_mark_root(mspace_t *m, intptr_t p, gc_marker_t *marker)
 {
    if (is_mspace_ptr(m, (char *)p)) {
       int line = ((char *)p - m->space) / LINE_SIZE;
@@ -394,27 +535,193 @@ static void mspace_mark_root(mspace_t *m, intptr_t p, gc_state_t *state)
       line = mask_scan_backwards(&(m->headmask), line);
       assert(line != -1);
 
+      // Objects in the old generation are assumed to be live during a
+      // minor collection and any pointers they contain to new objects
+      // are found by scanning dirty cards
+      if (marker->state->minor && mask_test(&(m->oldmask), line))
+         return;
+
       int objlen = 1;
       if (line + 1 < m->maxlines)
          objlen += mask_count_clear(&(m->headmask), line + 1);
 
-      if (!mask_test(&(state->markmask), line)) {
-         mask_set_range(&(state->markmask), line, objlen);
-
+      if (!mspace_mark_object(&(marker->state->markmask), line, objlen))
+         return;   // Already marked
+      else if (!mask_test(&(m->noscanmask), line)) {
          uint64_t enc = ((uint64_t)line << 32) | objlen;
-         APUSH(state->worklist, enc);
+         APUSH(marker->worklist, enc);
       }
    }
 }
 
-static void mspace_mark_mptr(mspace_t *m, mptr_t ptr, gc_state_t *state)
+static void mspace_mark_mptr(mspace_t *m, mptr_t ptr, gc_marker_t *marker)
 {
 #ifdef DEBUG
    if (unlikely(ptr->ptr != NULL && !is_mspace_ptr(m, ptr->ptr)))
       fatal_trace("mptr %s points to unknown address %p", ptr->name, ptr->ptr);
 #endif
 
-   mspace_mark_root(m, (intptr_t)ptr->ptr, state);
+   mspace_mark_root(m, (intptr_t)ptr->ptr, marker);
+}
+
+#ifdef GENERATIONAL
+static void mspace_mark_dirty_cards(mspace_t *m, gc_marker_t *marker)
+{
+   const int card_lines = m->cardsize / LINE_SIZE;
+
+   for (int card = 0; card < m->ncards; card++) {
+      if (!mask_test(&(m->dirtymask), card))
+         continue;
+
+      const int first = card * card_lines;
+      const int last = MIN(first + card_lines, m->maxlines);
+      for (int line = first; line < last; line++) {
+         if (!mask_test(&(m->oldmask), line))
+            continue;
+         else if (mask_test(&(m->noscanmask), line))
+            continue;
+
+         intptr_t *words = (intptr_t *)(m->space + line * LINE_SIZE);
+         for (int j = 0; j < LINE_WORDS; j++)
+            mspace_mark_root(m, words[j], marker);
+      }
+   }
+}
+
+static bool mspace_card_is_tracked(mspace_t *m, int card)
+{
+   // Cards are always a whole number of mask words
+   const int card_lines = m->cardsize / LINE_SIZE;
+   const int first = card * card_lines;
+   const int last = MIN(first + card_lines, m->maxlines);
+
+   // Old objects without pointers can never point to a new object so
+   // writes to them do not need to be tracked
+   for (int line = first; line < last; line += 64) {
+      const uint64_t old = *mask_word(&(m->oldmask), line);
+      if (old & ~*mask_word(&(m->noscanmask), line))
+         return true;
+   }
+
+   return false;
+}
+
+static void mspace_protect_cards(mspace_t *m)
+{
+   // Write-protect every card that contains an old object so the
+   // first write to it after the collection marks it dirty
+   for (int card = 0; card < m->ncards;) {
+      const bool want = mspace_card_is_tracked(m, card);
+      const bool have = mask_test(&(m->protmask), card)
+         && !mask_test(&(m->dirtymask), card);
+
+      int end = card + 1;
+      for (; end < m->ncards; end++) {
+         if (mspace_card_is_tracked(m, end) != want)
+            break;
+         else if ((mask_test(&(m->protmask), end)
+                   && !mask_test(&(m->dirtymask), end)) != have)
+            break;
+      }
+
+      if (want != have)
+         nvc_memprotect(m->space + card * m->cardsize,
+                        (end - card) * m->cardsize, want ? MEM_RO : MEM_RW);
+
+      if (want)
+         mask_set_range(&(m->protmask), card, end - card);
+      else
+         mask_clear_range(&(m->protmask), card, end - card);
+
+      card = end;
+   }
+
+   mask_clearall(&(m->dirtymask));
+}
+#endif
+
+static bool mspace_take_work(gc_marker_t *marker)
+{
+   gc_state_t *state = marker->state;
+   bool idle = false;
+   int spins = 0;
+
+   for (;;) {
+      if (idle && relaxed_load(&(state->shared.count)) == 0
+          && relaxed_load(&(state->active)) > 0) {
+         if (spins++ < 100)
+            spin_wait();
+         else
+            thread_sleep(10);
+         continue;
+      }
+
+      SCOPED_LOCK(state->lock);
+
+      if (state->shared.count > 0) {
+         const int take = MIN(state->shared.count, MARK_BATCH);
+         for (int i = 0; i < take; i++)
+            APUSH(marker->worklist, APOP(state->shared));
+
+         if (idle)
+            state->active++;
+
+         return true;
+      }
+      else if (!idle) {
+         state->active--;
+         idle = true;
+      }
+
+      // Work is only added by active markers so once every marker is
+      // idle and the shared list is empty marking is complete
+      if (state->active == 0)
+         return false;
+   }
+}
+
+static void mspace_share_work(gc_marker_t *marker)
+{
+   gc_state_t *state = marker->state;
+
+   SCOPED_LOCK(state->lock);
+
+   for (int i = 0; i < MARK_BATCH; i++)
+      APUSH(state->shared, APOP(marker->worklist));
+}
+
+__attribute__((no_sanitize_address))
+static void mspace_mark_task(void *context, void *arg)
+{
+   gc_state_t *state = context;
+   mspace_t *m = state->mspace;
+
+   gc_marker_t marker = { .state = state };
+
+   {
+      SCOPED_LOCK(state->lock);
+      state->active++;
+   }
+
+   while (mspace_take_work(&marker)) {
+      while (marker.worklist.count > 0) {
+         if (state->parallel && marker.worklist.count > 2 * MARK_BATCH
+             && relaxed_load(&(state->shared.count)) == 0)
+            mspace_share_work(&marker);
+
+         const uint64_t enc = APOP(marker.worklist);
+         const int line = enc >> 32;
+         const int objlen = enc & 0xffffffff;
+
+         for (int i = 0; i < objlen; i++) {
+            intptr_t *words = (intptr_t *)(m->space + (line + i) * LINE_SIZE);
+            for (int j = 0; j < LINE_WORDS; j++)
+               mspace_mark_root(m, words[j], &marker);
+         }
+      }
+   }
+
+   ACLEAR(marker.worklist);
 }
 
 static void mspace_suspend_cb(int thread_id, struct cpu_state *cpu, void *arg)
@@ -425,7 +732,7 @@ static void mspace_suspend_cb(int thread_id, struct cpu_state *cpu, void *arg)
 }
 
 __attribute__((no_sanitize_address, noinline))
-static void mspace_gc(mspace_t *m)
+static void mspace_gc(mspace_t *m, bool full)
 {
    const uint64_t start_ticks = get_timestamp_us();
 
@@ -438,52 +745,76 @@ static void mspace_gc(mspace_t *m)
    return;   // Cannot reliably suspend threads with tsan
 #endif
 
-   gc_state_t state = {};
-   mask_init(&(state.markmask), m->maxlines);
-
    struct cpu_state *cpu LOCAL =
       xcalloc_array(MAX_THREADS, sizeof(struct cpu_state));
 
    SCOPED_LOCK(m->lock);
 
+   gc_state_t state = {
+      .mspace = m,
+#ifdef GENERATIONAL
+      .minor  = m->generational && !full && m->old_lines < m->major_limit
+                && !m->skip_minor,
+#endif
+   };
+   mask_init(&(state.markmask), m->maxlines);
+
    stop_world(mspace_suspend_cb, cpu);
 
+   gc_marker_t roots = { .state = &state };
+
    for (int i = 0; i < MAX_THREADS; i++) {
       if (get_thread(i) == NULL)
          continue;
+      else if (cpu[i].sp == 0)
+         continue;   // Helper threads are not suspended
 
       intptr_t *limit = atomic_load(&(stack_limit[i]));
       if (limit == NULL)
          continue;
 
       for (int j = 0; j < MAX_CPU_REGS; j++)
-         mspace_mark_root(m, cpu[i].regs[j], &state);
+         mspace_mark_root(m, cpu[i].regs[j], &roots);
 
       intptr_t *stack_top = (intptr_t *)cpu[i].sp;
       assert(stack_top <= limit);   // Stack must grow down
 
       for (intptr_t *p = stack_top; p < limit; p++)
-         mspace_mark_root(m, *p, &state);
+         mspace_mark_root(m, *p, &roots);
    }
 
    for (mptr_t p = m->roots; p; p = p->next)
-      mspace_mark_mptr(m, p, &state);
+      mspace_mark_mptr(m, p, &roots);
 
-   while (state.worklist.count > 0) {
-      const uint64_t enc = APOP(state.worklist);
-      const int line = enc >> 32;
-      const int objlen = enc & 0xffffffff;
+#ifdef GENERATIONAL
+   if (state.minor)
+      mspace_mark_dirty_cards(m, &roots);
+#endif
 
-      for (int i = 0; i < objlen; i++) {
-         intptr_t *words = (intptr_t *)(m->space + (line + i) * LINE_SIZE);
-         for (int j = 0; j < LINE_WORDS; j++)
-            mspace_mark_root(m, words[j], &state);
-      }
-   }
+   state.shared = roots.worklist;
+
+   // Only use helper threads when there is likely to be enough work
+   const unsigned estimate = m->new_lines + (state.minor ? 0 : m->old_lines);
+   state.parallel = estimate >= PARALLEL_LINES;
+
+   if (state.parallel)
+      helper_parallel_do(mspace_mark_task, &state, MAX_THREADS);
+   else
+      mspace_mark_task(&state, NULL);
+
+   assert(state.shared.count == 0);
+   ACLEAR(state.shared);
+
+   // Everything that survives a collection is promoted
+   if (state.minor)
+      mask_union(&(state.markmask), &(m->oldmask));
+
+   mask_free(&(m->oldmask));
+   m->oldmask = state.markmask;
 
 #if __SANITIZE_ADDRESS__
    for (int i = 0; i < m->maxlines; i++) {
-      if (!mask_test(&(state.markmask), i))
+      if (!mask_test(&(m->oldmask), i))
          MSPACE_POISON(m->space + i * LINE_SIZE, LINE_SIZE);
    }
 #endif
@@ -497,9 +828,14 @@ static void mspace_gc(mspace_t *m)
    int freefrags = 0, freelines = 0;
    free_list_t **tail = &(m->free_list);
    for (int line = 0; line < m->maxlines;) {
-      const int clear = mask_count_clear(&(state.markmask), line);
-      if (clear == 0)
-         line++;
+      const int clear = mask_count_clear(&(m->oldmask), line);
+      if (clear == 0) {
+         // Skip to the next clear bit in this word as the old
+         // generation may contain long runs of live lines
+         const uint64_t word = *mask_word(&(m->oldmask), line);
+         const uint64_t dead = ~(word >> (line % 64));
+         line += dead == 0 ? 64 : __builtin_ctzll(dead);
+      }
       else {
          free_list_t *f = xmalloc(sizeof(free_list_t));
          f->next = NULL;
@@ -518,22 +854,49 @@ static void mspace_gc(mspace_t *m)
       }
    }
 
+   const unsigned promoted = m->maxlines - freelines - m->old_lines;
+
+   if (!state.minor) {
+      // Allow the old generation to grow into half the remaining free
+      // space before the next major collection
+      m->major_limit = m->maxlines - freelines / 2;
+
+      if (m->skip_minor > 0)
+         m->skip_minor--;
+   }
+   else if (promoted > m->new_lines / 2) {
+      // Most new objects survived which often means they are kept
+      // alive by dead old objects such as the tail of a queue so back
+      // off from minor collections for a while
+      m->minor_backoff = MIN(MAX(m->minor_backoff * 2, 1), 64);
+      m->skip_minor = m->minor_backoff;
+   }
+   else
+      m->minor_backoff = 0;
+
+   m->old_lines = m->maxlines - freelines;
+   m->new_lines = 0;
+
+#ifdef GENERATIONAL
+   if (m->generational)
+      mspace_protect_cards(m);
+#endif
+
    start_world();
 
    if (opt_get_verbose(OPT_GC_VERBOSE, NULL)) {
       const int ticks = get_timestamp_us() - start_ticks;
-      debugf("GC: allocated %d/%zu; fragmentation %.2g%% [%d us]",
-             mask_popcount(&(state.markmask)) * LINE_SIZE, m->maxsize,
+      debugf("GC: %s collection; allocated %d/%zu; fragmentation %.2g%% "
+             "[%d us]", state.minor ? "minor" : "major",
+             m->old_lines * LINE_SIZE, m->maxsize,
              ((double)(freefrags - 1) / (double)freelines) * 100.0, ticks);
 
       m->total_gc += ticks;
       m->num_cycles++;
-   }
 
-   mask_free(&(state.markmask));
-
-   assert(state.worklist.count == 0);
-   ACLEAR(state.worklist);
+      if (state.minor)
+         m->num_minor++;
+   }
 }
 
 void *mspace_find(mspace_t *m, void *ptr, size_t *size)
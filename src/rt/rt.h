@@ -23,7 +23,7 @@
 
 #include <stdint.h>
 
-#define RT_ABI_VERSION   17
+#define RT_ABI_VERSION   20
 #define RT_ALIGN_MASK    0x7
 #define RT_MULTITHREADED 0
 
@@ -68,6 +68,8 @@ typedef uint8_t net_flags_t;
 #define SIG_F_STD_LOGIC    (1 << 9)
 #define SIG_F_CACHE_EVENT  (1 << 10)
 #define SIG_F_EVENT_FLAG   (1 << 11)
+#define SIG_F_INLINE_DRV   (1 << 12)
+#define SIG_F_INLINE_PEND  (1 << 13)
 typedef uint32_t sig_flags_t;
 
 typedef enum {
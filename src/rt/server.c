@@ -0,0 +1,475 @@
+//
+//  Copyright (C) 2023  Nick Gasson
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "util.h"
+#include "array.h"
+#include "rt/server.h"
+#include "thread.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifndef __MINGW32__
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#endif
+
+// The server loads and resets the design once and then forks a new
+// process for each request received on a Unix domain socket.  A
+// request consists of the header below followed by the client's
+// working directory and the run arguments as a sequence of NUL
+// terminated strings.  The client's standard input, output, and error
+// file descriptors are passed along with the header so the simulation
+// writes directly to the client's terminal.  When the child process
+// exits the server replies with its 32-bit exit status.
+
+#define SERVER_MAGIC    0x5343564e   // "NVCS"
+#define SERVER_MAX_ARGS 4096
+#define SERVER_MAX_DATA 0x100000
+
+typedef struct {
+   uint32_t magic;
+   uint32_t argc;
+   uint32_t length;
+} server_header_t;
+
+#ifndef __MINGW32__
+
+typedef struct {
+   pid_t pid;
+   int   conn;
+} server_child_t;
+
+typedef A(server_child_t) child_list_t;
+
+static int                   wakeup_fds[2] = { -1, -1 };
+static volatile sig_atomic_t stop_server = 0;
+
+static bool write_all(int fd, const void *buf, size_t len)
+{
+   for (const char *p = buf; len > 0;) {
+      const ssize_t nw = write(fd, p, len);
+      if (nw < 0 && errno == EINTR)
+         continue;
+      else if (nw <= 0)
+         return false;
+
+      p += nw;
+      len -= nw;
+   }
+
+   return true;
+}
+
+static bool read_all(int fd, void *buf, size_t len)
+{
+   for (char *p = buf; len > 0;) {
+      const ssize_t nr = read(fd, p, len);
+      if (nr < 0 && errno == EINTR)
+         continue;
+      else if (nr <= 0)
+         return false;
+
+      p += nr;
+      len -= nr;
+   }
+
+   return true;
+}
+
+static void server_signal_handler(int sig)
+{
+   if (sig != SIGCHLD)
+      stop_server = 1;
+
+   const int saved_errno = errno;
+   if (write(wakeup_fds[1], "", 1) < 0)
+      ;   // Pipe is full which is fine
+   errno = saved_errno;
+}
+
+static void set_server_signals(void (*handler)(int))
+{
+   struct sigaction sa = {};
+   sa.sa_handler = handler;
+   sigemptyset(&sa.sa_mask);
+
+   sigaction(SIGCHLD, &sa, NULL);
+   sigaction(SIGTERM, &sa, NULL);
+   sigaction(SIGINT, &sa, NULL);
+}
+
+static bool recv_request(int conn, server_header_t *hdr, int fds[3])
+{
+   union {
+      char           buf[CMSG_SPACE(3 * sizeof(int))];
+      struct cmsghdr align;
+   } control;
+
+   struct iovec iov = {
+      .iov_base = hdr,
+      .iov_len  = sizeof(server_header_t)
+   };
+
+   struct msghdr msg = {
+      .msg_iov        = &iov,
+      .msg_iovlen     = 1,
+      .msg_control    = control.buf,
+      .msg_controllen = sizeof(control.buf)
+   };
+
+   ssize_t nr;
+   do {
+      nr = recvmsg(conn, &msg, 0);
+   } while (nr < 0 && errno == EINTR);
+
+   if (nr <= 0)
+      return false;
+
+   struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+   if (cmsg == NULL || cmsg->cmsg_level != SOL_SOCKET
+       || cmsg->cmsg_type != SCM_RIGHTS
+       || cmsg->cmsg_len != CMSG_LEN(3 * sizeof(int)))
+      return false;
+
+   memcpy(fds, CMSG_DATA(cmsg), 3 * sizeof(int));
+
+   // The rest of the header may arrive separately
+   if (nr < sizeof(server_header_t)
+       && !read_all(conn, (char *)hdr + nr, sizeof(server_header_t) - nr))
+      return false;
+
+   return hdr->magic == SERVER_MAGIC && hdr->argc < SERVER_MAX_ARGS
+      && hdr->length < SERVER_MAX_DATA;
+}
+
+__attribute__((noreturn))
+static void server_child(int sock, int conn, server_run_fn_t fn, void *ctx)
+{
+   close(sock);
+   close(wakeup_fds[0]);
+   close(wakeup_fds[1]);
+
+   set_server_signals(SIG_DFL);
+
+   server_header_t hdr;
+   int fds[3];
+   if (!recv_request(conn, &hdr, fds))
+      _exit(EXIT_FAILURE);
+
+   char *data = xmalloc(hdr.length + 1);
+   if (!read_all(conn, data, hdr.length))
+      _exit(EXIT_FAILURE);
+
+   data[hdr.length] = '\0';
+
+   close(conn);
+
+   for (int i = 0; i < 3; i++) {
+      if (dup2(fds[i], i) < 0)
+         _exit(EXIT_FAILURE);
+      close(fds[i]);
+   }
+
+   term_init();   // Output now goes to the client's terminal
+
+   // First string is the working directory and the rest are arguments
+   char **argv = xmalloc_array(hdr.argc + 2, sizeof(char *));
+   const char *cwd = data;
+   char *p = data + strlen(cwd) + 1, *endp = data + hdr.length;
+
+   argv[0] = PACKAGE;
+   int argc = 1;
+   for (; argc <= hdr.argc && p < endp; argc++) {
+      argv[argc] = p;
+      p += strlen(p) + 1;
+   }
+   argv[argc] = NULL;
+
+   if (chdir(cwd) != 0)
+      fatal_errno("chdir: %s", cwd);
+
+   const int rc = (*fn)(argc, argv, ctx);
+
+   fflush(stdout);
+   fflush(stderr);
+
+   exit(rc);
+}
+
+static bool peer_is_same_user(int conn)
+{
+   // Only accept requests from processes owned by the same user as
+   // the server regardless of the permissions on the socket file
+#ifdef SO_PEERCRED
+   struct ucred cred;
+   socklen_t len = sizeof(cred);
+   if (getsockopt(conn, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0)
+      return false;
+
+   return cred.uid == geteuid();
+#else
+   uid_t uid;
+   gid_t gid;
+   if (getpeereid(conn, &uid, &gid) != 0)
+      return false;
+
+   return uid == geteuid();
+#endif
+}
+
+static void reply_status(int conn, int status)
+{
+   int32_t rc;
+   if (WIFEXITED(status))
+      rc = WEXITSTATUS(status);
+   else if (WIFSIGNALED(status))
+      rc = 128 + WTERMSIG(status);
+   else
+      rc = EXIT_FAILURE;
+
+   if (!write_all(conn, &rc, sizeof(rc)))
+      ;   // Client went away
+
+   close(conn);
+}
+
+static void reap_children(child_list_t *children, bool block)
+{
+   int status;
+   pid_t pid;
+   while ((pid = waitpid(-1, &status, block ? 0 : WNOHANG)) > 0) {
+      for (int i = 0; i < children->count; i++) {
+         if (children->items[i].pid == pid) {
+            reply_status(children->items[i].conn, status);
+            children->items[i] = children->items[--(children->count)];
+            break;
+         }
+      }
+   }
+}
+
+void server_listen(const char *path, server_run_fn_t fn, void *ctx)
+{
+   struct sockaddr_un addr = { .sun_family = AF_UNIX };
+   if (strlen(path) >= sizeof(addr.sun_path))
+      fatal("socket path %s is too long", path);
+
+   strcpy(addr.sun_path, path);
+
+   const int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+   if (sock < 0)
+      fatal_errno("socket");
+
+   // Remove any stale socket left over from a previous server
+   if (unlink(path) != 0 && errno != ENOENT)
+      fatal_errno("unlink: %s", path);
+
+   if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+      fatal_errno("bind: %s", path);
+
+   if (listen(sock, SOMAXCONN) != 0)
+      fatal_errno("listen");
+
+   if (pipe(wakeup_fds) != 0)
+      fatal_errno("pipe");
+
+   for (int i = 0; i < 2; i++) {
+      fcntl(wakeup_fds[i], F_SETFL, O_NONBLOCK);
+      fcntl(wakeup_fds[i], F_SETFD, FD_CLOEXEC);
+   }
+
+   set_server_signals(server_signal_handler);
+
+   // There must be no other threads running when we fork
+   async_barrier();
+
+   notef("waiting for requests on %s", path);
+
+   child_list_t children = AINIT;
+
+   while (!stop_server) {
+      struct pollfd pfd[2] = {
+         { .fd = sock, .events = POLLIN },
+         { .fd = wakeup_fds[0], .events = POLLIN },
+      };
+
+      if (poll(pfd, 2, -1) < 0) {
+         if (errno == EINTR)
+            continue;
+         fatal_errno("poll");
+      }
+
+      if (pfd[1].revents & POLLIN) {
+         char buf[64];
+         while (read(wakeup_fds[0], buf, sizeof(buf)) > 0)
+            ;
+
+         reap_children(&children, false);
+      }
+
+      if ((pfd[0].revents & POLLIN) && !stop_server) {
+         const int conn = accept(sock, NULL, NULL);
+         if (conn < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+               continue;
+            fatal_errno("accept");
+         }
+
+         if (!peer_is_same_user(conn)) {
+            warnf("rejected connection from another user");
+            close(conn);
+            continue;
+         }
+
+         fflush(stdout);
+         fflush(stderr);
+
+         const pid_t pid = fork();
+         if (pid == 0)
+            server_child(sock, conn, fn, ctx);
+         else if (pid < 0) {
+            warnf("fork: %s", strerror(errno));
+            close(conn);
+         }
+         else
+            APUSH(children, ((server_child_t){ pid, conn }));
+      }
+   }
+
+   close(sock);
+   unlink(path);
+
+   // Let any outstanding requests run to completion
+   reap_children(&children, true);
+   ACLEAR(children);
+
+   set_server_signals(SIG_DFL);
+
+   close(wakeup_fds[0]);
+   close(wakeup_fds[1]);
+}
+
+int server_connect(const char *path, int argc, char **argv)
+{
+   struct sockaddr_un addr = { .sun_family = AF_UNIX };
+   if (strlen(path) >= sizeof(addr.sun_path))
+      fatal("socket path %s is too long", path);
+
+   strcpy(addr.sun_path, path);
+
+   const int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+   if (sock < 0)
+      fatal_errno("socket");
+
+   if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+      fatal_errno("cannot connect to server at %s", path);
+
+   char cwd[PATH_MAX];
+   if (getcwd(cwd, sizeof(cwd)) == NULL)
+      fatal_errno("getcwd");
+
+   size_t length = strlen(cwd) + 1;
+   for (int i = 0; i < argc; i++)
+      length += strlen(argv[i]) + 1;
+
+   if (argc >= SERVER_MAX_ARGS || length >= SERVER_MAX_DATA)
+      fatal("too many arguments for server request");
+
+   char *data LOCAL = xmalloc(length), *p = data;
+   p = stpcpy(p, cwd) + 1;
+   for (int i = 0; i < argc; i++)
+      p = stpcpy(p, argv[i]) + 1;
+   assert(p == data + length);
+
+   server_header_t hdr = {
+      .magic  = SERVER_MAGIC,
+      .argc   = argc,
+      .length = length
+   };
+
+   union {
+      char           buf[CMSG_SPACE(3 * sizeof(int))];
+      struct cmsghdr align;
+   } control;
+
+   struct iovec iov = {
+      .iov_base = &hdr,
+      .iov_len  = sizeof(server_header_t)
+   };
+
+   struct msghdr msg = {
+      .msg_iov        = &iov,
+      .msg_iovlen     = 1,
+      .msg_control    = control.buf,
+      .msg_controllen = sizeof(control.buf)
+   };
+
+   struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+   cmsg->cmsg_level = SOL_SOCKET;
+   cmsg->cmsg_type  = SCM_RIGHTS;
+   cmsg->cmsg_len   = CMSG_LEN(3 * sizeof(int));
+
+   const int fds[3] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+   memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+   fflush(stdout);
+   fflush(stderr);
+
+   ssize_t nw;
+   do {
+      nw = sendmsg(sock, &msg, 0);
+   } while (nw < 0 && errno == EINTR);
+
+   if (nw < 0)
+      fatal_errno("sendmsg");
+   else if (nw < sizeof(hdr) && !write_all(sock, (char *)&hdr + nw,
+                                           sizeof(hdr) - nw))
+      fatal_errno("write");
+
+   if (!write_all(sock, data, length))
+      fatal_errno("write");
+
+   int32_t rc;
+   if (!read_all(sock, &rc, sizeof(rc)))
+      fatal("lost connection to server at %s", path);
+
+   close(sock);
+   return rc;
+}
+
+#else  // __MINGW32__
+
+void server_listen(const char *path, server_run_fn_t fn, void *ctx)
+{
+   fatal("server mode is not supported on Windows");
+}
+
+int server_connect(const char *path, int argc, char **argv)
+{
+   fatal("server mode is not supported on Windows");
+}
+
+#endif  // __MINGW32__
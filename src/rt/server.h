@@ -0,0 +1,28 @@
+//
+//  Copyright (C) 2023  Nick Gasson
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef _RT_SERVER_H
+#define _RT_SERVER_H
+
+#include "prim.h"
+
+typedef int (*server_run_fn_t)(int argc, char **argv, void *ctx);
+
+void server_listen(const char *path, server_run_fn_t fn, void *ctx);
+int server_connect(const char *path, int argc, char **argv);
+
+#endif  // _RT_SERVER_H
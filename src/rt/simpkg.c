@@ -21,6 +21,7 @@
 #include "jit/jit-exits.h"
 #include "jit/jit-ffi.h"
 #include "rt/rt.h"
+#include "rt/wave.h"
 
 DLLEXPORT
 bool _nvc_ieee_warnings(void)
@@ -34,6 +35,16 @@ int _nvc_current_delta(void)
    return x_current_delta();
 }
 
+DLLEXPORT
+void _nvc_set_wave_dumping(int32_t enable)
+{
+   static bool warned = false;
+   if (!wave_set_dumping(enable) && !warned) {
+      warnf("SET_WAVE_DUMPING has no effect without $bold$--wave$$");
+      warned = true;
+   }
+}
+
 void _nvc_sim_pkg_init(void)
 {
    // Dummy function to force linking
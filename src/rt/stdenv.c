@@ -86,7 +86,7 @@ static char *to_cstring(const uint8_t *data, int len)
 
 static ffi_uarray_t *to_line_n(const char *str, size_t len)
 {
-   char *buf = jit_mspace_alloc(len);
+   char *buf = jit_mspace_alloc_noscan(len);
    memcpy(buf, str, len);
 
    ffi_uarray_t *u = jit_mspace_alloc(sizeof(ffi_uarray_t));
@@ -49,6 +49,7 @@ typedef struct _rt_proc {
    tlab_t         tlab;
    rt_scope_t    *scope;
    mptr_t         privdata;
+   ptr_list_t     inlinesigs;
 } rt_proc_t;
 
 typedef struct {
@@ -83,6 +84,17 @@ typedef struct {
    rt_wakeable_t *wake[];
 } rt_pending_t;
 
+typedef struct {
+   uint64_t  mask;
+   void     *pending;
+} rt_edge_t;
+
+typedef struct {
+   void      *pending;
+   unsigned   count;
+   rt_edge_t  edges[];
+} rt_edge_list_t;
+
 typedef enum {
    SOURCE_DRIVER,
    SOURCE_PORT,
@@ -213,6 +225,8 @@ typedef struct _rt_scope {
    mptr_t           privdata;
    rt_scope_t      *parent;
    ptr_list_t       children;
+   hash_t          *lookup;
+   unsigned         nlookup;
 } rt_scope_t;
 
 typedef struct _rt_watch {
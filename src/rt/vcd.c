@@ -0,0 +1,359 @@
+//
+//  Copyright (C) 2023  Nick Gasson
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "util.h"
+#include "array.h"
+#include "rt/vcd.h"
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <zstd.h>
+
+#define VCD_BUFSZ    0x100000
+#define VCD_MAX_ID   8
+
+typedef enum {
+   VCD_BITS, VCD_REAL, VCD_STRING
+} vcd_kind_t;
+
+typedef struct {
+   vcd_kind_t kind;
+   uint32_t   len;
+   uint8_t    idlen;
+   char       id[VCD_MAX_ID];
+} vcd_var_t;
+
+typedef A(vcd_var_t) var_array_t;
+
+typedef struct _vcd_writer {
+   FILE        *file;
+   char        *fname;
+   char        *buf;
+   size_t       wpend;
+   ZSTD_CCtx   *zstd;
+   void        *zbuf;
+   size_t       zbufsz;
+   var_array_t  vars;
+   text_buf_t  *dumpvars;
+   text_buf_t  *scratch;
+   bool         enddefs;
+   uint64_t     last_time;
+} vcd_writer_t;
+
+static const char *vcd_scope_kinds[] = {
+   "module", "task", "function", "begin", "fork", "generate", "struct",
+   "union", "class", "interface", "package", "program", "vhdl_architecture",
+   "vhdl_procedure", "vhdl_function", "vhdl_record", "vhdl_process",
+   "vhdl_block", "vhdl_for_generate", "vhdl_if_generate", "vhdl_generate",
+   "vhdl_package"
+};
+
+static const char *vcd_var_kinds[] = {
+   "event", "integer", "parameter", "real", "real_parameter", "reg",
+   "supply0", "supply1", "time", "tri", "triand", "trior", "trireg",
+   "tri0", "tri1", "wand", "wire", "wor", "port", "sparray", "realtime",
+   "string", "bit", "logic", "int", "shortint", "longint", "byte", "enum",
+   "shortreal"
+};
+
+STATIC_ASSERT(ARRAY_LEN(vcd_scope_kinds) == FST_ST_MAX + 1);
+STATIC_ASSERT(ARRAY_LEN(vcd_var_kinds) == FST_VT_MAX + 1);
+
+static void vcd_compress(vcd_writer_t *vw, const void *data, size_t len,
+                         bool end)
+{
+   ZSTD_EndDirective mode = end ? ZSTD_e_end : ZSTD_e_continue;
+   ZSTD_inBuffer input = { data, len, 0 };
+   bool finished;
+   do {
+      ZSTD_outBuffer output = { vw->zbuf, vw->zbufsz, 0 };
+      size_t remaining = ZSTD_compressStream2(vw->zstd, &output, &input, mode);
+      if (ZSTD_isError(remaining))
+         fatal("ZSTD compress failed: %s", ZSTD_getErrorName(remaining));
+
+      if (output.pos > 0 && fwrite(vw->zbuf, output.pos, 1, vw->file) != 1)
+         fatal_errno("%s: fwrite", vw->fname);
+
+      finished = end ? (remaining == 0) : (input.pos == input.size);
+   } while (!finished);
+}
+
+static void vcd_flush(vcd_writer_t *vw, bool end)
+{
+   if (vw->zstd != NULL)
+      vcd_compress(vw, vw->buf, vw->wpend, end);
+   else if (vw->wpend > 0 && fwrite(vw->buf, vw->wpend, 1, vw->file) != 1)
+      fatal_errno("%s: fwrite", vw->fname);
+
+   vw->wpend = 0;
+}
+
+static void vcd_write_raw(vcd_writer_t *vw, const char *str, size_t len)
+{
+   if (vw->wpend + len > VCD_BUFSZ) {
+      vcd_flush(vw, false);
+
+      if (len > VCD_BUFSZ) {
+         if (vw->zstd != NULL)
+            vcd_compress(vw, str, len, false);
+         else if (fwrite(str, len, 1, vw->file) != 1)
+            fatal_errno("%s: fwrite", vw->fname);
+         return;
+      }
+   }
+
+   memcpy(vw->buf + vw->wpend, str, len);
+   vw->wpend += len;
+}
+
+static void vcd_write(vcd_writer_t *vw, const char *str, size_t len)
+{
+   // Initial values are emitted while the variables are still being
+   // declared so hold them back until the header is complete
+   if (likely(vw->enddefs))
+      vcd_write_raw(vw, str, len);
+   else
+      tb_catn(vw->dumpvars, str, len);
+}
+
+static void vcd_printf(vcd_writer_t *vw, const char *fmt, ...)
+{
+   tb_rewind(vw->scratch);
+
+   va_list ap;
+   va_start(ap, fmt);
+   tb_vprintf(vw->scratch, fmt, ap);
+   va_end(ap);
+
+   vcd_write_raw(vw, tb_get(vw->scratch), tb_len(vw->scratch));
+}
+
+vcd_writer_t *vcd_writer_new(const char *file, const char *version)
+{
+   FILE *f = fopen(file, "wb");
+   if (f == NULL)
+      return NULL;
+
+   vcd_writer_t *vw = xcalloc(sizeof(vcd_writer_t));
+   vw->file      = f;
+   vw->fname     = xstrdup(file);
+   vw->buf       = xmalloc(VCD_BUFSZ);
+   vw->dumpvars  = tb_new();
+   vw->scratch   = tb_new();
+   vw->last_time = 0;
+
+   const size_t namelen = strlen(file);
+   if (namelen > 4 && strcmp(file + namelen - 4, ".zst") == 0) {
+      if ((vw->zstd = ZSTD_createCCtx()) == NULL)
+         fatal_trace("ZSTD_createCCtx() failed");
+
+      size_t rc = ZSTD_CCtx_setParameter(vw->zstd, ZSTD_c_compressionLevel, 3);
+      if (ZSTD_isError(rc))
+         fatal("failed to set ZSTD compression level: %s",
+               ZSTD_getErrorName(rc));
+
+      // Compress on a background thread where libzstd supports it,
+      // otherwise this fails and compression happens synchronously
+      (void)ZSTD_CCtx_setParameter(vw->zstd, ZSTD_c_nbWorkers, 1);
+
+      vw->zbufsz = ZSTD_CStreamOutSize();
+      vw->zbuf   = xmalloc(vw->zbufsz);
+   }
+
+   const time_t now = time(NULL);
+   char date[64];
+   strftime(date, sizeof(date), "%a %b %e %H:%M:%S %Y", localtime(&now));
+
+   vcd_printf(vw, "$date\n\t%s\n$end\n", date);
+   vcd_printf(vw, "$version\n\t%s\n$end\n", version);
+   vcd_printf(vw, "$timescale\n\t1fs\n$end\n");
+
+   return vw;
+}
+
+void vcd_writer_close(vcd_writer_t *vw, uint64_t now)
+{
+   if (!vw->enddefs)
+      vcd_end_definitions(vw);
+
+   vcd_emit_time_change(vw, now);
+   vcd_flush(vw, true);
+
+   if (fclose(vw->file) != 0)
+      fatal_errno("%s: fclose", vw->fname);
+
+   if (vw->zstd != NULL)
+      ZSTD_freeCCtx(vw->zstd);
+
+   ACLEAR(vw->vars);
+   tb_free(vw->scratch);
+   free(vw->zbuf);
+   free(vw->buf);
+   free(vw->fname);
+   free(vw);
+}
+
+void vcd_set_scope(vcd_writer_t *vw, enum fstScopeType st, const char *name)
+{
+   assert(!vw->enddefs);
+   assert(st >= FST_ST_MIN && st <= FST_ST_MAX);
+   vcd_printf(vw, "$scope %s %s $end\n", vcd_scope_kinds[st], name);
+}
+
+void vcd_set_upscope(vcd_writer_t *vw)
+{
+   assert(!vw->enddefs);
+   vcd_printf(vw, "$upscope $end\n");
+}
+
+fstHandle vcd_create_var(vcd_writer_t *vw, enum fstVarType vt, uint32_t len,
+                         const char *name)
+{
+   assert(!vw->enddefs);
+   assert(vt >= FST_VT_MIN && vt <= FST_VT_MAX);
+
+   const fstHandle handle = vw->vars.count + 1;
+
+   vcd_var_t var = { .len = len };
+
+   switch (vt) {
+   case FST_VT_VCD_REAL:
+      var.kind = VCD_REAL;
+      var.len  = 64;
+      break;
+   case FST_VT_GEN_STRING:
+      var.kind = VCD_STRING;
+      break;
+   default:
+      var.kind = VCD_BITS;
+      break;
+   }
+
+   // Identifiers are base-94 encoded handles using printable characters
+   for (unsigned value = handle; value; value /= 94) {
+      assert(var.idlen < VCD_MAX_ID);
+      value--;
+      var.id[var.idlen++] = '!' + value % 94;
+   }
+
+   APUSH(vw->vars, var);
+
+   vcd_printf(vw, "$var %s %"PRIu32" %.*s ", vcd_var_kinds[vt], var.len,
+              var.idlen, var.id);
+   vcd_write_raw(vw, name, strlen(name));
+   vcd_printf(vw, " $end\n");
+
+   return handle;
+}
+
+void vcd_end_definitions(vcd_writer_t *vw)
+{
+   assert(!vw->enddefs);
+
+   vcd_printf(vw, "$enddefinitions $end\n#0\n$dumpvars\n");
+   vcd_write_raw(vw, tb_get(vw->dumpvars), tb_len(vw->dumpvars));
+   vcd_printf(vw, "$end\n");
+
+   tb_free(vw->dumpvars);
+   vw->dumpvars = NULL;
+   vw->enddefs  = true;
+}
+
+void vcd_emit_time_change(vcd_writer_t *vw, uint64_t now)
+{
+   if (now == vw->last_time)
+      return;
+
+   assert(vw->enddefs);
+   assert(now > vw->last_time);
+
+   char buf[32];
+   const int len = checked_sprintf(buf, sizeof(buf), "#%"PRIu64"\n", now);
+   vcd_write_raw(vw, buf, len);
+
+   vw->last_time = now;
+}
+
+void vcd_emit_value_change(vcd_writer_t *vw, fstHandle handle,
+                           const void *val)
+{
+   assert(handle > 0 && handle <= vw->vars.count);
+   const vcd_var_t *var = &(vw->vars.items[handle - 1]);
+
+   switch (var->kind) {
+   case VCD_BITS:
+      {
+         const size_t size = var->len + var->idlen + (var->len != 1 ? 3 : 1);
+
+         tb_rewind(vw->scratch);
+         char *start = tb_reserve(vw->scratch, size), *p = start;
+         if (var->len != 1)
+            *p++ = 'b';
+         memcpy(p, val, var->len);
+         p += var->len;
+         if (var->len != 1)
+            *p++ = ' ';
+         memcpy(p, var->id, var->idlen);
+         p += var->idlen;
+         *p++ = '\n';
+         assert(p == start + size);
+
+         vcd_write(vw, start, size);
+      }
+      break;
+
+   case VCD_REAL:
+      {
+         double dval;
+         memcpy(&dval, val, sizeof(double));
+
+         char buf[64];
+         const int len = checked_sprintf(buf, sizeof(buf), "r%.16g %.*s\n",
+                                         dval, var->idlen, var->id);
+         vcd_write(vw, buf, len);
+      }
+      break;
+
+   case VCD_STRING:
+      vcd_emit_variable_length_value_change(vw, handle, val,
+                                            strlen((const char *)val));
+      break;
+   }
+}
+
+void vcd_emit_variable_length_value_change(vcd_writer_t *vw, fstHandle handle,
+                                           const void *val, uint32_t len)
+{
+   assert(handle > 0 && handle <= vw->vars.count);
+   const vcd_var_t *var = &(vw->vars.items[handle - 1]);
+
+   // Escaping can expand each character to at most four
+   tb_rewind(vw->scratch);
+   char *start = tb_reserve(vw->scratch, len * 4 + var->idlen + 3), *p = start;
+   *p++ = 's';
+   p += fstUtilityBinToEsc((unsigned char *)p, val, len);
+   *p++ = ' ';
+   memcpy(p, var->id, var->idlen);
+   p += var->idlen;
+   *p++ = '\n';
+
+   vcd_write(vw, start, p - start);
+}
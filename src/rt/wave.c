@@ -25,29 +25,37 @@
 #include "rt/model.h"
 #include "rt/rt.h"
 #include "rt/structs.h"
+#include "rt/vcd.h"
 #include "rt/wave.h"
 #include "tree.h"
 #include "type.h"
 
 #include <assert.h>
-#include <unistd.h>
 #include <limits.h>
 #include <string.h>
 
-#if !defined __CYGWIN__ && !defined __MINGW32__
-#include <libgen.h>
+#ifdef HAVE_AVX2
+#include <x86intrin.h>
 #endif
 
 typedef struct {
    char  *text;
    size_t len;
+   size_t prefix;
 } glob_t;
 
 typedef A(glob_t) glob_array_t;
 
+typedef struct {
+   glob_array_t  globs;
+   hset_t       *exact;
+   unsigned      nwild;
+} glob_set_t;
+
 typedef struct _fst_data fst_data_t;
 
 typedef void (*fst_fmt_fn_t)(rt_watch_t *, fst_data_t *);
+typedef void (*fst_map_fn_t)(char *, const uint8_t *, size_t, const char *);
 
 typedef struct {
    int64_t  mult;
@@ -84,6 +92,8 @@ typedef struct _fst_data {
    fstHandle      handle[];
 } fst_data_t;
 
+typedef A(fst_data_t *) data_array_t;
+
 typedef struct {
    FILE       *file;
    int         colour;
@@ -95,56 +105,103 @@ typedef struct _wave_dumper {
    void          *fst_ctx;
    rt_model_t    *model;
    gtkw_writer_t *gtkw;
-   FILE          *vcdfile;
-   char          *tmpfst;
+   vcd_writer_t  *vcd;
    uint64_t       last_time;
+   data_array_t   data;
+   bool           enabled;
+   uint64_t       start_time;
+   uint64_t       stop_time;
 } wave_dumper_t;
 
-static glob_array_t incl;
-static glob_array_t excl;
+static glob_set_t     incl;
+static glob_set_t     excl;
+static wave_dumper_t *active_dumper;
+static fst_map_fn_t   map_chars_fn;
+
+// Character maps are padded to sixteen entries so they can be used
+// directly as a byte shuffle lookup table
+static const char ulogic_map[16] = "UX01ZWLH-";
+static const char bit_map[16] = "01";
 
 static void fst_process_signal(wave_dumper_t *wd, rt_scope_t *scope, tree_t d,
                                tree_t cons, text_buf_t *tb);
 static bool wave_should_dump(ident_t name);
+static bool wave_may_dump_scope(ident_t hpath);
 
-static void fst_close(rt_model_t *m, void *arg)
+static void wave_emit_time_change(wave_dumper_t *wd, uint64_t now)
 {
-   wave_dumper_t *wd = arg;
-
-   fstWriterEmitTimeChange(wd->fst_ctx, model_now(m, NULL));
-   fstWriterClose(wd->fst_ctx);
+   if (wd->vcd != NULL)
+      vcd_emit_time_change(wd->vcd, now);
+   else
+      fstWriterEmitTimeChange(wd->fst_ctx, now);
+}
 
-   if (wd->vcdfile) {
-      void *xc = fstReaderOpen(wd->tmpfst);
-      if (xc == NULL)
-         fatal("fstReaderOpen failed for temporary FST file");
+static void wave_emit_value_change(wave_dumper_t *wd, fstHandle handle,
+                                   const void *val)
+{
+   if (wd->vcd != NULL)
+      vcd_emit_value_change(wd->vcd, handle, val);
+   else
+      fstWriterEmitValueChange(wd->fst_ctx, handle, val);
+}
 
-      fstReaderSetVcdExtensions(xc, 1);
-      if (!fstReaderProcessHier(xc, wd->vcdfile))
-         fatal("fstReaderProcessHier failed");
+static void wave_emit_variable_length_value_change(wave_dumper_t *wd,
+                                                   fstHandle handle,
+                                                   const void *val,
+                                                   uint32_t len)
+{
+   if (wd->vcd != NULL)
+      vcd_emit_variable_length_value_change(wd->vcd, handle, val, len);
+   else
+      fstWriterEmitVariableLengthValueChange(wd->fst_ctx, handle, val, len);
+}
 
-      fstReaderSetFacProcessMaskAll(xc);
-      fstReaderIterBlocks(xc, NULL, NULL, wd->vcdfile);
+static fstHandle wave_create_var(wave_dumper_t *wd, fst_type_t *ft,
+                                 enum fstVarDir dir, uint32_t len,
+                                 const char *name, type_t type)
+{
+   if (wd->vcd != NULL)
+      return vcd_create_var(wd->vcd, ft->vartype, len, name);
+   else
+      return fstWriterCreateVar2(wd->fst_ctx, ft->vartype, dir, len, name, 0,
+                                 type_pp(type), FST_SVT_VHDL_SIGNAL, ft->sdt);
+}
 
-      fstReaderClose(xc);
-      fclose(wd->vcdfile);
-      wd->vcdfile = NULL;
+static void wave_set_scope(wave_dumper_t *wd, enum fstScopeType st,
+                           const char *name)
+{
+   if (wd->vcd != NULL)
+      vcd_set_scope(wd->vcd, st, name);
+   else
+      fstWriterSetScope(wd->fst_ctx, st, name, "");
+}
 
-      if (unlink(wd->tmpfst) != 0)
-         fatal_errno("unlink: %s", wd->tmpfst);
+static void wave_set_upscope(wave_dumper_t *wd)
+{
+   if (wd->vcd != NULL)
+      vcd_set_upscope(wd->vcd);
+   else
+      fstWriterSetUpscope(wd->fst_ctx);
+}
 
-#if !defined __CYGWIN__ && !defined __MINGW32__
-      char *tmpdir = dirname(wd->tmpfst);
-      if (rmdir(tmpdir) != 0)
-         fatal_errno("unlink: %s", tmpdir);
-#endif
+static void fst_close(rt_model_t *m, void *arg)
+{
+   wave_dumper_t *wd = arg;
 
-      free(wd->tmpfst);
-      wd->tmpfst = NULL;
+   if (wd->vcd != NULL) {
+      vcd_writer_close(wd->vcd, model_now(m, NULL));
+      wd->vcd = NULL;
+   }
+   else {
+      fstWriterEmitTimeChange(wd->fst_ctx, model_now(m, NULL));
+      fstWriterClose(wd->fst_ctx);
+      wd->fst_ctx = NULL;
    }
 
-   wd->fst_ctx = NULL;
-   wd->model   = NULL;
+   wd->model = NULL;
+
+   if (active_dumper == wd)
+      active_dumper = NULL;
 }
 
 static void fst_fmt_int(rt_watch_t *w, fst_data_t *data)
@@ -158,14 +215,14 @@ static void fst_fmt_int(rt_watch_t *w, fst_data_t *data)
          buf[data->type->size - 1 - j] = (val[i] & (1 << j)) ? '1' : '0';
       buf[data->type->size] = '\0';
 
-      fstWriterEmitValueChange(data->dumper->fst_ctx, data->handle[i], buf);
+      wave_emit_value_change(data->dumper, data->handle[i], buf);
    }
 }
 
 static void fst_fmt_real(rt_watch_t *w, fst_data_t *data)
 {
    const void *buf = signal_value(data->signal);
-   fstWriterEmitValueChange(data->dumper->fst_ctx, data->handle[0], buf);
+   wave_emit_value_change(data->dumper, data->handle[0], buf);
 }
 
 static void fst_fmt_physical(rt_watch_t *w, fst_data_t *data)
@@ -181,9 +238,42 @@ static void fst_fmt_physical(rt_watch_t *w, fst_data_t *data)
    checked_sprintf(buf, sizeof(buf), "%"PRIi64" %s",
                    val / unit->mult, unit->name);
 
-   fstWriterEmitVariableLengthValueChange(
-      data->dumper->fst_ctx, data->handle[0], buf, strlen(buf));
+   wave_emit_variable_length_value_change(data->dumper, data->handle[0],
+                                          buf, strlen(buf));
+}
+
+static void fst_map_chars(char *out, const uint8_t *in, size_t len,
+                          const char *map)
+{
+   for (size_t i = 0; i < len; i++)
+      out[i] = map[in[i]];
+}
+
+#ifdef HAVE_AVX2
+__attribute__((target("avx2")))
+static void fst_map_chars_avx2(char *out, const uint8_t *in, size_t len,
+                               const char *map)
+{
+   // Each enumeration value is less than sixteen so the low four bits
+   // of each byte index the map in both 128-bit lanes
+   const __m128i table128 = _mm_loadu_si128((const __m128i *)map);
+   const __m256i table = _mm256_broadcastsi128_si256(table128);
+
+   size_t i = 0;
+   for (; i + 32 <= len; i += 32) {
+      const __m256i v = _mm256_loadu_si256((const __m256i *)(in + i));
+      _mm256_storeu_si256((__m256i *)(out + i), _mm256_shuffle_epi8(table, v));
+   }
+
+   if (i + 16 <= len) {
+      const __m128i v = _mm_loadu_si128((const __m128i *)(in + i));
+      _mm_storeu_si128((__m128i *)(out + i), _mm_shuffle_epi8(table128, v));
+      i += 16;
+   }
+
+   fst_map_chars(out + i, in + i, len - i, map);
 }
+#endif
 
 static void fst_fmt_chars(rt_watch_t *w, fst_data_t *data)
 {
@@ -191,13 +281,12 @@ static void fst_fmt_chars(rt_watch_t *w, fst_data_t *data)
    for (int i = 0; i < data->count; i++, p += data->size) {
       if (likely(data->type->u.map != NULL)) {
          char buf[data->size];
-         for (int j = 0; j < data->size; j++)
-            buf[j] = data->type->u.map[p[j]];
-         fstWriterEmitValueChange(data->dumper->fst_ctx, data->handle[i], buf);
+         (*map_chars_fn)(buf, p, data->size, data->type->u.map);
+         wave_emit_value_change(data->dumper, data->handle[i], buf);
       }
       else
-         fstWriterEmitVariableLengthValueChange(
-            data->dumper->fst_ctx, data->handle[i], p, data->size);
+         wave_emit_variable_length_value_change(data->dumper, data->handle[i],
+                                                p, data->size);
    }
 }
 
@@ -210,10 +299,8 @@ static void fst_fmt_enum(rt_watch_t *w, fst_data_t *data)
    assert(val < e->count);
 
    const char *literal = e->strings + val * e->size;
-   fstWriterEmitVariableLengthValueChange(data->dumper->fst_ctx,
-                                          data->handle[0],
-                                          literal,
-                                          strnlen(literal, e->size));
+   wave_emit_variable_length_value_change(data->dumper, data->handle[0],
+                                          literal, strnlen(literal, e->size));
 }
 
 static void fst_event_cb(uint64_t now, rt_signal_t *s, rt_watch_t *w,
@@ -221,8 +308,11 @@ static void fst_event_cb(uint64_t now, rt_signal_t *s, rt_watch_t *w,
 {
    fst_data_t *data = user;
 
+   if (unlikely(!data->dumper->enabled))
+      return;   // Callback was already queued when dumping was disabled
+
    if (now != data->dumper->last_time) {
-      fstWriterEmitTimeChange(data->dumper->fst_ctx, now);
+      wave_emit_time_change(data->dumper, now);
       data->dumper->last_time = now;
    }
 
@@ -305,7 +395,7 @@ static fst_type_t *fst_type_for(type_t type, const loc_t *loc)
             ft->sdt     = FST_SDT_VHDL_STD_ULOGIC;
             ft->vartype = FST_VT_SV_LOGIC;
             ft->fn      = fst_fmt_chars;
-            ft->u.map   = "UX01ZWLH-";
+            ft->u.map   = ulogic_map;
             ft->size    = 1;
             break;
 
@@ -313,7 +403,7 @@ static fst_type_t *fst_type_for(type_t type, const loc_t *loc)
             ft->sdt     = FST_SDT_VHDL_BIT;
             ft->vartype = FST_VT_SV_LOGIC;
             ft->fn      = fst_fmt_chars;
-            ft->u.map   = "01";
+            ft->u.map   = bit_map;
             ft->size    = 1;
             break;
 
@@ -501,19 +591,12 @@ static void fst_create_array_var(wave_dumper_t *wd, tree_t d, rt_signal_t *s,
             tb_printf(tb, "[%d:%d]", msb, lsb);
          tb_downcase(tb);
 
-         data->handle[i] = fstWriterCreateVar2(
-            wd->fst_ctx,
-            ft->vartype,
-            dir,
-            data->size,
-            tb_get(tb),
-            0,
-            type_pp(elem),
-            FST_SVT_VHDL_SIGNAL,
-            ft->sdt);
+         data->handle[i] = wave_create_var(wd, ft, dir, data->size,
+                                           tb_get(tb), elem);
       }
 
-      fstWriterSetAttrEnd(wd->fst_ctx);
+      if (wd->vcd == NULL)
+         fstWriterSetAttrEnd(wd->fst_ctx);
    }
    else {
       fst_type_t *ft = fst_type_for(type, tree_loc(d));
@@ -525,16 +608,8 @@ static void fst_create_array_var(wave_dumper_t *wd, tree_t d, rt_signal_t *s,
       data->size  = (high - low + 1) * ft->size;
       data->count = 1;
 
-      data->handle[0] = fstWriterCreateVar2(
-         wd->fst_ctx,
-         ft->vartype,
-         dir,
-         data->size,
-         tb_get(tb),
-         0,
-         type_pp(type),
-         FST_SVT_VHDL_SIGNAL,
-         ft->sdt);
+      data->handle[0] = wave_create_var(wd, ft, dir, data->size,
+                                        tb_get(tb), type);
 
       if (wd->gtkw != NULL)
          fprintf(wd->gtkw->file, "%s.%s\n", tb_get(wd->gtkw->hier), tb_get(tb));
@@ -547,6 +622,8 @@ static void fst_create_array_var(wave_dumper_t *wd, tree_t d, rt_signal_t *s,
    data->watch  = model_set_event_cb(wd->model, data->signal,
                                      fst_event_cb, data, true);
 
+   APUSH(wd->data, data);
+
    fst_event_cb(0, data->signal, data->watch, data);
 }
 
@@ -578,15 +655,15 @@ static void fst_create_scalar_var(wave_dumper_t *wd, tree_t d, rt_signal_t *s,
    tb_istr(tb, tree_ident(d));
    tb_downcase(tb);
 
-   data->handle[0] = fstWriterCreateVar2(wd->fst_ctx, ft->vartype, dir,
-                                         ft->size, tb_get(tb), 0, type_pp(type),
-                                         FST_SVT_VHDL_SIGNAL, ft->sdt);
+   data->handle[0] = wave_create_var(wd, ft, dir, ft->size, tb_get(tb), type);
 
    data->decl   = d;
    data->signal = s;
    data->watch  = model_set_event_cb(wd->model, data->signal, fst_event_cb,
                                      data, true);
 
+   APUSH(wd->data, data);
+
    fst_event_cb(0, data->signal, data->watch, data);
 
    if (wd->gtkw != NULL)
@@ -601,7 +678,7 @@ static void fst_create_record_var(wave_dumper_t *wd, tree_t d,
    tb_istr(tb, tree_ident(d));
    tb_downcase(tb);
 
-   fstWriterSetScope(wd->fst_ctx, FST_ST_VHDL_RECORD, tb_get(tb), NULL);
+   wave_set_scope(wd, FST_ST_VHDL_RECORD, tb_get(tb));
 
    size_t hlen = 0;
    if (wd->gtkw != NULL) {
@@ -617,7 +694,7 @@ static void fst_create_record_var(wave_dumper_t *wd, tree_t d,
       fst_process_signal(wd, scope, f, cons, tb);
    }
 
-   fstWriterSetUpscope(wd->fst_ctx);
+   wave_set_upscope(wd);
 
    if (wd->gtkw != NULL)
       tb_trim(wd->gtkw->hier, hlen);
@@ -671,15 +748,18 @@ static void fst_process_hier(wave_dumper_t *wd, tree_t h, tree_t block)
       break;
    }
 
-   const loc_t *loc = tree_loc(h);
-   fstWriterSetSourceStem(wd->fst_ctx, loc_file_str(loc), loc->first_line, 1);
+   if (wd->vcd == NULL) {
+      const loc_t *loc = tree_loc(h);
+      fstWriterSetSourceStem(wd->fst_ctx, loc_file_str(loc),
+                             loc->first_line, 1);
+   }
 
    LOCAL_TEXT_BUF tb = tb_new();
    tb_istr(tb, tree_ident(block));
    tb_downcase(tb);
 
    // TODO: store the component name in T_HIER somehow?
-   fstWriterSetScope(wd->fst_ctx, st, tb_get(tb), "");
+   wave_set_scope(wd, st, tb_get(tb));
 
    if (wd->gtkw != NULL) {
       if (tb_len(wd->gtkw->hier) > 0)
@@ -705,7 +785,10 @@ static void fst_walk_design(wave_dumper_t *wd, tree_t block)
 
    LOCAL_TEXT_BUF tb = tb_new();
 
-   const int nports = tree_ports(block);
+   // Skip checking each signal when no include pattern can match
+   const bool any = wave_may_dump_scope(hpath);
+
+   const int nports = any ? tree_ports(block) : 0;
    for (int i = 0; i < nports; i++) {
       tree_t p = tree_port(block, i);
       ident_t path = ident_prefix(hpath, ident_downcase(tree_ident(p)), ':');
@@ -713,7 +796,7 @@ static void fst_walk_design(wave_dumper_t *wd, tree_t block)
          fst_process_signal(wd, scope, p, NULL, tb);
    }
 
-   const int ndecls = tree_decls(block);
+   const int ndecls = any ? tree_decls(block) : 0;
    for (int i = 0; i < ndecls; i++) {
       tree_t d = tree_decl(block, i);
       if (tree_kind(d) == T_SIGNAL_DECL) {
@@ -738,7 +821,7 @@ static void fst_walk_design(wave_dumper_t *wd, tree_t block)
       }
    }
 
-   fstWriterSetUpscope(wd->fst_ctx);
+   wave_set_upscope(wd);
 
    if (wd->gtkw != NULL) {
       const char *h = tb_get(wd->gtkw->hier);
@@ -748,13 +831,67 @@ static void fst_walk_design(wave_dumper_t *wd, tree_t block)
    }
 }
 
+static void wave_dumper_enable(wave_dumper_t *wd, bool enable, uint64_t when)
+{
+   if (wd->enabled == enable || wd->model == NULL)
+      return;
+
+   wd->enabled = enable;
+
+   for (int i = 0; i < wd->data.count; i++)
+      model_enable_event_cb(wd->model, wd->data.items[i]->watch, enable);
+
+   if (enable) {
+      // Changes were not recorded while dumping was disabled so write
+      // out the current value of every signal before resuming
+      for (int i = 0; i < wd->data.count; i++) {
+         fst_data_t *data = wd->data.items[i];
+         fst_event_cb(when, data->signal, data->watch, data);
+      }
+   }
+}
+
+static void wave_time_step_cb(rt_model_t *m, void *arg)
+{
+   wave_dumper_t *wd = arg;
+
+   // Called at the start of each time step before any signals are
+   // updated so the current values are those at the window boundary
+   const uint64_t now = model_now(m, NULL);
+
+   if (wd->start_time > 0 && now >= wd->start_time) {
+      wave_dumper_enable(wd, true, MAX(wd->start_time, wd->last_time));
+      wd->start_time = 0;
+   }
+
+   if (wd->stop_time != TIME_HIGH && now >= wd->stop_time) {
+      wave_dumper_enable(wd, false, now);
+      wd->stop_time = TIME_HIGH;
+   }
+
+   if (wd->start_time > 0 || wd->stop_time != TIME_HIGH)
+      model_set_global_cb(m, RT_NEXT_TIME_STEP, wave_time_step_cb, wd);
+}
+
 void wave_dumper_restart(wave_dumper_t *wd, rt_model_t *m)
 {
    wd->last_time = UINT64_MAX;
    wd->model     = m;
+   wd->enabled   = true;
 
    fst_walk_design(wd, tree_stmt(wd->top, 0));
 
+   if (wd->vcd != NULL)
+      vcd_end_definitions(wd->vcd);
+
+   // The initial values are always written so the waveform has a
+   // defined state up to the start of the window
+   if (wd->start_time > 0)
+      wave_dumper_enable(wd, false, 0);
+
+   if (wd->start_time > 0 || wd->stop_time != TIME_HIGH)
+      model_set_global_cb(m, RT_NEXT_TIME_STEP, wave_time_step_cb, wd);
+
    if (wd->gtkw != NULL) {
       fclose(wd->gtkw->file);
       tb_free(wd->gtkw->hier);
@@ -763,49 +900,46 @@ void wave_dumper_restart(wave_dumper_t *wd, rt_model_t *m)
    }
 
    model_set_global_cb(m, RT_END_OF_SIMULATION, fst_close, wd);
+
+   active_dumper = wd;
 }
 
 wave_dumper_t *wave_dumper_new(const char *file, const char *gtkw_file,
                                tree_t top, wave_format_t format)
 {
    wave_dumper_t *wd = xcalloc(sizeof(wave_dumper_t));
-   wd->top       = top;
-   wd->last_time = UINT64_MAX;
-
-   if (format == WAVE_FORMAT_VCD) {
-#if defined __CYGWIN__ || defined __MINGW32__
-      const char *tmpdir = ".";
+   wd->top        = top;
+   wd->last_time  = UINT64_MAX;
+   wd->start_time = 0;
+   wd->stop_time  = TIME_HIGH;
+
+   if (map_chars_fn == NULL) {
+#ifdef HAVE_AVX2
+      if (__builtin_cpu_supports("avx2"))
+         map_chars_fn = fst_map_chars_avx2;
+      else
+         map_chars_fn = fst_map_chars;
 #else
-      char tmpdir[PATH_MAX] = "/tmp/vcdXXXXXX";
-      checked_sprintf(tmpdir, PATH_MAX, "%s/vcdXXXXXX",
-                      getenv("TMPDIR") ?: "/tmp");
-      if (mkdtemp(tmpdir) == NULL)
-         fatal_errno("mkdtemp");
+      map_chars_fn = fst_map_chars;
 #endif
+   }
 
-      wd->vcdfile = fopen(file, "wb");
-      if (wd->vcdfile == NULL)
+   if (format == WAVE_FORMAT_VCD) {
+      if ((wd->vcd = vcd_writer_new(file, PACKAGE_STRING)) == NULL)
          fatal_errno("%s", file);
-
-      wd->tmpfst  = xasprintf("%s" DIR_SEP "temp.fst", tmpdir);
-      wd->fst_ctx = fstWriterCreate(wd->tmpfst, 1);
    }
    else {
-      wd->vcdfile = NULL;
-      wd->tmpfst  = NULL;
-      wd->fst_ctx = fstWriterCreate(file, 1);
+      if ((wd->fst_ctx = fstWriterCreate(file, 1)) == NULL)
+         fatal("fstWriterCreate failed");
+
+      fstWriterSetFileType(wd->fst_ctx, FST_FT_VHDL);
+      fstWriterSetTimescale(wd->fst_ctx, -15);
+      fstWriterSetVersion(wd->fst_ctx, PACKAGE_STRING);
+      fstWriterSetPackType(wd->fst_ctx, 0);
+      fstWriterSetRepackOnClose(wd->fst_ctx, 1);
+      fstWriterSetParallelMode(wd->fst_ctx, 0);
    }
 
-   if (wd->fst_ctx == NULL)
-      fatal("fstWriterCreate failed");
-
-   fstWriterSetFileType(wd->fst_ctx, FST_FT_VHDL);
-   fstWriterSetTimescale(wd->fst_ctx, -15);
-   fstWriterSetVersion(wd->fst_ctx, PACKAGE_STRING);
-   fstWriterSetPackType(wd->fst_ctx, 0);
-   fstWriterSetRepackOnClose(wd->fst_ctx, 1);
-   fstWriterSetParallelMode(wd->fst_ctx, 0);
-
    if (gtkw_file != NULL) {
       wd->gtkw = xcalloc(sizeof(gtkw_writer_t));
       if ((wd->gtkw->file = fopen(gtkw_file, "w")) == NULL)
@@ -820,17 +954,74 @@ wave_dumper_t *wave_dumper_new(const char *file, const char *gtkw_file,
 
 void wave_dumper_free(wave_dumper_t *wd)
 {
+   if (active_dumper == wd)
+      active_dumper = NULL;
+
+   ACLEAR(wd->data);
    free(wd);
 }
 
+void wave_dumper_set_window(wave_dumper_t *wd, uint64_t start, uint64_t stop)
+{
+   assert(wd->model == NULL);
+   assert(start < stop);
+
+   wd->start_time = start;
+   wd->stop_time  = stop;
+}
+
+bool wave_set_dumping(bool enable)
+{
+   if (active_dumper == NULL)
+      return false;
+
+   const uint64_t now = model_now(active_dumper->model, NULL);
+   wave_dumper_enable(active_dumper, enable, now);
+   return true;
+}
+
+static void glob_set_add(glob_set_t *set, const char *glob)
+{
+   const size_t len = strlen(glob), prefix = strcspn(glob, "*");
+
+   if (prefix == len) {
+      // Patterns without wildcards are checked with a single lookup
+      if (set->exact == NULL)
+         set->exact = hset_new(64);
+      hset_insert(set->exact, ident_new(glob));
+   }
+   else
+      set->nwild++;
+
+   glob_t g = { .text = xstrdup(glob), .len = len, .prefix = prefix };
+   APUSH(set->globs, g);
+}
+
+static bool glob_set_match(glob_set_t *set, ident_t name)
+{
+   if (set->exact != NULL && hset_contains(set->exact, name))
+      return true;
+
+   if (set->nwild == 0)
+      return false;
+
+   for (int i = 0; i < set->globs.count; i++) {
+      const glob_t *g = &(set->globs.items[i]);
+      if (g->prefix < g->len && ident_glob(name, g->text, g->len))
+         return true;
+   }
+
+   return false;
+}
+
 void wave_include_glob(const char *glob)
 {
-   APUSH(incl, ((glob_t){ .text = strdup(glob), .len = strlen(glob) }));
+   glob_set_add(&incl, glob);
 }
 
 void wave_exclude_glob(const char *glob)
 {
-   APUSH(excl, ((glob_t){ .text = strdup(glob), .len = strlen(glob) }));
+   glob_set_add(&excl, glob);
 }
 
 static void wave_process_file(const char *fname, bool include)
@@ -875,15 +1066,29 @@ void wave_include_file(const char *base)
 
 static bool wave_should_dump(ident_t name)
 {
-   for (int i = 0; i < excl.count; i++) {
-      if (ident_glob(name, excl.items[i].text, excl.items[i].len))
-         return false;
-   }
+   if (excl.globs.count > 0 && glob_set_match(&excl, name))
+      return false;
+   else if (incl.globs.count == 0)
+      return true;
+   else
+      return glob_set_match(&incl, name);
+}
+
+static bool wave_may_dump_scope(ident_t hpath)
+{
+   // Every signal name in the scope starts with its path so an include
+   // pattern can only match if its literal prefix is compatible
+   if (incl.globs.count == 0)
+      return true;
+
+   const char *path = istr(hpath);
+   const size_t pathlen = ident_len(hpath);
 
-   for (int i = 0; i < incl.count; i++) {
-      if (ident_glob(name, incl.items[i].text, incl.items[i].len))
+   for (int i = 0; i < incl.globs.count; i++) {
+      const glob_t *g = &(incl.globs.items[i]);
+      if (strncmp(path, g->text, MIN(pathlen, g->prefix)) == 0)
          return true;
    }
 
-   return (incl.count == 0);
+   return false;
 }
@@ -29,6 +29,8 @@ wave_dumper_t *wave_dumper_new(const char *file, const char *gtkw_file,
                                tree_t top, wave_format_t format);
 void wave_dumper_free(wave_dumper_t *wd);
 void wave_dumper_restart(wave_dumper_t *wd, rt_model_t *m);
+void wave_dumper_set_window(wave_dumper_t *wd, uint64_t start, uint64_t stop);
+bool wave_set_dumping(bool enable);
 
 void wave_include_glob(const char *glob);
 void wave_exclude_glob(const char *glob);
@@ -39,24 +39,27 @@ typedef struct {
 
 typedef A(cond_state_t) cond_stack_t;
 
-static const char     *file_start;
-static size_t          file_sz;
-static const char     *read_ptr;
-static hdl_kind_t      src_kind;
-static loc_file_ref_t  file_ref = FILE_INVALID;
-static int             colno;
-static int             lineno;
-static int             lookahead;
-static int             pperrors;
-static cond_stack_t    cond_stack;
-static shash_t        *pp_defines;
-
-extern int yylex(void);
+typedef struct {
+   lexer_t        *lexer;
+   const char     *file_start;
+   size_t          file_sz;
+   hdl_kind_t      kind;
+   loc_file_ref_t  file_ref;
+   int             lookahead;
+   int             pperrors;
+   cond_stack_t    cond_stack;
+} scan_ctx_t;
+
+// The parsers call processed_yylex without any context so the state for
+// the current input file is reached through this pointer
+static scan_ctx_t *scan = NULL;
+
+// Definitions from the command line apply to every file
+static shash_t *pp_defines = NULL;
+
 extern yylval_t yylval;
 extern loc_t yylloc;
 
-extern void reset_scanner(void);
-
 static bool pp_cond_analysis_expr(void);
 static void pp_defines_init();
 
@@ -65,6 +68,15 @@ yylval_t yylval;
 loc_t yylloc;
 #endif
 
+static void scan_ctx_free(scan_ctx_t *ctx)
+{
+   // The file contents are not released as diagnostics may still refer
+   // to them through the loc_file_ref
+   lexer_free(ctx->lexer);
+   ACLEAR(ctx->cond_stack);
+   free(ctx);
+}
+
 void input_from_file(const char *file)
 {
    pp_defines_init();
@@ -78,6 +90,8 @@ void input_from_file(const char *file)
          fatal_errno("opening %s", file);
    }
 
+   scan_ctx_t *ctx = xcalloc(sizeof(scan_ctx_t));
+
    struct stat buf;
    if (fstat(fd, &buf) != 0)
       fatal_errno("fstat");
@@ -88,91 +102,58 @@ void input_from_file(const char *file)
       char *buf = xmalloc(bufsz);
       int nbytes;
       do {
-         if (bufsz - 1 - file_sz == 0)
+         if (bufsz - 1 - ctx->file_sz == 0)
             buf = xrealloc(buf, bufsz *= 2);
 
-         nbytes = read(fd, buf + file_sz, bufsz - 1 - file_sz);
+         nbytes = read(fd, buf + ctx->file_sz, bufsz - 1 - ctx->file_sz);
          if (nbytes < 0)
             fatal_errno("read");
 
-         file_sz += nbytes;
-         buf[file_sz] = '\0';
+         ctx->file_sz += nbytes;
+         buf[ctx->file_sz] = '\0';
       } while (nbytes > 0);
 
-      file_start = buf;
+      ctx->file_start = buf;
    }
    else if (S_ISREG(buf.st_mode)) {
-      file_sz = buf.st_size;
+      ctx->file_sz = buf.st_size;
 
-      if (file_sz > 0)
-         file_start = map_file(fd, file_sz);
-      else
-         file_start = NULL;
+      if (ctx->file_sz > 0)
+         ctx->file_start = map_file(fd, ctx->file_sz);
    }
    else
       fatal("opening %s: not a regular file", file);
 
    close(fd);
 
-   reset_scanner();
-
    size_t len = strlen(file);
    if (len > 2 && file[len - 2] == '.' && file[len - 1] == 'v') {
-      src_kind = SOURCE_VERILOG;
+      ctx->kind = SOURCE_VERILOG;
 #ifdef ENABLE_VERILOG
       reset_verilog_parser();
 #endif
    }
    else {
-      src_kind = SOURCE_VHDL;
+      ctx->kind = SOURCE_VHDL;
       reset_vhdl_parser();
    }
 
    yylloc = LOC_INVALID;
 
-   read_ptr  = file_start;
-   file_ref  = loc_file_ref(file, file_start);
-   lineno    = 1;
-   colno     = 0;
-   lookahead = -1;
-   pperrors  = 0;
-}
+   ctx->file_ref  = loc_file_ref(file, ctx->file_start);
+   ctx->lookahead = -1;
+   ctx->lexer     = lexer_new(ctx->file_start, ctx->file_sz, ctx->file_ref);
 
-hdl_kind_t source_kind(void)
-{
-   return src_kind;
-}
-
-int get_next_char(char *b, int max_buffer)
-{
-   const ptrdiff_t navail = file_start + file_sz - read_ptr;
-   assert(navail >= 0);
-
-   const int nchars = MIN(navail, max_buffer);
+   if (scan != NULL)
+      scan_ctx_free(scan);
 
-   memcpy(b, read_ptr, nchars);
-   read_ptr += nchars;
-
-   return nchars;
+   scan = ctx;
 }
 
-void begin_token(char *tok, int length)
+hdl_kind_t source_kind(void)
 {
-   // Newline must match as a single token for the logic below to work
-   assert(strchr(tok, '\n') == NULL || length == 1);
-
-   const int first_col = colno;
-   if (*tok == '\n') {
-      colno = 0;
-      lineno += 1;
-   }
-   else
-      colno += length;
-
-   const int last_col = first_col + length - 1;
-
-   extern loc_t yylloc;
-   yylloc = get_loc(lineno, first_col, lineno, last_col, file_ref);
+   assert(scan != NULL);
+   return scan->kind;
 }
 
 const char *token_str(token_t tok)
@@ -253,9 +234,13 @@ void pp_defines_add(const char *name, const char *value)
 
 static int pp_yylex(void)
 {
-   const int tok = lookahead != -1 ? lookahead : yylex();
-   lookahead = -1;
-   return tok;
+   if (scan->lookahead != -1) {
+      const int tok = scan->lookahead;
+      scan->lookahead = -1;
+      return tok;
+   }
+   else
+      return lexer_next(scan->lexer, &yylval, &yylloc);
 }
 
 static void pp_error(const char *fmt, ...)
@@ -263,7 +248,7 @@ static void pp_error(const char *fmt, ...)
    va_list ap;
    va_start(ap, fmt);
 
-   if (pperrors++ == 0 || opt_get_int(OPT_UNIT_TEST)) {
+   if (scan->pperrors++ == 0 || opt_get_int(OPT_UNIT_TEST)) {
       diag_t *d = diag_new(DIAG_ERROR, &yylloc);
       diag_vprintf(d, fmt, ap);
       diag_emit(d);
@@ -374,18 +359,18 @@ static bool pp_cond_analysis_expr(void)
    //   | conditional_analysis_relation { xnor conditional_analysis_relation }
 
    const bool lhs = pp_cond_analysis_relation();
-   switch ((lookahead = pp_yylex())) {
+   switch ((scan->lookahead = pp_yylex())) {
    case tAND:
-      lookahead = -1;
+      scan->lookahead = -1;
       return pp_cond_analysis_relation() && lhs;
    case tOR:
-      lookahead = -1;
+      scan->lookahead = -1;
       return pp_cond_analysis_relation() || lhs;
    case tXOR:
-      lookahead = -1;
+      scan->lookahead = -1;
       return pp_cond_analysis_relation() ^ lhs;
    case tXNOR:
-      lookahead = -1;
+      scan->lookahead = -1;
       return !(pp_cond_analysis_relation() ^ lhs);
    default:
       return lhs;
@@ -395,7 +380,9 @@ static bool pp_cond_analysis_expr(void)
 
 token_t processed_yylex(void)
 {
-   assert(lookahead == -1);
+   assert(scan->lookahead == -1);
+
+   cond_stack_t *cond_stack = &(scan->cond_stack);
 
    for (;;) {
       token_t token = pp_yylex();
@@ -405,7 +392,7 @@ token_t processed_yylex(void)
             cond_state_t new = { .loc = yylloc };
             new.result = new.taken = pp_cond_analysis_expr();
 
-            if (cond_stack.count > 0 && !ATOP(cond_stack).result) {
+            if (cond_stack->count > 0 && !ATOP(*cond_stack).result) {
                // Suppress nested conditionals in not-taken branches
                new.taken = true;
                new.result = false;
@@ -418,25 +405,25 @@ token_t processed_yylex(void)
             new.loc.line_delta =
                yylloc.first_line + yylloc.line_delta - new.loc.first_line;
 
-            APUSH(cond_stack, new);
+            APUSH(*cond_stack, new);
          }
          break;
 
       case tCONDELSIF:
          {
-            if (cond_stack.count == 0)
+            if (cond_stack->count == 0)
                pp_error("unexpected $yellow$%s$$ outside conditional "
                         "analysis block", token_str(token));
 
             const bool result = pp_cond_analysis_expr();
 
-            if (cond_stack.count > 0) {
-               if (!ATOP(cond_stack).taken) {
-                  ATOP(cond_stack).result = result;
-                  ATOP(cond_stack).taken = result;
+            if (cond_stack->count > 0) {
+               if (!ATOP(*cond_stack).taken) {
+                  ATOP(*cond_stack).result = result;
+                  ATOP(*cond_stack).taken = result;
                }
                else
-                  ATOP(cond_stack).result = false;
+                  ATOP(*cond_stack).result = false;
             }
 
             pp_expect(tTHEN);
@@ -445,11 +432,11 @@ token_t processed_yylex(void)
 
       case tCONDELSE:
          {
-            if (cond_stack.count == 0)
+            if (cond_stack->count == 0)
                pp_error("unexpected $yellow$%s$$ outside conditional "
                         "analysis block", token_str(token));
             else {
-               cond_state_t *cs = &(cond_stack.items[cond_stack.count - 1]);
+               cond_state_t *cs = &(cond_stack->items[cond_stack->count - 1]);
                cs->result = !(cs->taken);
             }
          }
@@ -457,14 +444,15 @@ token_t processed_yylex(void)
 
       case tCONDEND:
          {
-            if (cond_stack.count == 0)
+            if (cond_stack->count == 0)
                pp_error("unexpected $yellow$%s$$ outside conditional "
                         "analysis block", token_str(token));
             else
-               APOP(cond_stack);
+               APOP(*cond_stack);
 
-            if ((lookahead = yylex()) == tIF)
-               lookahead = -1;
+            scan->lookahead = lexer_next(scan->lexer, &yylval, &yylloc);
+            if (scan->lookahead == tIF)
+               scan->lookahead = -1;
          }
          break;
 
@@ -478,7 +466,7 @@ token_t processed_yylex(void)
                loc.line_delta =
                   yylloc.first_line + yylloc.line_delta - loc.first_line;
 
-               if (cond_stack.count == 0 || ATOP(cond_stack).result) {
+               if (cond_stack->count == 0 || ATOP(*cond_stack).result) {
                   const diag_level_t level =
                      token == tCONDWARN ? DIAG_WARN : DIAG_ERROR;
                   diag_t *d = diag_new(level, &loc);
@@ -492,17 +480,35 @@ token_t processed_yylex(void)
          break;
 
       case tEOF:
-         while (cond_stack.count > 0) {
-            error_at(&(ATOP(cond_stack).loc), "unterminated conditional "
+         while (cond_stack->count > 0) {
+            error_at(&(ATOP(*cond_stack).loc), "unterminated conditional "
                      "analysis block");
-            APOP(cond_stack);
+            APOP(*cond_stack);
          }
          return tEOF;
 
       default:
-         if (cond_stack.count == 0 || ATOP(cond_stack).result)
+         if (cond_stack->count == 0 || ATOP(*cond_stack).result)
             return token;
          break;
       }
    }
 }
+
+void scan_as_psl(void)
+{
+   if (scan != NULL)
+      lexer_set_mode(scan->lexer, LEX_PSL);
+}
+
+void scan_as_vhdl(void)
+{
+   if (scan != NULL)
+      lexer_set_mode(scan->lexer, LEX_VHDL);
+}
+
+void scan_as_verilog(void)
+{
+   if (scan != NULL)
+      lexer_set_mode(scan->lexer, LEX_VERILOG);
+}
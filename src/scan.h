@@ -19,6 +19,7 @@
 #define _SCAN_H
 
 #include "prim.h"
+#include "diag.h"
 
 typedef struct _node_list node_list_t;
 typedef struct { ident_t left, right; } ident_pair_t;
@@ -51,10 +52,16 @@ void scan_as_psl(void);
 void scan_as_vhdl(void);
 void scan_as_verilog(void);
 
-// Private interface to Flex scanners
+// Private interface to the lexer
 
-void begin_token(char *tok, int length);
-int get_next_char(char *b, int max_buffer);
+typedef struct _lexer lexer_t;
+
+typedef enum { LEX_VHDL, LEX_PSL, LEX_VERILOG } lex_mode_t;
+
+lexer_t *lexer_new(const char *text, size_t len, loc_file_ref_t file_ref);
+void lexer_free(lexer_t *lex);
+void lexer_set_mode(lexer_t *lex, lex_mode_t mode);
+token_t lexer_next(lexer_t *lex, yylval_t *lval, loc_t *lloc);
 
 void reset_vhdl_parser(void);
 void reset_verilog_parser(void);
@@ -201,6 +201,7 @@ typedef enum {
    MAIN_THREAD,
    USER_THREAD,
    WORKER_THREAD,
+   HELPER_THREAD,
 } thread_kind_t;
 
 struct _nvc_thread {
@@ -246,6 +247,13 @@ static stop_world_fn_t  stop_callback = NULL;
 static void            *stop_arg = NULL;
 static pthread_cond_t   wake_workers = PTHREAD_COND_INITIALIZER;
 static pthread_mutex_t  wakelock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   wake_helpers = PTHREAD_COND_INITIALIZER;
+static int              num_helpers = 0;
+static unsigned         helper_epoch = 0;
+static int              helper_active = 0;
+static int              helper_pending = 0;
+static task_fn_t        helper_fn = NULL;
+static void            *helper_context = NULL;
 #ifdef POSIX_SUSPEND
 static sem_t            stop_sem;
 #endif
@@ -312,6 +320,7 @@ static void join_worker_threads(void)
    {
       atomic_store(&should_stop, true);
       PTHREAD_CHECK(pthread_cond_broadcast, &wake_workers);
+      PTHREAD_CHECK(pthread_cond_broadcast, &wake_helpers);
    }
    PTHREAD_CHECK(pthread_mutex_unlock, &wakelock);
 
@@ -320,6 +329,7 @@ static void join_worker_threads(void)
 
       switch (relaxed_load(&t->kind)) {
       case WORKER_THREAD:
+      case HELPER_THREAD:
          thread_join(t);
          continue;  // Freed thread struct
       case USER_THREAD:
@@ -376,17 +386,28 @@ static void unmask_fatal_signals(sigset_t *mask)
 }
 #endif
 
-#ifdef __APPLE__
-static void reset_mach_ports(void)
+#ifndef __MINGW32__
+static void reset_after_fork(void)
 {
+   // Only the thread that called fork exists in the child process so
+   // forget about the others: the caller must ensure they were idle
    for (int i = 0; i < MAX_THREADS; i++) {
       nvc_thread_t *t = atomic_load(&(threads[i]));
       if (t == NULL)
          continue;
+      else if (t != my_thread) {
+         atomic_store(&(threads[i]), NULL);
+         continue;
+      }
 
+#ifdef __APPLE__
       // Mach ports are not valid after fork
       t->port = pthread_mach_thread_np(t->handle);
+#endif
    }
+
+   atomic_store(&running_threads, 1);
+   num_helpers = 0;
 }
 #endif
 
@@ -399,7 +420,10 @@ void thread_init(void)
 
 #ifdef __APPLE__
    my_thread->port = pthread_mach_thread_np(my_thread->handle);
-   pthread_atfork(NULL, NULL, reset_mach_ports);
+#endif
+
+#ifndef __MINGW32__
+   pthread_atfork(NULL, NULL, reset_after_fork);
 #endif
 
    assert(my_thread->id == 0);
@@ -1123,6 +1147,83 @@ void async_free(void *ptr)
    }
 }
 
+static void *helper_thread(void *arg)
+{
+   const int index = (intptr_t)arg;
+   unsigned epoch = 0;
+
+   for (;;) {
+      task_fn_t fn = NULL;
+      void *context = NULL;
+
+      PTHREAD_CHECK(pthread_mutex_lock, &wakelock);
+      {
+         while (epoch == helper_epoch && !relaxed_load(&should_stop))
+            PTHREAD_CHECK(pthread_cond_wait, &wake_helpers, &wakelock);
+
+         epoch = helper_epoch;
+
+         if (index <= helper_active) {
+            fn = helper_fn;
+            context = helper_context;
+         }
+      }
+      PTHREAD_CHECK(pthread_mutex_unlock, &wakelock);
+
+      if (relaxed_load(&should_stop))
+         break;
+      else if (fn != NULL) {
+         (*fn)(context, (void *)(intptr_t)index);
+         atomic_add(&helper_pending, -1);
+      }
+   }
+
+   return NULL;
+}
+
+void helper_parallel_do(task_fn_t fn, void *context, int count)
+{
+   assert_lock_held(&stop_lock);
+
+   const int nhelpers = MIN(count, max_workers) - 1;
+
+   // Helper threads are created here rather than with thread_create
+   // as the caller holds the stop lock
+   for (; num_helpers < nhelpers; num_helpers++) {
+      char *name = xasprintf("helper thread %d", num_helpers + 1);
+      nvc_thread_t *thread =
+         thread_new(helper_thread, (void *)(intptr_t)(num_helpers + 1),
+                    HELPER_THREAD, name);
+
+      PTHREAD_CHECK(pthread_create, &(thread->handle), NULL,
+                    thread_wrapper, thread);
+
+#ifdef __APPLE__
+      thread->port = pthread_mach_thread_np(thread->handle);
+#endif
+   }
+
+   if (nhelpers > 0) {
+      atomic_store(&helper_pending, nhelpers);
+
+      PTHREAD_CHECK(pthread_mutex_lock, &wakelock);
+      {
+         helper_fn      = fn;
+         helper_context = context;
+         helper_active  = nhelpers;
+         helper_epoch++;
+
+         PTHREAD_CHECK(pthread_cond_broadcast, &wake_helpers);
+      }
+      PTHREAD_CHECK(pthread_mutex_unlock, &wakelock);
+   }
+
+   (*fn)(context, (void *)(intptr_t)0);
+
+   while (atomic_load(&helper_pending) > 0)
+      progressive_backoff();
+}
+
 #ifdef POSIX_SUSPEND
 static void suspend_handler(int sig, siginfo_t *info, void *context)
 {
@@ -1171,6 +1272,8 @@ void stop_world(stop_world_fn_t callback, void *arg)
       nvc_thread_t *thread = atomic_load(&threads[i]);
       if (thread == NULL || thread == my_thread)
          continue;
+      else if (thread->kind == HELPER_THREAD)
+         continue;   // Helpers are never suspended
 
       HANDLE h = pthread_gethandle(thread->handle);
       if (SuspendThread(h) != 0)
@@ -1192,6 +1295,8 @@ void stop_world(stop_world_fn_t callback, void *arg)
       nvc_thread_t *thread = atomic_load(&threads[i]);
       if (thread == NULL || thread == my_thread)
          continue;
+      else if (thread->kind == HELPER_THREAD)
+         continue;   // Helpers are never suspended
 
       assert(thread->port != MACH_PORT_NULL);
 
@@ -1240,6 +1345,8 @@ void stop_world(stop_world_fn_t callback, void *arg)
       nvc_thread_t *thread = atomic_load(&threads[i]);
       if (thread == NULL || thread == my_thread)
          continue;
+      else if (thread->kind == HELPER_THREAD)
+         continue;   // Helpers are never suspended
 
       PTHREAD_CHECK(pthread_kill, thread->handle, SIGSUSPEND);
       signalled++;
@@ -1276,6 +1383,8 @@ void start_world(void)
       nvc_thread_t *thread = atomic_load(&threads[i]);
       if (thread == NULL || thread == my_thread)
          continue;
+      else if (thread->kind == HELPER_THREAD)
+         continue;   // Helpers are never suspended
 
       HANDLE h = pthread_gethandle(thread->handle);
       if (ResumeThread(h) != 1)
@@ -1286,6 +1395,8 @@ void start_world(void)
       nvc_thread_t *thread = atomic_load(&threads[i]);
       if (thread == NULL || thread == my_thread)
          continue;
+      else if (thread->kind == HELPER_THREAD)
+         continue;   // Helpers are never suspended
 
       kern_return_t kern_result;
       do {
@@ -1303,6 +1414,8 @@ void start_world(void)
       nvc_thread_t *thread = atomic_load(&threads[i]);
       if (thread == NULL || thread == my_thread)
          continue;
+      else if (thread->kind == HELPER_THREAD)
+         continue;   // Helpers are never suspended
 
       PTHREAD_CHECK(pthread_kill, thread->handle, SIGRESUME);
       signalled++;
@@ -42,6 +42,7 @@
 #define relaxed_fetch_add(p, n) __atomic_fetch_add((p), (n), __ATOMIC_RELAXED)
 #define relaxed_load(p) __atomic_load_n((p), __ATOMIC_RELAXED)
 #define relaxed_store(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define relaxed_fetch_or(p, v) __atomic_fetch_or((p), (v), __ATOMIC_RELAXED)
 
 #define store_release(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
 #define load_acquire(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
@@ -111,6 +112,11 @@ typedef void (*stop_world_fn_t)(int, struct cpu_state *, void *);
 void stop_world(stop_world_fn_t callback, void *arg);
 void start_world(void);
 
+// Run FN on the calling thread and up to COUNT - 1 helper threads
+// which are not suspended by stop_world: the second argument is the
+// index of the thread
+void helper_parallel_do(task_fn_t fn, void *context, int count);
+
 typedef enum { WX_WRITE, WX_EXECUTE } wx_mode_t;
 void thread_wx_mode(wx_mode_t mode);
 
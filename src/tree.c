@@ -488,9 +488,9 @@ static inline tree_t tree_array_nth(item_t *item, unsigned n)
    return container_of(o, struct _tree, object);
 }
 
-static inline void tree_array_add(item_t *item, tree_t t)
+static inline void tree_array_add(object_t *owner, item_t *item, tree_t t)
 {
-   obj_array_add(&(item->obj_array), &(t->object));
+   obj_array_add(&(item->obj_array), owner, &(t->object));
 }
 
 tree_t tree_new(tree_kind_t kind)
@@ -573,7 +573,7 @@ tree_t tree_port(tree_t t, unsigned n)
 void tree_add_port(tree_t t, tree_t d)
 {
    tree_assert_decl(d);
-   tree_array_add(lookup_item(&tree_object, t, I_PORTS), d);
+   tree_array_add(&(t->object), lookup_item(&tree_object, t, I_PORTS), d);
    object_write_barrier(&(t->object), &(d->object));
 }
 
@@ -603,7 +603,7 @@ tree_t tree_generic(tree_t t, unsigned n)
 void tree_add_generic(tree_t t, tree_t d)
 {
    assert(d->object.kind == T_GENERIC_DECL);
-   tree_array_add(lookup_item(&tree_object, t, I_GENERICS), d);
+   tree_array_add(&(t->object), lookup_item(&tree_object, t, I_GENERICS), d);
    object_write_barrier(&(t->object), &(d->object));
 }
 
@@ -641,7 +641,7 @@ tree_t tree_param(tree_t t, unsigned n)
 void tree_add_param(tree_t t, tree_t e)
 {
    assert(e->object.kind == T_PARAM);
-   tree_array_add(lookup_item(&tree_object, t, I_PARAMS), e);
+   tree_array_add(&(t->object), lookup_item(&tree_object, t, I_PARAMS), e);
    object_write_barrier(&(t->object), &(e->object));
 }
 
@@ -659,7 +659,7 @@ tree_t tree_genmap(tree_t t, unsigned n)
 
 void tree_add_genmap(tree_t t, tree_t e)
 {
-   tree_array_add(lookup_item(&tree_object, t, I_GENMAPS), e);
+   tree_array_add(&(t->object), lookup_item(&tree_object, t, I_GENMAPS), e);
 }
 
 void tree_trim_genmaps(tree_t t, unsigned n)
@@ -770,7 +770,7 @@ tree_t tree_char(tree_t t, unsigned n)
 
 void tree_add_char(tree_t t, tree_t ref)
 {
-   tree_array_add(lookup_item(&tree_object, t, I_CHARS), ref);
+   tree_array_add(&(t->object), lookup_item(&tree_object, t, I_CHARS), ref);
    object_write_barrier(&(t->object), &(ref->object));
 }
 
@@ -788,7 +788,7 @@ tree_t tree_part(tree_t t, unsigned n)
 
 void tree_add_part(tree_t t, tree_t ref)
 {
-   tree_array_add(lookup_item(&tree_object, t, I_PARTS), ref);
+   tree_array_add(&(t->object), lookup_item(&tree_object, t, I_PARTS), ref);
    object_write_barrier(&(t->object), &(ref->object));
 }
 
@@ -840,7 +840,7 @@ tree_t tree_decl(tree_t t, unsigned n)
 void tree_add_decl(tree_t t, tree_t d)
 {
    tree_assert_decl(d);
-   tree_array_add(lookup_item(&tree_object, t, I_DECLS), d);
+   tree_array_add(&(t->object), lookup_item(&tree_object, t, I_DECLS), d);
    object_write_barrier(&(t->object), &(d->object));
 }
 
@@ -859,7 +859,7 @@ tree_t tree_stmt(tree_t t, unsigned n)
 void tree_add_stmt(tree_t t, tree_t s)
 {
    assert(s != NULL);
-   tree_array_add(lookup_item(&tree_object, t, I_STMTS), s);
+   tree_array_add(&(t->object), lookup_item(&tree_object, t, I_STMTS), s);
    object_write_barrier(&(t->object), &(s->object));
 }
 
@@ -878,7 +878,7 @@ tree_t tree_waveform(tree_t t, unsigned n)
 void tree_add_waveform(tree_t t, tree_t w)
 {
    assert(w->object.kind == T_WAVEFORM);
-   tree_array_add(lookup_item(&tree_object, t, I_WAVES), w);
+   tree_array_add(&(t->object), lookup_item(&tree_object, t, I_WAVES), w);
    object_write_barrier(&(t->object), &(w->object));
 }
 
@@ -897,7 +897,7 @@ tree_t tree_cond(tree_t t, unsigned n)
 void tree_add_cond(tree_t t, tree_t c)
 {
    assert(c->object.kind == T_COND_STMT || c->object.kind == T_COND_EXPR);
-   tree_array_add(lookup_item(&tree_object, t, I_CONDS), c);
+   tree_array_add(&(t->object), lookup_item(&tree_object, t, I_CONDS), c);
    object_write_barrier(&(t->object), &(c->object));
 }
 
@@ -935,7 +935,7 @@ tree_t tree_trigger(tree_t t, unsigned n)
 void tree_add_trigger(tree_t t, tree_t s)
 {
    tree_assert_expr(s);
-   tree_array_add(lookup_item(&tree_object, t, I_TRIGGERS), s);
+   tree_array_add(&(t->object), lookup_item(&tree_object, t, I_TRIGGERS), s);
    object_write_barrier(&(t->object), &(s->object));
 }
 
@@ -1006,7 +1006,7 @@ void tree_add_context(tree_t t, tree_t ctx)
 {
    assert(ctx->object.kind == T_USE || ctx->object.kind == T_LIBRARY
           || ctx->object.kind == T_CONTEXT_REF);
-   tree_array_add(lookup_item(&tree_object, t, I_CONTEXT), ctx);
+   tree_array_add(&(t->object), lookup_item(&tree_object, t, I_CONTEXT), ctx);
    object_write_barrier(&(t->object), &(ctx->object));
 }
 
@@ -1025,7 +1025,7 @@ tree_t tree_pragma(tree_t t, unsigned n)
 void tree_add_pragma(tree_t t, tree_t p)
 {
    assert(p->object.kind == T_PRAGMA);
-   tree_array_add(lookup_item(&tree_object, t, I_PRAGMAS), p);
+   tree_array_add(&(t->object), lookup_item(&tree_object, t, I_PRAGMAS), p);
    object_write_barrier(&(t->object), &(p->object));
 }
 
@@ -1044,7 +1044,7 @@ tree_t tree_assoc(tree_t t, unsigned n)
 void tree_add_assoc(tree_t t, tree_t a)
 {
    assert(a->object.kind == T_ASSOC);
-   tree_array_add(lookup_item(&tree_object, t, I_ASSOCS), a);
+   tree_array_add(&(t->object), lookup_item(&tree_object, t, I_ASSOCS), a);
    object_write_barrier(&(t->object), &(a->object));
 }
 
@@ -1083,7 +1083,7 @@ void tree_set_message(tree_t t, tree_t m)
 
 void tree_add_range(tree_t t, tree_t r)
 {
-   tree_array_add(lookup_item(&tree_object, t, I_RANGES), r);
+   tree_array_add(&(t->object), lookup_item(&tree_object, t, I_RANGES), r);
    object_write_barrier(&(t->object), &(r->object));
 }
 
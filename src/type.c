@@ -112,9 +112,9 @@ static inline tree_t tree_array_nth(item_t *item, unsigned n)
    return container_of(o, struct _tree, object);
 }
 
-static inline void tree_array_add(item_t *item, tree_t t)
+static inline void tree_array_add(object_t *owner, item_t *item, tree_t t)
 {
-   obj_array_add(&(item->obj_array), &(t->object));
+   obj_array_add(&(item->obj_array), owner, &(t->object));
 }
 
 static inline type_t type_array_nth(item_t *item, unsigned n)
@@ -123,9 +123,9 @@ static inline type_t type_array_nth(item_t *item, unsigned n)
    return container_of(o, struct _type, object);
 }
 
-static inline void type_array_add(item_t *item, type_t t)
+static inline void type_array_add(object_t *owner, item_t *item, type_t t)
 {
-   obj_array_add(&(item->obj_array), &(t->object));
+   obj_array_add(&(item->obj_array), owner, &(t->object));
 }
 
 type_t type_new(type_kind_t kind)
@@ -301,7 +301,7 @@ tree_t type_dim(type_t t, unsigned n)
 
 void type_add_dim(type_t t, tree_t r)
 {
-   tree_array_add(lookup_item(&type_object, t, I_DIMS), r);
+   tree_array_add(&(t->object), lookup_item(&type_object, t, I_DIMS), r);
    object_write_barrier(&(t->object), &(r->object));
 }
 
@@ -367,7 +367,7 @@ tree_t type_unit(type_t t, unsigned n)
 
 void type_add_unit(type_t t, tree_t u)
 {
-   tree_array_add(lookup_item(&type_object, t, I_UNITS), u);
+   tree_array_add(&(t->object), lookup_item(&type_object, t, I_UNITS), u);
    object_write_barrier(&(t->object), &(u->object));
 }
 
@@ -386,7 +386,7 @@ tree_t type_enum_literal(type_t t, unsigned n)
 void type_enum_add_literal(type_t t, tree_t lit)
 {
    assert(tree_kind(lit) == T_ENUM_LIT);
-   tree_array_add(lookup_item(&type_object, t, I_LITERALS), lit);
+   tree_array_add(&(t->object), lookup_item(&type_object, t, I_LITERALS), lit);
    object_write_barrier(&(t->object), &(lit->object));
 }
 
@@ -404,7 +404,7 @@ type_t type_param(type_t t, unsigned n)
 
 void type_add_param(type_t t, type_t p)
 {
-   type_array_add(lookup_item(&type_object, t, I_PARAMS), p);
+   type_array_add(&(t->object), lookup_item(&type_object, t, I_PARAMS), p);
    object_write_barrier(&(t->object), &(p->object));
 }
 
@@ -431,7 +431,7 @@ tree_t type_field(type_t t, unsigned n)
 void type_add_field(type_t t, tree_t p)
 {
    assert(p->object.kind == T_FIELD_DECL);
-   tree_array_add(lookup_item(&type_object, t, I_FIELDS), p);
+   tree_array_add(&(t->object), lookup_item(&type_object, t, I_FIELDS), p);
    object_write_barrier(&(t->object), &(p->object));
 }
 
@@ -449,7 +449,7 @@ tree_t type_decl(type_t t, unsigned n)
 
 void type_add_decl(type_t t, tree_t p)
 {
-   tree_array_add(lookup_item(&type_object, t, I_DECLS), p);
+   tree_array_add(&(t->object), lookup_item(&type_object, t, I_DECLS), p);
    object_write_barrier(&(t->object), &(p->object));
 }
 
@@ -474,7 +474,7 @@ unsigned type_index_constrs(type_t t)
 
 void type_add_index_constr(type_t t, type_t c)
 {
-   type_array_add(lookup_item(&type_object, t, I_INDEXCON), c);
+   type_array_add(&(t->object), lookup_item(&type_object, t, I_INDEXCON), c);
    object_write_barrier(&(t->object), &(c->object));
 }
 
@@ -493,7 +493,7 @@ unsigned type_constraints(type_t t)
 void type_add_constraint(type_t t, tree_t c)
 {
    assert(c->object.kind == T_CONSTRAINT);
-   tree_array_add(lookup_item(&type_object, t, I_CONSTR), c);
+   tree_array_add(&(t->object), lookup_item(&type_object, t, I_CONSTR), c);
    object_write_barrier(&(t->object), &(c->object));
 }
 
@@ -116,6 +116,7 @@ typedef void (*print_fn_t)(const char *fmt, ...);
 static char *ansi_vasprintf(const char *fmt, va_list ap, bool force_plain);
 
 typedef struct _fault_handler fault_handler_t;
+typedef struct _guard_handler guard_handler_t;
 
 struct color_escape {
    const char *name;
@@ -134,6 +135,12 @@ struct _fault_handler {
    void            *context;
 };
 
+struct _guard_handler {
+   guard_handler_t *next;
+   guard_fn_t       fn;
+   void            *context;
+};
+
 static bool             want_color = false;
 static bool             want_links = false;
 static bool             want_utf8 = false;
@@ -142,6 +149,7 @@ static sig_atomic_t     crashing = SIG_ATOMIC_MAX;
 static int              term_width = 0;
 static void            *ctrl_c_arg = NULL;
 static fault_handler_t *fault_handlers = NULL;
+static guard_handler_t *guard_handlers = NULL;
 
 #ifdef __MINGW32__
 static UINT win32_codepage = 0;
@@ -837,6 +845,12 @@ static void signal_handler(int sig, siginfo_t *info, void *context)
          return;
       }
    }
+   else if (sig == SIGSEGV || sig == SIGBUS) {
+      for (guard_handler_t *g = guard_handlers; g; g = g->next) {
+         if ((*g->fn)(info->si_addr, g->context))
+            return;   // Retry the faulting instruction
+      }
+   }
 
 #ifdef __SANITIZE_THREAD__
    abort();
@@ -2026,6 +2040,30 @@ void remove_fault_handler(fault_fn_t fn, void *context)
    fatal_trace("no fault handler for %p with context %p", fn, context);
 }
 
+void add_guard_handler(guard_fn_t fn, void *context)
+{
+   guard_handler_t *h = xmalloc(sizeof(guard_handler_t));
+   h->next    = guard_handlers;
+   h->fn      = fn;
+   h->context = context;
+
+   guard_handlers = h;
+}
+
+void remove_guard_handler(guard_fn_t fn, void *context)
+{
+   for (guard_handler_t **p = &guard_handlers; *p; p = &((*p)->next)) {
+      if ((*p)->fn == fn && (*p)->context == context) {
+         guard_handler_t *tmp = (*p)->next;
+         free(*p);
+         *p = tmp;
+         return;
+      }
+   }
+
+   fatal_trace("no guard handler for %p with context %p", fn, context);
+}
+
 void list_add(ptr_list_t *l, void *item)
 {
    if (*l == NULL) {
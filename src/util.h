@@ -345,6 +345,13 @@ typedef void (*fault_fn_t)(int, void *, struct cpu_state *, void *);
 void add_fault_handler(fault_fn_t fn, void *context);
 void remove_fault_handler(fault_fn_t fn, void *context);
 
+// Called for an access violation before any fault handler: returns
+// true if the fault was resolved and the access should be retried
+typedef bool (*guard_fn_t)(void *, void *);
+
+void add_guard_handler(guard_fn_t fn, void *context);
+void remove_guard_handler(guard_fn_t fn, void *context);
+
 struct cpu_state;
 void capture_registers(struct cpu_state *cpu);
 
@@ -49,7 +49,7 @@ DECLARE_AND_DEFINE_ARRAY(vcode_type);
     || x == VCODE_OP_FCALL || x == VCODE_OP_RESOLUTION_WRAPPER          \
     || x == VCODE_OP_CLOSURE || x == VCODE_OP_PROTECTED_INIT            \
     || x == VCODE_OP_PACKAGE_INIT || x == VCODE_OP_COVER_BRANCH         \
-    || x == VCODE_OP_PROCESS_INIT)
+    || x == VCODE_OP_PROCESS_INIT || x == VCODE_OP_COVER_STMT)
 #define OP_HAS_FUNC(x)                                                  \
    (x == VCODE_OP_FCALL || x == VCODE_OP_PCALL || x == VCODE_OP_RESUME  \
     || x == VCODE_OP_CLOSURE || x == VCODE_OP_PROTECTED_INIT            \
@@ -208,7 +208,7 @@ struct _vcode_unit {
 #define VCODE_FOR_EACH_MATCHING_OP(name, k) \
    VCODE_FOR_EACH_OP(name) if (name->kind == k)
 
-#define VCODE_VERSION      31
+#define VCODE_VERSION      32
 #define VCODE_CHECK_UNIONS 0
 
 static __thread vcode_unit_t  active_unit = NULL;
@@ -1923,6 +1923,10 @@ void vcode_dump_with_mark(int mark_op, vcode_dump_fn_t callback, void *arg)
                vcode_dump_reg(op->args.items[0]);
                printf(" count ");
                vcode_dump_reg(op->args.items[1]);
+               if (op->args.count > 2) {
+                  printf(" mask ");
+                  vcode_dump_reg(op->args.items[2]);
+               }
             }
             break;
 
@@ -5058,23 +5062,30 @@ void emit_copy(vcode_reg_t dest, vcode_reg_t src, vcode_reg_t count)
    op->type = vtype_pointed(dtype);
 }
 
-void emit_sched_event(vcode_reg_t nets, vcode_reg_t n_elems)
+void emit_sched_event(vcode_reg_t nets, vcode_reg_t n_elems, vcode_reg_t mask)
 {
    VCODE_FOR_EACH_OP(other) {
       if (other->kind == VCODE_OP_CLEAR_EVENT)
          break;
       else if (other->kind == VCODE_OP_SCHED_EVENT
                && other->args.items[0] == nets
-               && other->args.items[1] == n_elems)
+               && other->args.items[1] == n_elems
+               && other->args.count == (mask == VCODE_INVALID_REG ? 2 : 3)
+               && (mask == VCODE_INVALID_REG || other->args.items[2] == mask))
          return;
    }
 
    op_t *op = vcode_add_op(VCODE_OP_SCHED_EVENT);
    vcode_add_arg(op, nets);
    vcode_add_arg(op, n_elems);
+   if (mask != VCODE_INVALID_REG)
+      vcode_add_arg(op, mask);
 
    VCODE_ASSERT(vcode_reg_kind(nets) == VCODE_TYPE_SIGNAL,
                 "nets argument to sched event must be signal");
+   VCODE_ASSERT(mask == VCODE_INVALID_REG
+                || vcode_reg_kind(mask) == VCODE_TYPE_INT,
+                "mask argument to sched event must be integer");
 }
 
 void emit_implicit_event(vcode_reg_t nets, vcode_reg_t count, vcode_reg_t wake)
@@ -5657,10 +5668,11 @@ void emit_debug_out(vcode_reg_t reg)
    vcode_add_arg(op, reg);
 }
 
-void emit_cover_stmt(uint32_t tag)
+void emit_cover_stmt(uint32_t tag, uint32_t flags)
 {
    op_t *op = vcode_add_op(VCODE_OP_COVER_STMT);
    op->tag = tag;
+   op->subkind = flags;
 }
 
 void emit_cover_branch(vcode_reg_t test, uint32_t tag, uint32_t flags)
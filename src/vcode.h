@@ -452,7 +452,7 @@ vcode_reg_t emit_active_flag(vcode_reg_t nets, vcode_reg_t len);
 vcode_reg_t emit_record_ref(vcode_reg_t record, unsigned field);
 vcode_reg_t emit_array_ref(vcode_reg_t array, vcode_reg_t offset);
 void emit_copy(vcode_reg_t dest, vcode_reg_t src, vcode_reg_t count);
-void emit_sched_event(vcode_reg_t nets, vcode_reg_t n_elems);
+void emit_sched_event(vcode_reg_t nets, vcode_reg_t n_elems, vcode_reg_t mask);
 void emit_clear_event(vcode_reg_t nets, vcode_reg_t count);
 void emit_implicit_event(vcode_reg_t nets, vcode_reg_t count, vcode_reg_t wake);
 void emit_resume(ident_t func);
@@ -480,7 +480,7 @@ void emit_length_check(vcode_reg_t llen, vcode_reg_t rlen, vcode_reg_t locus,
 void emit_exponent_check(vcode_reg_t exp, vcode_reg_t locus);
 void emit_zero_check(vcode_reg_t denom, vcode_reg_t locus);
 void emit_debug_out(vcode_reg_t reg);
-void emit_cover_stmt(uint32_t tag);
+void emit_cover_stmt(uint32_t tag, uint32_t flags);
 void emit_cover_branch(vcode_reg_t test, uint32_t tag, uint32_t flags);
 void emit_cover_toggle(vcode_reg_t signal, uint32_t tag);
 void emit_cover_expr(vcode_reg_t new_mask, uint32_t tag);
@@ -53,6 +53,7 @@ typedef struct tag_abstractRegion {
    rt_scope_t       *scope;
    vhpiObjectListT   decls;
    vhpiObjectListT   InternalRegions;
+   shash_t          *namemap;
    c_abstractRegion *UpperRegion;
    vhpiIntT          LineOffset;
    vhpiIntT          LineNo;
@@ -69,6 +70,7 @@ typedef struct {
    type_t            type;
    tree_t            tree;
    rt_signal_t      *signal;
+   vhpiFormatT       format;
    c_abstractRegion *ImmRegion;
    vhpiIntT          LineOffset;
    vhpiIntT          LineNo;
@@ -209,10 +211,11 @@ typedef struct {
 DEF_CLASS(rootInst, vhpiRootInstK, designInstUnit.region.object);
 
 typedef struct {
-   c_vhpiObject object;
-   vhpiStateT   State;
-   vhpiEnumT    Reason;
-   vhpiCbDataT  data;
+   c_vhpiObject   object;
+   vhpiStateT     State;
+   vhpiEnumT      Reason;
+   vhpiCbDataT    data;
+   const int8_t  *levels;
 } c_callback;
 
 DEF_CLASS(callback, vhpiCallbackK, object);
@@ -430,8 +433,44 @@ static void vhpi_signal_event_cb(uint64_t now, rt_signal_t *signal,
                                  rt_watch_t *watch, void *user)
 {
    c_callback *cb;
-   if ((cb = is_callback(user)))
-      vhpi_do_callback(cb);
+   if (!(cb = is_callback(user)) || cb->State != vhpiEnable)
+      return;
+
+   if (cb->levels != NULL) {
+      // Filter edges here rather than waking the user for every event
+      const uint8_t *new = signal_value(signal);
+      const uint8_t *old = signal_last_value(signal);
+
+      const int want = (cb->Reason == vhpiCbRisingEdge);
+      if (cb->levels[*new] != want || cb->levels[*old] != !want)
+         return;
+   }
+
+   if (cb->data.value != NULL)
+      vhpi_get_value(cb->data.obj, cb->data.value);
+
+   vhpi_do_callback(cb);
+}
+
+static const int8_t *vhpi_edge_levels(c_abstractDecl *decl)
+{
+   // Map each enumeration literal to its logic level as with To_X01
+   static const int8_t bit_levels[] = { 0, 1 };
+   static const int8_t std_ulogic_levels[] = {
+      -1, -1, 0, 1, -1, -1, 0, 1, -1
+   };
+
+   switch (is_well_known(type_ident(type_base_recur(decl->type)))) {
+   case W_IEEE_ULOGIC:
+      return std_ulogic_levels;
+   case W_STD_BIT:
+   case W_STD_BOOL:
+      return bit_levels;
+   default:
+      vhpi_error(vhpiError, &(decl->object.loc), "edge callbacks are only "
+                 "supported for objects of type BIT, BOOLEAN, or STD_ULOGIC");
+      return NULL;
+   }
 }
 
 static void vhpi_global_cb(rt_model_t *m, void *user)
@@ -477,6 +516,103 @@ static rt_signal_t *vhpi_get_signal(c_abstractDecl *decl)
    return signal;
 }
 
+static vhpiFormatT vhpi_native_format(c_abstractDecl *decl)
+{
+   if (decl->format != 0)
+      return decl->format;
+
+   type_t base = type_base_recur(decl->type);
+
+   vhpiFormatT format;
+   switch (type_kind(base)) {
+   case T_ENUM:
+      switch (is_well_known(type_ident(base))) {
+      case W_IEEE_ULOGIC:
+      case W_STD_BIT:
+         format = vhpiLogicVal;
+         break;
+      default:
+         if (type_enum_literals(base) <= 256)
+            format = vhpiSmallEnumVal;
+         else
+            format = vhpiEnumVal;
+         break;
+      }
+      break;
+
+   case T_INTEGER:
+      format = vhpiIntVal;
+      break;
+
+   case T_ARRAY:
+      {
+         type_t elem = type_base_recur(type_elem(base));
+         switch (type_kind(elem)) {
+         case T_ENUM:
+            {
+               switch (is_well_known(type_ident(elem))) {
+               case W_IEEE_ULOGIC:
+               case W_STD_BIT:
+                  format = vhpiLogicVecVal;
+                  break;
+               default:
+                  if (type_enum_literals(elem) <= 256)
+                     format = vhpiSmallEnumVecVal;
+                  else
+                     format = vhpiEnumVecVal;
+                  break;
+               }
+               break;
+            }
+
+         default:
+            vhpi_error(vhpiInternal, &(decl->object.loc), "arrays of "
+                       "type %s not supported in vhpi_get_value",
+                       type_pp(elem));
+            return 0;
+         }
+      }
+      break;
+
+   default:
+      vhpi_error(vhpiInternal, &(decl->object.loc), "type %s not "
+                 "supported in vhpi_get_value", type_pp(decl->type));
+      return 0;
+   }
+
+   decl->format = format;
+   return format;
+}
+
+static void vhpi_add_to_namemap(c_abstractRegion *region, c_vhpiObject *obj)
+{
+   c_abstractDecl *d = cast_abstractDecl(obj);
+   if (d == NULL)
+      return;
+
+   LOCAL_TEXT_BUF tb = tb_new();
+   tb_cat(tb, (char *)d->Name);
+   tb_downcase(tb);
+
+   // Keep the first declaration with a given name
+   if (shash_get(region->namemap, tb_get(tb)) == NULL)
+      shash_put(region->namemap, tb_get(tb), d);
+}
+
+static void vhpi_build_namemap(c_abstractRegion *region)
+{
+   region->namemap = shash_new(MAX(16, region->decls.count * 2));
+
+   for (int i = 0; i < region->decls.count; i++)
+      vhpi_add_to_namemap(region, region->decls.items[i]);
+
+   c_rootInst *rootInst;
+   if ((rootInst = is_rootInst(&(region->object)))) {
+      for (int i = 0; i < rootInst->ports.count; i++)
+         vhpi_add_to_namemap(region, rootInst->ports.items[i]);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Public API
 
@@ -526,6 +662,8 @@ vhpiHandleT vhpi_register_cb(vhpiCbDataT *cb_data_p, int32_t flags)
       break;
 
    case vhpiCbValueChange:
+   case vhpiCbRisingEdge:
+   case vhpiCbFallingEdge:
       {
          c_vhpiObject *obj = from_handle(cb_data_p->obj);
          if (obj == NULL)
@@ -539,6 +677,10 @@ vhpiHandleT vhpi_register_cb(vhpiCbDataT *cb_data_p, int32_t flags)
          if (signal == NULL)
             goto failed;
 
+         if (cb_data_p->reason != vhpiCbValueChange
+             && (cb->levels = vhpi_edge_levels(decl)) == NULL)
+            goto failed;
+
          model_set_event_cb(model, signal, vhpi_signal_event_cb, cb, false);
       }
       break;
@@ -685,23 +827,20 @@ vhpiHandleT vhpi_handle_by_name(const char *name, vhpiHandleT scope)
 
    char *copy LOCAL = xstrdup(name), *saveptr;
    char *elem = strtok_r(copy, ":", &saveptr);
+   if (elem == NULL)
+      return NULL;
 
-   for (int i = 0; i < region->decls.count; i++) {
-      c_abstractDecl *d = cast_abstractDecl(region->decls.items[i]);
-      if (strcasecmp((char *)d->Name, elem) == 0)
-         return handle_for(&(d->object));
-   }
+   if (region->namemap == NULL)
+      vhpi_build_namemap(region);
 
-   c_rootInst *rootInst;
-   if ((rootInst = is_rootInst(&(region->object)))) {
-      for (int i = 0; i < rootInst->ports.count; i++) {
-         c_abstractDecl *d = cast_abstractDecl(rootInst->ports.items[i]);
-         if (strcasecmp((char *)d->Name, elem) == 0)
-            return handle_for(&(d->object));
-      }
-   }
+   for (char *p = elem; *p; p++)
+      *p = tolower_iso88591(*p);
 
-   return NULL;
+   c_abstractDecl *d = shash_get(region->namemap, elem);
+   if (d == NULL)
+      return NULL;
+
+   return handle_for(&(d->object));
 }
 
 DLLEXPORT
@@ -917,72 +1056,30 @@ int vhpi_get_value(vhpiHandleT expr, vhpiValueT *value_p)
    if (decl == NULL)
       return -1;
 
-   type_t base = type_base_recur(decl->type);
-   ident_t type_name = type_ident(decl->type);
-
-   vhpiFormatT format;
-   switch (type_kind(base)) {
-   case T_ENUM:
-      switch (is_well_known(type_name)) {
-      case W_IEEE_LOGIC:
-      case W_IEEE_ULOGIC:
-      case W_STD_BIT:
-         if (value_p->format == vhpiBinStrVal)
-            format = value_p->format;
-         else
-            format = vhpiLogicVal;
-         break;
-      default:
-         if (type_enum_literals(base) <= 256)
-            format = vhpiSmallEnumVal;
-         else
-            format = vhpiEnumVal;
-         break;
-      }
-      break;
+   rt_signal_t *signal = vhpi_get_signal(decl);
+   if (signal == NULL)
+      return -1;
 
-   case T_INTEGER:
-      format = vhpiIntVal;
-      break;
+   if (value_p->format == vhpiRawDataVal) {
+      // Copy the value out in the simulator's internal representation
+      // without converting each element
+      const size_t size = signal_size(signal);
+      value_p->numElems = signal_width(signal);
+      if (size > value_p->bufSize)
+         return size;
 
-   case T_ARRAY:
-      {
-         type_t elem = type_elem(base);
-         switch (type_kind(elem)) {
-         case T_ENUM:
-            {
-               switch (is_well_known(type_ident(elem))) {
-               case W_IEEE_LOGIC:
-               case W_IEEE_ULOGIC:
-               case W_STD_BIT:
-                  if (value_p->format == vhpiBinStrVal)
-                     format = value_p->format;
-                  else
-                     format = vhpiLogicVecVal;
-                  break;
-               default:
-                  if (type_enum_literals(elem) <= 256)
-                     format = vhpiSmallEnumVecVal;
-                  else
-                     format = vhpiEnumVecVal;
-                  break;
-               }
-               break;
-            }
-
-         default:
-            vhpi_error(vhpiInternal, &(obj->loc), "arrays of type %s "
-                       "not supported in vhpi_get_value", type_pp(elem));
-            return -1;
-         }
-      }
-      break;
+      memcpy(value_p->value.ptr, signal_value(signal), size);
+      return 0;
+   }
 
-   default:
-      vhpi_error(vhpiInternal, &(obj->loc), "type %s not supported in "
-                 "vhpi_get_value", type_pp(decl->type));
+   const vhpiFormatT native = vhpi_native_format(decl);
+   if (native == 0)
       return -1;
-   }
+
+   vhpiFormatT format = native;
+   if (value_p->format == vhpiBinStrVal
+       && (native == vhpiLogicVal || native == vhpiLogicVecVal))
+      format = vhpiBinStrVal;
 
    if (value_p->format == vhpiObjTypeVal)
       value_p->format = format;
@@ -993,10 +1090,6 @@ int vhpi_get_value(vhpiHandleT expr, vhpiValueT *value_p)
       return -1;
    }
 
-   rt_signal_t *signal = vhpi_get_signal(decl);
-   if (signal == NULL)
-      return -1;
-
    if (format == vhpiBinStrVal) {
       const char *map_str = vhpi_map_str_for_type(decl->type);
       const size_t need = signal_string(signal, map_str,
@@ -1038,7 +1131,7 @@ int vhpi_get_value(vhpiHandleT expr, vhpiValueT *value_p)
       case vhpiEnumVecVal:
          elemsz = sizeof(vhpiEnumT);
          break;
-      case vhpiSmallEnumVal:
+      case vhpiSmallEnumVecVal:
          elemsz = sizeof(vhpiSmallEnumT);
          break;
       default:
@@ -1046,25 +1139,35 @@ int vhpi_get_value(vhpiHandleT expr, vhpiValueT *value_p)
       }
 
       const int max = value_p->bufSize / elemsz;
-      uint64_t *values LOCAL = xmalloc_array(max, sizeof(uint64_t));
-      value_p->numElems = signal_expand(signal, values, max);
+      value_p->numElems = signal_width(signal);
 
       const int copy = MIN(value_p->numElems, max);
+      if (copy == 0)
+         return 0;
 
-      for (int i = 0; i < copy; i++) {
-         switch (format) {
-         case vhpiLogicVecVal:
-         case vhpiEnumVecVal:
-            value_p->value.enumvs[i] = values[i];
-            break;
-         case vhpiSmallEnumVal:
-            value_p->value.smallenumvs[i] = values[i];
-            break;
-         default:
-            vhpi_error(vhpiError, &(obj->loc), "unsupported format %d", format);
-         }
+      // Convert directly from the signal data rather than expanding
+      // into a temporary buffer
+#define VHPI_COPY_VECTOR(type) do {                                     \
+         const type *sp = signal_value(signal);                         \
+         if (format == vhpiSmallEnumVecVal) {                           \
+            for (int i = 0; i < copy; i++)                              \
+               value_p->value.smallenumvs[i] = sp[i];                   \
+         }                                                              \
+         else {                                                         \
+            for (int i = 0; i < copy; i++)                              \
+               value_p->value.enumvs[i] = sp[i];                        \
+         }                                                              \
+      } while (0)
+
+      switch (signal_size(signal) / value_p->numElems) {
+      case 1: VHPI_COPY_VECTOR(uint8_t); break;
+      case 2: VHPI_COPY_VECTOR(uint16_t); break;
+      case 4: VHPI_COPY_VECTOR(uint32_t); break;
+      case 8: VHPI_COPY_VECTOR(uint64_t); break;
       }
 
+#undef VHPI_COPY_VECTOR
+
       return 0;
    }
 }
@@ -1096,7 +1199,22 @@ int vhpi_put_value(vhpiHandleT handle,
    switch (mode) {
    case vhpiForcePropagate:
       {
-         if (type_is_scalar(decl->type)) {
+         if (!model_can_create_delta(model)) {
+            vhpi_error(vhpiError, &(obj->loc), "cannot force "
+                       "propagate signal during current simulation phase");
+            return 1;
+         }
+
+         if (value_p->format == vhpiRawDataVal) {
+            if (!force_signal_raw(signal, value_p->value.ptr,
+                                  value_p->bufSize)) {
+               vhpi_error(vhpiError, &(obj->loc), "expected %zu bytes of "
+                          "raw data for %s but have %zu", signal_size(signal),
+                          decl->Name, value_p->bufSize);
+               return 1;
+            }
+         }
+         else if (type_is_scalar(decl->type)) {
             uint64_t expanded;
             switch (value_p->format) {
             case vhpiLogicVal:
@@ -1119,13 +1237,7 @@ int vhpi_put_value(vhpiHandleT handle,
                return 1;
             }
 
-            if (model_can_create_delta(model))
-               force_signal(signal, &expanded, 1);
-            else {
-               vhpi_error(vhpiError, &(obj->loc), "cannot force "
-                          "propagate signal during current simulation phase");
-               return 1;
-            }
+            force_signal(signal, &expanded, 1);
          }
          else {
             uint64_t *expanded = NULL;
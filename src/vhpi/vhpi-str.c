@@ -508,6 +508,8 @@ const char *vhpi_cb_reason_str(int reason)
    case vhpiCbTimeOut: return "vhpiCbTimeOut";
    case vhpiCbRepTimeOut: return "vhpiCbRepTimeOut";
    case vhpiCbSensitivity: return "vhpiCbSensitivity";
+   case vhpiCbRisingEdge: return "vhpiCbRisingEdge";
+   case vhpiCbFallingEdge: return "vhpiCbFallingEdge";
    default:
       {
          static char buf[64];
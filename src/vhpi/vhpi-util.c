@@ -237,6 +237,8 @@ bool vhpi_is_repetitive(vhpiEnumT reason)
 {
    switch (reason) {
    case vhpiCbValueChange:
+   case vhpiCbRisingEdge:
+   case vhpiCbFallingEdge:
    case vhpiCbRepEndOfProcesses:
    case vhpiCbRepLastKnownDeltaCycle:
    case vhpiCbRepNextTimeStep:
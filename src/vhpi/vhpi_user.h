@@ -975,6 +975,12 @@ typedef struct vhpiCbDataS
 #define vhpiCbRepTimeOut           1048 /* repetitive */
 #define vhpiCbSensitivity          1049 /* repetitive */
 
+/* nvc extensions: value change callbacks filtered on the edge of a
+   bit, boolean, or std_ulogic signal using rising_edge/falling_edge
+   semantics */
+#define vhpiCbRisingEdge           1100 /* repetitive */
+#define vhpiCbFallingEdge          1101 /* repetitive */
+
 /************************* CALLBACK FLAGS ***************************/
 #define vhpiReturnCb  0x00000001
 #define vhpiDisableCb 0x00000010
@@ -209,7 +209,7 @@ static void vlog_lower_sensitivity(lower_unit_t *lu, vlog_node_t v)
       {
          vcode_reg_t nets_reg = vlog_lower_lvalue(lu, v);
          vcode_reg_t count_reg = emit_const(vtype_offset(), 1);
-         emit_sched_event(nets_reg, count_reg);
+         emit_sched_event(nets_reg, count_reg, VCODE_INVALID_REG);
       }
       break;
    case V_EVENT:
@@ -102,9 +102,9 @@ static inline vlog_node_t vlog_array_nth(item_t *item, unsigned n)
    return container_of(o, struct _vlog_node, object);
 }
 
-static inline void vlog_array_add(item_t *item, vlog_node_t v)
+static inline void vlog_array_add(object_t *owner, item_t *item, vlog_node_t v)
 {
-   obj_array_add(&(item->obj_array), &(v->object));
+   obj_array_add(&(item->obj_array), owner, &(v->object));
 }
 
 vlog_node_t vlog_new(vlog_kind_t kind)
@@ -188,7 +188,7 @@ vlog_node_t vlog_stmt(vlog_node_t v, unsigned n)
 void vlog_add_stmt(vlog_node_t v, vlog_node_t s)
 {
    assert(s != NULL);
-   vlog_array_add(lookup_item(&vlog_object, v, I_STMTS), s);
+   vlog_array_add(&(v->object), lookup_item(&vlog_object, v, I_STMTS), s);
    object_write_barrier(&(v->object), &(s->object));
 }
 
@@ -208,7 +208,7 @@ void vlog_add_port(vlog_node_t v, vlog_node_t p)
 {
    assert(p != NULL);
    assert(p->object.kind == V_REF);
-   vlog_array_add(lookup_item(&vlog_object, v, I_PORTS), p);
+   vlog_array_add(&(v->object), lookup_item(&vlog_object, v, I_PORTS), p);
    object_write_barrier(&(v->object), &(p->object));
 }
 
@@ -227,7 +227,7 @@ vlog_node_t vlog_param(vlog_node_t v, unsigned n)
 void vlog_add_param(vlog_node_t v, vlog_node_t p)
 {
    assert(p != NULL);
-   vlog_array_add(lookup_item(&vlog_object, v, I_PARAMS), p);
+   vlog_array_add(&(v->object), lookup_item(&vlog_object, v, I_PARAMS), p);
    object_write_barrier(&(v->object), &(p->object));
 }
 
@@ -246,7 +246,7 @@ vlog_node_t vlog_decl(vlog_node_t v, unsigned n)
 void vlog_add_decl(vlog_node_t v, vlog_node_t d)
 {
    assert(d != NULL);
-   vlog_array_add(lookup_item(&vlog_object, v, I_DECLS), d);
+   vlog_array_add(&(v->object), lookup_item(&vlog_object, v, I_DECLS), d);
    object_write_barrier(&(v->object), &(d->object));
 }
 
@@ -50,6 +50,8 @@ EXTRA_DIST += \
 	test/elab/eval1.vhd \
 	test/elab/fold1.vhd \
 	test/elab/fold2.vhd \
+	test/elab/fuse1.vhd \
+	test/elab/fuse2.vhd \
 	test/elab/gbounds.vhd \
 	test/elab/genagg.vhd \
 	test/elab/generate1.vhd \
@@ -189,6 +191,7 @@ EXTRA_DIST += \
 	test/lower/directmap3.vhd \
 	test/lower/directmap.vhd \
 	test/lower/driver1.vhd \
+	test/lower/edge1.vhd \
 	test/lower/extern1.vhd \
 	test/lower/func1.vhd \
 	test/lower/func5.vhd \
@@ -283,6 +286,7 @@ EXTRA_DIST += \
 	test/misc/ramb_test.vhd \
 	test/model/alias1.vhd \
 	test/model/basic1.vhd \
+	test/model/cover1.vhd \
 	test/model/fast1.vhd \
 	test/model/fast2.vhd \
 	test/model/index1.vhd \
@@ -368,6 +372,7 @@ EXTRA_DIST += \
 	test/parse/protected.vhd \
 	test/parse/qual.vhd \
 	test/parse/range1.vhd \
+	test/parse/scan.vhd \
 	test/parse/seq.vhd \
 	test/parse/spec.vhd \
 	test/parse/subtype2008.vhd \
@@ -551,11 +556,16 @@ EXTRA_DIST += \
 	test/regress/case8.vhd \
 	test/regress/case9.vhd \
 	test/regress/cmdline1.sh \
+	test/regress/cmdline10.sh \
+	test/regress/cmdline11.sh \
 	test/regress/cmdline2.sh \
 	test/regress/cmdline3.sh \
 	test/regress/cmdline4.sh \
 	test/regress/cmdline5.sh \
 	test/regress/cmdline6.sh \
+	test/regress/cmdline7.sh \
+	test/regress/cmdline8.sh \
+	test/regress/cmdline9.sh \
 	test/regress/comp1.vhd \
 	test/regress/concat1.vhd \
 	test/regress/concat2.vhd \
@@ -600,6 +610,8 @@ EXTRA_DIST += \
 	test/regress/cover13.vhd \
 	test/regress/cover14.sh \
 	test/regress/cover14.vhd \
+	test/regress/cover15.sh \
+	test/regress/cover15.vhd \
 	test/regress/cover1.vhd \
 	test/regress/cover2.vhd \
 	test/regress/cover3.vhd \
@@ -725,6 +737,8 @@ EXTRA_DIST += \
 	test/regress/func7.vhd \
 	test/regress/func8.vhd \
 	test/regress/func9.vhd \
+	test/regress/fuse1.vhd \
+	test/regress/fuse2.vhd \
 	test/regress/generic1.vhd \
 	test/regress/genpack10.vhd \
 	test/regress/genpack11.vhd \
@@ -898,6 +912,8 @@ EXTRA_DIST += \
 	test/regress/gold/wait2.txt \
 	test/regress/gold/wait6.txt \
 	test/regress/gold/wave1.dump \
+	test/regress/gold/wave10.dump \
+	test/regress/gold/wave11.dump \
 	test/regress/gold/wave2.dump \
 	test/regress/gold/wave3.dump \
 	test/regress/gold/wave3.gtkw \
@@ -907,12 +923,14 @@ EXTRA_DIST += \
 	test/regress/gold/wave6.dump \
 	test/regress/gold/wave7.dump \
 	test/regress/gold/wave8.dump \
+	test/regress/gold/wave9.dump \
 	test/regress/gold/while1.txt \
 	test/regress/grlib1.vhd \
 	test/regress/guard1.vhd \
 	test/regress/guard2.vhd \
 	test/regress/guard3.vhd \
 	test/regress/ieee10.vhd \
+	test/regress/ieee11.vhd \
 	test/regress/ieee1.vhd \
 	test/regress/ieee2.vhd \
 	test/regress/ieee3.vhd \
@@ -1221,6 +1239,8 @@ EXTRA_DIST += \
 	test/regress/signal29.vhd \
 	test/regress/signal2.vhd \
 	test/regress/signal30.vhd \
+	test/regress/signal31.vhd \
+	test/regress/signal32.vhd \
 	test/regress/signal3.vhd \
 	test/regress/signal4.vhd \
 	test/regress/signal5.vhd \
@@ -1249,6 +1269,7 @@ EXTRA_DIST += \
 	test/regress/textio6.vhd \
 	test/regress/textio7.vhd \
 	test/regress/textio8.vhd \
+	test/regress/textio9.vhd \
 	test/regress/toplevel1.vhd \
 	test/regress/toplevel2.vhd \
 	test/regress/vecorder1.vhd \
@@ -1307,6 +1328,7 @@ EXTRA_DIST += \
 	test/regress/vhpi3.vhd \
 	test/regress/vhpi4.vhd \
 	test/regress/vhpi5.vhd \
+	test/regress/vhpi6.vhd \
 	test/regress/vlog1.vhd \
 	test/regress/wait10.vhd \
 	test/regress/wait11.vhd \
@@ -1335,6 +1357,10 @@ EXTRA_DIST += \
 	test/regress/wait8.vhd \
 	test/regress/wait9.vhd \
 	test/regress/wave1.vhd \
+	test/regress/wave10.sh \
+	test/regress/wave10.vhd \
+	test/regress/wave11.sh \
+	test/regress/wave11.vhd \
 	test/regress/wave2.sh \
 	test/regress/wave2.vhd \
 	test/regress/wave3.sh \
@@ -1347,6 +1373,7 @@ EXTRA_DIST += \
 	test/regress/wave7.sh \
 	test/regress/wave7.vhd \
 	test/regress/wave8.vhd \
+	test/regress/wave9.vhd \
 	test/regress/while1.vhd \
 	test/sem/access.vhd \
 	test/sem/afunc.vhd \
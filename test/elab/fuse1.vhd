@@ -0,0 +1,13 @@
+entity fuse1 is
+end entity;
+
+architecture test of fuse1 is
+    signal a, b, c, x, y, z, w : bit;
+begin
+
+    x <= a and b;                       -- Fused with Y
+    w <= not w after 1 ns;
+    y <= a or c;
+    z <= x xor y;                       -- Not sensitive to A
+
+end architecture;
@@ -0,0 +1,13 @@
+entity fuse2 is
+end entity;
+
+architecture test of fuse2 is
+    signal a, b, c, x, y, q, w : bit;
+begin
+
+    x <= a and b;                       -- Only read by Y
+    y <= x xor c;
+    q <= not a;
+    w <= '1' when q'event else '0';     -- Cannot chain through Q
+
+end architecture;
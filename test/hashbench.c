@@ -0,0 +1,163 @@
+//
+//  Copyright (C) 2023  Nick Gasson
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "util.h"
+#include "hash.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+#define NUM_KEYS   1000000
+#define NUM_ROUNDS 5
+
+static void **pkeys;
+static uint64_t *ikeys;
+static char **skeys;
+
+static volatile uintptr_t sink;
+
+static void report(const char *what, uint64_t start, int nops)
+{
+   const uint64_t elapsed = get_timestamp_us() - start;
+   printf("  %-16s %8"PRIu64" us  %6.1f ns/op\n", what, elapsed,
+          elapsed * 1000.0 / nops);
+}
+
+static void bench_hash(int nkeys)
+{
+   uint64_t start = get_timestamp_us();
+   hash_t *h = hash_new(16);
+   for (int i = 0; i < nkeys; i++)
+      hash_put(h, pkeys[i], pkeys[i]);
+   report("hash_put", start, nkeys);
+
+   start = get_timestamp_us();
+   for (int r = 0; r < NUM_ROUNDS; r++) {
+      for (int i = 0; i < nkeys; i++)
+         sink += (uintptr_t)hash_get(h, pkeys[i]);
+   }
+   report("hash_get", start, nkeys * NUM_ROUNDS);
+
+   start = get_timestamp_us();
+   for (int r = 0; r < NUM_ROUNDS; r++) {
+      for (int i = 0; i < nkeys; i++)
+         sink += (uintptr_t)hash_get(h, (char *)pkeys[i] + 1);   // Misses
+   }
+   report("hash_get (miss)", start, nkeys * NUM_ROUNDS);
+
+   start = get_timestamp_us();
+   const void *key;
+   void *value;
+   for (hash_iter_t it = HASH_BEGIN; hash_iter(h, &it, &key, &value); )
+      sink += (uintptr_t)value;
+   report("hash_iter", start, nkeys);
+
+   hash_free(h);
+}
+
+static void bench_ihash(int nkeys)
+{
+   uint64_t start = get_timestamp_us();
+   ihash_t *h = ihash_new(16);
+   for (int i = 0; i < nkeys; i++)
+      ihash_put(h, ikeys[i], pkeys[i]);
+   report("ihash_put", start, nkeys);
+
+   start = get_timestamp_us();
+   for (int r = 0; r < NUM_ROUNDS; r++) {
+      for (int i = 0; i < nkeys; i++)
+         sink += (uintptr_t)ihash_get(h, ikeys[i]);
+   }
+   report("ihash_get", start, nkeys * NUM_ROUNDS);
+
+   ihash_free(h);
+}
+
+static void bench_shash(int nkeys)
+{
+   uint64_t start = get_timestamp_us();
+   shash_t *h = shash_new(16);
+   for (int i = 0; i < nkeys; i++)
+      shash_put(h, skeys[i], pkeys[i]);
+   report("shash_put", start, nkeys);
+
+   start = get_timestamp_us();
+   for (int r = 0; r < NUM_ROUNDS; r++) {
+      for (int i = 0; i < nkeys; i++)
+         sink += (uintptr_t)shash_get(h, skeys[i]);
+   }
+   report("shash_get", start, nkeys * NUM_ROUNDS);
+
+   shash_free(h);
+}
+
+static void bench_hset(int nkeys)
+{
+   uint64_t start = get_timestamp_us();
+   hset_t *h = hset_new(16);
+   for (int i = 0; i < nkeys; i++)
+      hset_insert(h, pkeys[i]);
+   report("hset_insert", start, nkeys);
+
+   start = get_timestamp_us();
+   for (int r = 0; r < NUM_ROUNDS; r++) {
+      for (int i = 0; i < nkeys; i++)
+         sink += hset_contains(h, pkeys[i]);
+   }
+   report("hset_contains", start, nkeys * NUM_ROUNDS);
+
+   hset_free(h);
+}
+
+int main(int argc, char **argv)
+{
+   srandom(42);
+
+   pkeys = xmalloc_array(NUM_KEYS, sizeof(void *));
+   ikeys = xmalloc_array(NUM_KEYS, sizeof(uint64_t));
+   skeys = xmalloc_array(NUM_KEYS, sizeof(char *));
+
+   // Pointer keys come from the allocator so they have the same
+   // alignment and clustering as tree and type objects
+   for (int i = 0; i < NUM_KEYS; i++) {
+      pkeys[i] = xmalloc(16 + (random() % 4) * 16);
+      ikeys[i] = ((uint64_t)random() << 31) | random();
+      skeys[i] = xasprintf("WORK.UNIT_%d.SIGNAL_%ld", i, random() % 1000);
+   }
+
+   static const int sizes[] = { 100, 10000, NUM_KEYS };
+   for (int i = 0; i < ARRAY_LEN(sizes); i++) {
+      printf("%d keys\n", sizes[i]);
+      bench_hash(sizes[i]);
+      bench_ihash(sizes[i]);
+      bench_shash(sizes[i]);
+      bench_hset(sizes[i]);
+      printf("\n");
+   }
+
+   for (int i = 0; i < NUM_KEYS; i++) {
+      free(pkeys[i]);
+      free(skeys[i]);
+   }
+
+   free(pkeys);
+   free(ikeys);
+   free(skeys);
+
+   return 0;
+}
@@ -0,0 +1,43 @@
+entity edge1 is
+end entity;
+
+architecture test of edge1 is
+    signal clk : bit;
+    signal x1, x2, x3, x4 : integer;
+
+    impure function check return boolean is
+    begin
+        report "called";
+        return true;
+    end function;
+begin
+
+    p1: process (clk) is
+    begin
+        if clk'event and clk = '1' then
+            x1 <= x1 + 1;
+        end if;
+    end process;
+
+    p2: process (clk) is
+    begin
+        if clk = '0' and check then
+            x2 <= x2 + 1;
+        end if;
+    end process;
+
+    p3: process (clk) is
+    begin
+        if check and clk = '1' then     -- Must wake on every event
+            x3 <= x3 + 1;
+        end if;
+    end process;
+
+    p4: process (clk) is
+    begin
+        if clk = '0' or clk = '1' then  -- Covers every value
+            x4 <= x4 + 1;
+        end if;
+    end process;
+
+end architecture;
@@ -0,0 +1,8 @@
+-- Test scanning of long identifiers and runs of whitespace
+package scan is
+    constant a_very_long_identifier_name_0123456789 : integer := 1;
+    constant Long_Identifier_With_mlaut_and_ : integer := 16#ff#;
+    constant short : integer := 2;																				-- Comment
+                                        constant spaced : string := "a""b";
+    constant bits : bit_vector := x"1_F";  /* delimited
+       comment */ constant last : integer := 3; end package;
\ No newline at end of file
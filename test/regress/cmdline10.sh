@@ -0,0 +1,69 @@
+set -xe
+
+pwd
+which nvc
+
+case $(uname) in
+  Darwin*|MINGW*|MSYS*)
+    exit 0    # Not supported
+    ;;
+esac
+
+cat >top.vhd <<EOF2
+entity top is
+end entity;
+
+architecture test of top is
+begin
+  process is
+  begin
+    report "start";
+    wait for 10 ns;
+    report "middle";
+    wait for 10 ns;
+    report "end" severity failure;
+    wait;
+  end process;
+end architecture;
+EOF2
+
+nvc -a top.vhd -e top
+
+nvc --server --socket=top.sock top &
+server=$!
+trap "kill $server 2>/dev/null || true" EXIT
+
+for i in $(seq 1 50); do
+  [ -S top.sock ] && break
+  sleep 0.1
+done
+[ -S top.sock ]
+
+# Each request runs from the initial state with its own options
+nvc -r --connect=top.sock --stop-time=5ns >out1 2>&1
+cat out1
+grep "start" out1
+! grep "middle" out1
+
+nvc -r --connect=top.sock --stop-time=15ns >out2 2>&1
+cat out2
+grep "start" out2
+grep "middle" out2
+! grep "end" out2
+
+# The exit status of the simulation is passed back to the client
+status=0
+nvc -r --connect=top.sock >out3 2>&1 || status=$?
+cat out3
+[ $status -ne 0 ]
+grep "Failure: end" out3
+
+# The socket path may be given as a separate argument and is not
+# forwarded to the server
+nvc -r --stop-time=5ns --connect top.sock >out4 2>&1
+cat out4
+grep "start" out4
+! grep "middle" out4
+
+kill $server
+wait $server || true
@@ -0,0 +1,52 @@
+set -xe
+
+pwd
+which nvc
+
+cat >a.vhd <<EOF2
+entity top is
+end entity;
+
+architecture test of top is
+begin
+  process is
+  begin
+    report "from a.vhd";
+    wait;
+  end process;
+end architecture;
+EOF2
+
+cat >b.vhd <<EOF2
+architecture test of top is
+begin
+  process is
+  begin
+    report "from b.vhd";
+    wait;
+  end process;
+end architecture;
+EOF2
+
+# Reanalysing a.vhd must not be skipped after b.vhd replaced one of the
+# units it produced
+nvc -a a.vhd
+nvc -a b.vhd
+nvc -a a.vhd -e top -r >out 2>&1
+cat out
+grep "from a.vhd" out
+
+cat >pack.vhd <<EOF2
+package pack is
+  function f return integer;
+end package;
+
+package body pack is
+end package body;
+EOF2
+
+# Warnings are repeated each time the file is analysed
+nvc -a pack.vhd 2>msgs1
+grep "missing body for function" msgs1
+nvc -a pack.vhd 2>msgs2
+grep "missing body for function" msgs2
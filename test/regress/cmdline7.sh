@@ -0,0 +1,56 @@
+set -xe
+
+pwd
+which nvc
+
+cat >pack.vhd <<EOF
+package pack is
+  constant c : integer := 5;
+end package;
+EOF
+
+cat >sub.vhd <<EOF
+use work.pack.all;
+entity sub is end entity;
+architecture a of sub is
+begin
+  assert c = 5;
+end architecture;
+EOF
+
+cat >other.vhd <<EOF
+entity other is end entity;
+architecture a of other is begin end architecture;
+EOF
+
+cat >top.vhd <<EOF
+entity top is end entity;
+architecture a of top is
+begin
+  u1: entity work.sub;
+  u2: entity work.other;
+end architecture;
+EOF
+
+nvc -a pack.vhd sub.vhd other.vhd top.vhd
+
+# Everything is up to date
+nvc --make --verbose top 2>out
+diff -u /dev/null out
+
+touch pack.vhd  # Contents not changed
+nvc --make -V top 2>out
+diff -u /dev/null out
+
+echo "-- Modified" >>pack.vhd
+nvc --make -V -j2 top 2>&1 | sort >out
+
+diff -u - out <<EOF
+** Note: analysed architecture WORK.SUB-A
+** Note: analysed architecture WORK.TOP-A
+** Note: analysed entity WORK.SUB
+** Note: analysed entity WORK.TOP
+** Note: analysed package WORK.PACK
+EOF
+
+nvc --make top -e top -r
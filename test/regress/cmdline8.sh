@@ -0,0 +1,51 @@
+set -xe
+
+pwd
+which nvc
+
+cat >pack.vhd <<EOF
+package pack is
+  constant c : integer := 5;
+end package;
+EOF
+
+cat >ent.vhd <<EOF
+use work.pack.all;
+entity ent is
+  generic ( g : integer := c );
+end entity;
+
+architecture test of ent is
+begin
+end architecture;
+EOF
+
+nvc -a pack.vhd ent.vhd
+
+# Contents unchanged so nothing is reanalysed and there is no warning
+# about the source file being newer
+touch pack.vhd ent.vhd
+nvc -a ent.vhd
+if [ work/WORK.ENT -nt ent.vhd ]; then
+  echo "WORK.ENT was reanalysed"
+  exit 1
+fi
+
+nvc -e ent 2>msgs
+if grep "is older than its source file" msgs; then
+  echo "unexpected message"
+  exit 1
+fi
+
+# A changed dependency invalidates the unit
+cat >pack.vhd <<EOF
+package pack is
+  constant c : integer := 6;
+end package;
+EOF
+
+nvc -a pack.vhd ent.vhd
+if [ ! work/WORK.ENT -nt ent.vhd ]; then
+  echo "WORK.ENT was not reanalysed"
+  exit 1
+fi
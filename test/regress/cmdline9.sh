@@ -0,0 +1,68 @@
+set -xe
+
+pwd
+which nvc
+
+case $(uname) in
+  Darwin*|MINGW*|MSYS*)
+    exit 0    # Not supported
+    ;;
+esac
+
+cat >pack.vhd <<EOF2
+package pack is
+  function scale (x : integer) return integer;
+end package;
+
+package body pack is
+  function scale (x : integer) return integer is
+  begin
+    return x * 3 + 1;
+  end function;
+end package body;
+EOF2
+
+# Enough processes to spread the code over several objects
+set +x
+{
+  echo "use work.pack.all;"
+  echo "entity top is end entity;"
+  echo "architecture test of top is"
+  echo "  signal s : integer_vector(0 to 60) := (others => 0);"
+  echo "begin"
+  for i in $(seq 1 60); do
+    echo "  p$i: process is begin"
+    echo "    wait until s($((i - 1))) > 0;"
+    echo "    s($i) <= scale(s($((i - 1)))) mod 1000;"
+    echo "    wait;"
+    echo "  end process;"
+  done
+  echo "  s(0) <= 1;"
+  echo "  check: process is begin"
+  echo "    wait for 1 ns;"
+  echo "    assert s(60) = 801 report integer'image(s(60)) severity failure;"
+  echo "    report \"done\";"
+  echo "    wait;"
+  echo "  end process;"
+  echo "end architecture;"
+} >top.vhd
+set -x
+
+nvc --std=2008 -a pack.vhd top.vhd
+nvc --std=2008 -e -V --no-link top 2>msgs
+cat msgs
+
+# Relocatable objects are stored instead of a shared library
+[ -f work/_WORK.TOP.elab.a ]
+[ ! -f work/_WORK.TOP.elab.so ]
+[ $(grep -c "^\*\* Debug: job" msgs) -gt 1 ]
+
+nvc --std=2008 -r top 2>&1 | tee out
+grep "done" out
+
+# Elaborating again normally removes the archive
+nvc --std=2008 -e top
+[ -f work/_WORK.TOP.elab.so ]
+[ ! -f work/_WORK.TOP.elab.a ]
+
+nvc --std=2008 -r top
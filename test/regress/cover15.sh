@@ -0,0 +1,15 @@
+set -xe
+
+pwd
+which nvc
+
+nvc -a $TESTDIR/regress/cover15.vhd -e --cover=statement cover15 -r
+nvc -c --report html work/_WORK.COVER15.elab.covdb 2>&1 | tee summary1
+
+rm -rf html
+nvc -e --cover=statement,hit-once cover15 -r
+nvc -c --report html work/_WORK.COVER15.elab.covdb 2>&1 | tee summary2
+
+# Recording only the first hit does not change which statements are covered
+grep "statement: *100.0 % (6/6)" summary2
+diff -u summary1 summary2
@@ -0,0 +1,20 @@
+entity cover15 is
+end entity;
+
+architecture test of cover15 is
+    signal s : natural;
+begin
+
+    process is
+        variable sum : natural := 0;
+    begin
+        for i in 1 to 10 loop
+            sum := sum + i;
+        end loop;
+        s <= sum;
+        wait for 1 ns;
+        assert s = 55;
+        wait;
+    end process;
+
+end architecture;
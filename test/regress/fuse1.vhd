@@ -0,0 +1,72 @@
+library ieee;
+use ieee.std_logic_1164.all;
+
+entity fuse1 is
+end entity;
+
+architecture test of fuse1 is
+    signal a, b, c   : std_logic := '0';
+    signal x, y, z   : std_logic;
+    signal w         : std_logic;
+    signal r         : std_logic := 'Z';
+    signal d         : bit;
+    signal sel       : bit := '0';
+    signal m         : std_logic;
+    signal n         : natural;
+begin
+
+    -- These concurrent assignments share inputs and are candidates for
+    -- fusion into a single process
+    x <= a and b;
+    y <= a or c;
+    z <= x xor y;
+    w <= b nand c after 1 ns;
+    with sel select m <= a when '0', c when '1';
+    d <= '1' when a = '1' and sel = '1' else '0';
+
+    -- Resolved signal with multiple drivers must not be merged
+    r <= 'H' when a = '1' else 'Z';
+    r <= '0' when b = '1' else 'Z';
+
+    count: process (z) is
+    begin
+        n <= n + 1;
+    end process;
+
+    stim: process is
+    begin
+        wait for 0 ns;
+        assert x = '0' and y = '0' and m = '0';
+        assert w = 'U';
+        wait for 1 ns;
+        assert w = '1';
+        a <= '1';
+        wait for 0 ns;                  -- A updated
+        assert x = '0' and y = '0';
+        wait for 0 ns;                  -- X, Y updated
+        assert x = '0' and y = '1' and m = '1';
+        assert z = '0';
+        assert r = 'H';
+        wait for 0 ns;                  -- Z updated
+        assert z = '1';
+        b <= '1';
+        c <= '1';
+        sel <= '1';
+        wait for 0 ns;
+        wait for 0 ns;
+        assert x = '1' and y = '1' and m = '1' and d = '1';
+        assert r = '0';
+        assert w = '1';
+        wait for 0 ns;
+        assert z = '0';
+        wait for 1 ns;
+        assert w = '0';
+        a <= '0';
+        wait for 1 ns;
+        assert x = '0' and y = '1' and z = '1' and d = '0';
+        assert n = 5;
+        report "done";
+        wait;
+    end process;
+
+end architecture;
@@ -0,0 +1,72 @@
+library ieee;
+use ieee.std_logic_1164.all;
+
+entity fuse2 is
+end entity;
+
+architecture test of fuse2 is
+    signal a, b, c   : std_logic := '0';
+    signal sel       : std_logic := '0';
+    signal t1, t2    : std_logic;
+    signal t3, t4    : std_logic;
+    signal o1, o2    : std_logic;
+    signal o3, o4    : std_logic;
+    signal o5        : std_logic;
+    signal ba, bt    : bit;
+    signal bo        : bit;
+begin
+
+    -- Each intermediate signal has a single driver and a single reader
+    -- and so the two processes are candidates for chain fusion
+    t1 <= a and b;
+    o1 <= t1 xor c;
+
+    t2 <= a when sel = '1' else b;
+    with t2 select o2 <= '1' when '0', '0' when others;
+
+    with sel select t4 <= a when '1', c when others;
+    o5 <= not t4;
+
+    bt <= not ba;
+    bo <= bt;
+
+    -- Intermediate signal with two readers
+    t3 <= b or c;
+    o3 <= t3;
+    o4 <= t3 and a;
+
+    stim: process is
+    begin
+        wait for 1 ns;
+        assert o1 = '0';
+        assert o2 = '1';
+        assert o3 = '0' and o4 = '0';
+        assert o5 = '1';
+        assert bo = '1';
+        a <= '1';
+        b <= '1';
+        ba <= '1';
+        wait for 1 ns;
+        assert o1 = '1';
+        assert o2 = '0';
+        assert o3 = '1' and o4 = '1';
+        assert o5 = '1';
+        assert bo = '0';
+        c <= '1';
+        sel <= '1';
+        wait for 1 ns;
+        assert o1 = '0';
+        assert o2 = '0';
+        assert o5 = '0';
+        b <= '0';
+        a <= '0';
+        wait for 1 ns;
+        assert o1 = '1';
+        assert o2 = '1';
+        assert o3 = '1' and o4 = '0';
+        assert o5 = '1';
+        report "done";
+        wait;
+    end process;
+
+end architecture;
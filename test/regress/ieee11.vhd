@@ -0,0 +1,184 @@
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+entity ieee11 is
+end entity;
+
+architecture test of ieee11 is
+
+    function ones (n : natural) return unsigned is
+        variable result : unsigned(n - 1 downto 0) := (others => '1');
+    begin
+        return result;
+    end function;
+
+    function wrap (x, bits : integer) return integer is
+        constant m : integer := 2 ** bits;
+    begin
+        return ((x + m / 2) mod m) - m / 2;
+    end function;
+
+    function asr (x, n : integer) return integer is
+    begin
+        if x >= 0 then
+            return x / 2 ** n;
+        else
+            return -((-x - 1) / 2 ** n) - 1;
+        end if;
+    end function;
+
+begin
+
+    exhaustive: process is
+        variable u4, u4b : unsigned(3 downto 0);
+        variable u5      : unsigned(1 to 5);
+        variable s4      : signed(3 downto 0);
+        variable s5      : signed(0 to 4);
+    begin
+        for a in 0 to 15 loop
+            u4 := to_unsigned(a, 4);
+            assert to_integer(u4) = a;
+            s4 := to_signed(a - 8, 4);
+            assert to_integer(s4) = a - 8;
+            for b in 0 to 31 loop
+                u5 := to_unsigned(b, 5);
+                assert to_integer(u4 + u5) = (a + b) mod 32;
+                assert to_integer(u5 - u4) = (b - a) mod 32;
+                assert to_integer(u4 * u5) = a * b;
+                assert (u4 = u5) = (a = b);
+                assert (u4 /= u5) = (a /= b);
+                assert (u4 < u5) = (a < b);
+                assert (u4 <= u5) = (a <= b);
+                assert (u4 > u5) = (a > b);
+                assert (u4 >= u5) = (a >= b);
+                assert (u4 < b) = (a < b);
+                assert (b <= u4) = (b <= a);
+                assert (u4 = b) = (a = b);
+                if b < 16 then
+                    assert to_integer(u4 + b) = (a + b) mod 16;
+                    assert to_integer(b - u4) = (b - a) mod 16;
+                end if;
+
+                s5 := to_signed(b - 16, 5);
+                assert to_integer(s4 + s5) = wrap(a - 8 + b - 16, 5);
+                assert to_integer(s4 - s5) = wrap(a - 8 - (b - 16), 5);
+                assert to_integer(s4 * s5) = (a - 8) * (b - 16);
+                assert (s4 < s5) = (a - 8 < b - 16);
+                assert (s5 >= s4) = (b - 16 >= a - 8);
+                assert (s4 = b - 16) = (a - 8 = b - 16);
+                assert (s4 > b - 16) = (a - 8 > b - 16);
+                assert (b - 16 /= s4) = (a - 8 /= b - 16);
+                if b >= 8 and b < 24 then
+                    assert to_integer(s4 + (b - 16)) = wrap(a + b - 24, 4);
+                end if;
+            end loop;
+            for n in 0 to 5 loop
+                assert to_integer(shift_left(u4, n)) = (a * 2 ** n) mod 16;
+                assert to_integer(shift_right(u4, n)) = a / 2 ** n;
+                assert to_integer(shift_left(s4, n)) = wrap((a - 8) * 2 ** n, 4);
+                assert to_integer(shift_right(s4, n)) = asr(a - 8, n);
+            end loop;
+            assert to_integer(resize(u4, 2)) = a mod 4;
+            assert to_integer(resize(u4, 7)) = a;
+            assert to_integer(resize(s4, 7)) = a - 8;
+        end loop;
+
+        u4 := "1100"; u4b := "1010";
+        assert (std_logic_vector(u4) and std_logic_vector(u4b)) = "1000";
+        assert (std_logic_vector(u4) or std_logic_vector(u4b)) = "1110";
+        assert (std_logic_vector(u4) xor std_logic_vector(u4b)) = "0110";
+        assert (std_logic_vector(u4) nand std_logic_vector(u4b)) = "0111";
+        assert (std_logic_vector(u4) nor std_logic_vector(u4b)) = "0001";
+        assert (std_logic_vector(u4) xnor std_logic_vector(u4b)) = "1001";
+        assert (not std_logic_vector(u4)) = "0011";
+
+        report "exhaustive done";
+        wait;
+    end process;
+
+    wide: process is
+        variable a, b : unsigned(99 downto 0);
+        variable c    : unsigned(0 to 129);
+        variable s    : signed(99 downto 0);
+        variable v, w : std_logic_vector(1 to 21);
+    begin
+        wait for 1 ns;
+
+        a := resize(ones(64), 100);
+        b := a + 1;
+        assert b(64) = '1' and b(63 downto 0) = 0 and b(99 downto 65) = 0;
+        assert b - 1 = a;
+        assert b > a and a < b and b /= a;
+        assert a + (not a) = ones(100);
+        assert shift_left(a, 36) = ones(100) - ones(36);
+        assert shift_right(b, 64) = 1;
+        assert b - a = 1;
+        assert a * 1 = a;
+
+        c := resize(b, 130);
+        assert c = b and b = c and c > a and a < c;
+        assert to_integer(shift_right(c, 40)) = 2 ** 24;
+
+        s := -signed(b);
+        assert s < 0 and s < -1 and s < signed(a);
+        assert s + signed(b) = 0;
+        assert shift_right(s, 99) = -1;
+        assert resize(s, 130) < 0;
+        assert resize(s, 130) + signed(resize(b, 130)) = 0;
+
+        v := "01010101010101010101L";
+        w := "HHHHHHHHHHHHHHHHHHHHH";
+        assert (v and w) = "010101010101010101010";
+        assert (v or w) = "111111111111111111111";
+        assert (v xor w) = "101010101010101010101";
+        assert (v nand w) = "101010101010101010101";
+        assert (v nor w) = "000000000000000000000";
+        assert (v xnor w) = "010101010101010101010";
+        assert (not v) = "101010101010101010101";
+
+        v := "UX01ZWLH-UX01ZWLH-0XH";
+        w := "0000000001111111111HZ";
+        assert (v and w) = "000000000UX01XX01X0XX";
+        assert (v or w) = "UX01XX01X111111111111";
+        assert (v xor w) = "UX01XX01XUX10XX10X1XX";
+        assert (not v) = "UX10XX10XUX10XX10X1X0";
+
+        report "wide done";
+        wait;
+    end process;
+
+    weak: process is
+        variable u : unsigned(3 downto 0);
+    begin
+        wait for 2 ns;
+        u := "HLHL";
+        assert to_integer(u) = 10;
+        assert u + 1 = 11;
+        assert u = "1010";
+        assert std_logic_vector(resize(u, 6)) = "00HLHL";
+        assert std_logic_vector(shift_left(u, 1)) = "LHL0";
+        report "weak done";
+        wait;
+    end process;
+
+    meta: process is
+        variable u : unsigned(3 downto 0);
+        variable s : signed(3 downto 0);
+    begin
+        wait for 3 ns;
+        u := "1X01";
+        assert std_logic_vector(u + 1) = "XXXX";
+        assert not (u = 1);             -- Warning
+        assert to_integer(u) = 0;       -- Warning
+        s := "01U1";
+        assert std_logic_vector(s * s) = "XXXXXXXX";
+        assert not (s < s);             -- Warning
+        assert std_logic_vector(resize(s, 6)) = "0001U1";
+        assert std_logic_vector(shift_right(s, 1)) = "001U";
+        assert to_unsigned(20, 4) = 4;  -- Warning
+        report "meta done";
+        wait;
+    end process;
+
+end architecture;
@@ -15,7 +15,7 @@ EOF
 
 nvc -a arch.vhd
 
-touch ent.vhd  # Now stale
+echo "-- Modified" >>ent.vhd  # Now stale
 
 nvc -e e 2>msgs
 
@@ -0,0 +1,97 @@
+entity signal31 is
+end entity;
+
+architecture test of signal31 is
+
+    procedure pulse (signal x : out bit) is
+    begin
+        x <= '1';
+        wait for 0 ns;
+        x <= '0';
+    end procedure;
+
+    signal clk   : bit := '0';
+    signal count : natural := 0;
+    signal sum   : integer := 0;
+    signal r     : real := 0.0;
+    signal b     : boolean := false;
+    signal p     : bit := '0';
+    signal d     : integer := 0;
+    signal f     : integer := 0;
+begin
+
+    clkgen: process is
+    begin
+        for i in 1 to 10 loop
+            clk <= '1';
+            wait for 1 ns;
+            clk <= '0';
+            wait for 1 ns;
+        end loop;
+        wait;
+    end process;
+
+    counter: process (clk) is
+    begin
+        if clk'event and clk = '1' then
+            count <= count + 1;
+            sum <= 0;                   -- Overwritten below
+            sum <= sum + count;
+            r <= r + 0.5;
+            b <= not b;
+        end if;
+    end process;
+
+    pulser: process is
+    begin
+        wait for 5 ns;
+        pulse(p);
+        wait;
+    end process;
+
+    delayed: process is
+    begin
+        d <= 1;
+        d <= transport 2 after 1 ns;    -- Driver no longer fast
+        wait for 0 ns;
+        assert d = 1;
+        wait for 1 ns;
+        assert d = 2;
+        d <= 3;
+        wait for 0 ns;
+        assert d = 3;
+        wait;
+    end process;
+
+    forced: process is
+    begin
+        wait for 2 ns;
+        f <= 5;
+        f <= force 7;
+        wait for 0 ns;
+        assert f = 7;
+        f <= release;
+        wait for 0 ns;
+        assert f = 5;
+        f <= 6;
+        wait for 0 ns;
+        assert f = 6;
+        wait;
+    end process;
+
+    check: process is
+    begin
+        wait until p = '1';
+        assert now = 5 ns;
+        wait until p = '0';
+        assert now = 5 ns;
+        wait for 20 ns;
+        assert count = 10;
+        assert sum = 45;
+        assert r = 5.0;
+        assert not b;
+        report "done";
+        wait;
+    end process;
+
+end architecture;
@@ -0,0 +1,95 @@
+library ieee;
+use ieee.std_logic_1164.all;
+
+entity signal32 is
+end entity;
+
+architecture test of signal32 is
+    signal clk                 : std_logic := '0';
+    signal bclk                : bit := '0';
+    signal nr, nr2, nf, ne, nz : natural := 0;
+    signal nh, nb, nbf         : natural := 0;
+begin
+
+    stim: process is
+        constant seq : std_logic_vector := "10HLX10";
+    begin
+        for i in seq'range loop
+            wait for 1 ns;
+            clk <= seq(i);
+            bclk <= not bclk;
+        end loop;
+        wait;
+    end process;
+
+    rise: process (clk) is
+    begin
+        if rising_edge(clk) then
+            nr <= nr + 1;
+        end if;
+    end process;
+
+    rise2: process (clk) is
+    begin
+        if rising_edge(clk) then
+            nr2 <= nr2 + 1;
+        end if;
+    end process;
+
+    fall: process (clk) is
+    begin
+        if falling_edge(clk) then
+            nf <= nf + 1;
+        end if;
+    end process;
+
+    event1: process (clk) is
+    begin
+        if clk'event and clk = '1' then
+            ne <= ne + 1;
+        end if;
+    end process;
+
+    event0: process (clk) is
+    begin
+        if clk = '0' and clk'event then
+            nz <= nz + 1;
+        end if;
+    end process;
+
+    weak: process (clk) is
+    begin
+        if clk = 'H' or clk = 'L' then
+            nh <= nh + 1;
+        end if;
+    end process;
+
+    brise: process (bclk) is
+    begin
+        if rising_edge(bclk) then
+            nb <= nb + 1;
+        end if;
+    end process;
+
+    bfall: process (bclk) is
+    begin
+        if bclk'event and bclk = '0' then
+            nbf <= nbf + 1;
+        end if;
+    end process;
+
+    check: process is
+    begin
+        wait for 10 ns;
+        assert nr = 2 report "nr = " & natural'image(nr);
+        assert nr2 = 2 report "nr2 = " & natural'image(nr2);
+        assert nf = 3 report "nf = " & natural'image(nf);
+        assert ne = 2 report "ne = " & natural'image(ne);
+        assert nz = 2 report "nz = " & natural'image(nz);
+        assert nh = 2 report "nh = " & natural'image(nh);
+        assert nb = 4 report "nb = " & natural'image(nb);
+        assert nbf = 3 report "nbf = " & natural'image(nbf);
+        wait;
+    end process;
+
+end architecture;
@@ -0,0 +1,77 @@
+entity textio9 is
+end entity;
+
+use std.textio.all;
+
+architecture test of textio9 is
+begin
+
+    process is
+        file f      : text;
+        variable l  : line;
+        variable i  : integer;
+        variable g  : boolean;
+        variable c  : character;
+    begin
+        file_open(f, "test.txt", WRITE_MODE);
+        write(l, string'("hello world"));
+        writeline(f, l);
+        assert l'length = 0;
+        writeline(f, l);                -- Empty line
+        write(l, string'("  42 -17 +5 -x 2147483647 -2147483648"));
+        writeline(f, l);
+        write(f, "with" & CR & LF);
+        write(f, "99999999999 1" & LF);
+        write(f, "no newline");
+        file_close(f);
+
+        file_open(f, "test.txt", READ_MODE);
+
+        readline(f, l);
+        assert l.all = "hello world";
+        assert l'left = 1 and l'right = 11;
+
+        readline(f, l);
+        assert l'length = 0;
+
+        readline(f, l);
+        read(l, i, g);
+        assert g and i = 42;
+        read(l, i, g);
+        assert g and i = -17;
+        read(l, i, g);
+        assert g and i = 5;
+        read(l, i, g);
+        assert not g;
+        assert l.all = "-x 2147483647 -2147483648";
+        read(l, c);
+        read(l, c);                     -- Skip over "-x"
+        read(l, i);
+        assert i = integer'high;
+        read(l, i);
+        assert i = integer'low;
+        read(l, i, g);
+        assert not g;
+
+        readline(f, l);
+        assert l.all = "with";          -- Carriage return removed
+
+        readline(f, l);
+        read(l, i, g);
+        assert not g;                   -- Overflow
+
+        readline(f, l);
+        assert l.all = "no newline";
+        assert endfile(f);
+
+        readline(f, l);
+        assert l'length = 0;
+
+        file_close(f);
+        deallocate(l);
+
+        report "done";
+        wait;
+    end process;
+
+end architecture;
@@ -0,0 +1,34 @@
+library ieee;
+use ieee.std_logic_1164.all;
+
+entity vhpi6 is
+end entity;
+
+architecture test of vhpi6 is
+    signal clk : std_logic := '0';
+    signal b   : bit;
+begin
+
+    stim: process is
+    begin
+        wait for 1 ns;
+        clk <= '1';                     -- Rising
+        b <= '1';                       -- Rising
+        wait for 1 ns;
+        clk <= '0';                     -- Falling
+        b <= '0';                       -- Falling
+        wait for 1 ns;
+        clk <= 'H';                     -- Rising
+        b <= '1';                       -- Rising
+        wait for 1 ns;
+        clk <= 'L';                     -- Falling
+        wait for 1 ns;
+        clk <= 'X';
+        wait for 1 ns;
+        clk <= '1';
+        wait for 1 ns;
+        clk <= '0';                     -- Falling
+        wait;
+    end process;
+
+end architecture;
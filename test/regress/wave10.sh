@@ -0,0 +1,17 @@
+set -xe
+
+pwd
+which nvc
+
+nvc --std=2008 -a $TESTDIR/regress/wave10.vhd -e wave10 -r --format=vcd -w
+
+# Remove the date and version which change between runs
+sed -e '1,6d' wave10.vcd > wave10.dump
+diff -u $TESTDIR/regress/gold/wave10.dump wave10.dump
+
+if which zstd; then
+  nvc --std=2008 -r wave10 --format=vcd --wave=wave10.vcd.zst
+  zstd -d -o wave10_zst.vcd wave10.vcd.zst
+  sed -e '1,6d' wave10_zst.vcd > wave10_zst.dump
+  diff -u $TESTDIR/regress/gold/wave10.dump wave10_zst.dump
+fi
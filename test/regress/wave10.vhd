@@ -0,0 +1,34 @@
+library ieee;
+use ieee.std_logic_1164.all;
+
+entity wave10 is
+end entity;
+
+architecture test of wave10 is
+    signal clk  : std_logic := '0';
+    signal wide : std_logic_vector(0 to 299) := (others => '0');
+    signal n    : integer := 0;
+    signal r    : real := 0.0;
+begin
+
+    clk <= not clk after 5 ns when now < 30 ns;
+
+    count: process (clk) is
+    begin
+        if rising_edge(clk) then
+            n <= n + 1;
+            r <= r + 0.25;
+            wide <= wide(1 to 299) & not wide(0);
+        end if;
+    end process;
+
+    a_block_with_a_very_long_label_to_check_long_scope_names_are_ok: block is
+    begin
+        another_block_with_an_even_longer_label_to_make_the_scope_line_long_enough_to_overflow_a_small_fixed_size_buffer_padding_padding_padding_padding_padding_padding_padding_padding_padding_padding_padding_padding_padding_padding_padding_padding_padding_padding_padding_padding: block is
+            signal a_signal_with_a_fairly_long_name_as_well_to_push_past_the_limit : integer;
+        begin
+            a_signal_with_a_fairly_long_name_as_well_to_push_past_the_limit <= n * 2;
+        end block;
+    end block;
+
+end architecture;
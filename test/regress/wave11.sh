@@ -0,0 +1,11 @@
+set -xe
+
+pwd
+which nvc
+which fstdump
+
+nvc -a $TESTDIR/regress/wave11.vhd -e wave11 -r -w \
+    --wave-start=3ns --wave-stop=6500ps
+
+fstdump wave11.fst > wave11.dump
+diff -u $TESTDIR/regress/gold/wave11.dump wave11.dump
@@ -0,0 +1,13 @@
+entity wave11 is
+end entity;
+
+architecture test of wave11 is
+    signal count : natural := 0;
+    signal slow  : bit := '0';
+begin
+
+    count <= count + 1 after 1 ns when count < 10;
+
+    slow <= '1' after 2500 ps, '0' after 7500 ps;
+
+end architecture;
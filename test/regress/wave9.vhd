@@ -0,0 +1,33 @@
+library nvc;
+use nvc.sim_pkg.all;
+
+entity wave9 is
+end entity;
+
+library ieee;
+use ieee.std_logic_1164.all;
+
+architecture test of wave9 is
+    signal x : std_logic;
+    signal y : std_logic_vector(1 to 3) := "ZZZ";
+begin
+
+    main: process is
+    begin
+        x <= '1';
+        wait for 1 ns;
+        x <= '0';
+        wait for 1 ns;
+        set_wave_dumping(false);
+        x <= '1';
+        y <= "101";
+        wait for 1 ns;
+        x <= '0';                       -- Not recorded
+        wait for 1 ns;
+        set_wave_dumping(true);         -- Writes current values
+        wait for 1 ns;
+        y <= "001";
+        wait;
+    end process;
+
+end architecture;
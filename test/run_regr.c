@@ -91,6 +91,8 @@
 #define F_PSL     (1 << 18)
 #define F_DEFINE  (1 << 19)
 #define F_TCL     (1 << 20)
+#define F_FUSE    (1 << 21)
+#define F_CHAINS  (1 << 22)
 
 typedef struct test test_t;
 typedef struct param param_t;
@@ -431,6 +433,10 @@ static bool parse_test_list(int argc, char **argv)
          }
          else if (strcmp(opt, "relaxed") == 0)
             test->flags |= F_RELAXED;
+         else if (strcmp(opt, "fuse") == 0)
+            test->flags |= F_FUSE;
+         else if (strcmp(opt, "fuse=chains") == 0)
+            test->flags |= F_FUSE | F_CHAINS;
          else if (strncmp(opt, "relax", 5) == 0) {
             char *value = strchr(opt, '=');
             if (value == NULL) {
@@ -825,6 +831,11 @@ static bool run_test(test_t *test)
             push_arg(&args, "--cover");
       }
 
+      if (test->flags & F_CHAINS)
+         push_arg(&args, "--fuse-processes=chains");
+      else if (test->flags & F_FUSE)
+         push_arg(&args, "--fuse-processes");
+
       for (param_t *p = test->params; p != NULL; p = p->next) {
          switch (p->kind) {
          case P_GENERIC:
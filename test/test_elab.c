@@ -19,6 +19,7 @@
 #include "common.h"
 #include "diag.h"
 #include "lib.h"
+#include "option.h"
 #include "phase.h"
 #include "scan.h"
 #include "type.h"
@@ -1517,6 +1518,72 @@ START_TEST(test_genpack4)
 }
 END_TEST
 
+START_TEST(test_fuse1)
+{
+   opt_set_int(OPT_FUSE_PROCESSES, 1);
+
+   input_from_file(TESTDIR "/elab/fuse1.vhd");
+
+   tree_t e = run_elab();
+   fail_if(e == NULL);
+
+   tree_t b0 = tree_stmt(e, 0);
+   fail_unless(tree_stmts(b0) == 3);
+
+   // The fused process replaces the first member of the group
+   tree_t p0 = tree_stmt(b0, 0);
+   fail_unless(tree_kind(p0) == T_PROCESS);
+   fail_unless(tree_ident(p0) == ident_new("_F0"));
+   fail_unless(tree_stmts(p0) == 4);
+
+   tree_t p1 = tree_stmt(b0, 1);
+   fail_unless(tree_kind(p1) == T_PROCESS);
+   fail_if(tree_ident(p1) == ident_new("_F0"));
+
+   tree_t p2 = tree_stmt(b0, 2);
+   fail_unless(tree_kind(p2) == T_PROCESS);
+   fail_unless(tree_stmts(p2) == 2);
+
+   fail_if_errors();
+}
+END_TEST
+
+START_TEST(test_fuse2)
+{
+   opt_set_int(OPT_FUSE_PROCESSES, 2);
+
+   input_from_file(TESTDIR "/elab/fuse2.vhd");
+
+   tree_t e = run_elab();
+   fail_if(e == NULL);
+
+   tree_t b0 = tree_stmt(e, 0);
+   fail_unless(tree_stmts(b0) == 3);
+
+   // The producer of X is fused with its only reader
+   tree_t p0 = tree_stmt(b0, 0);
+   fail_unless(tree_kind(p0) == T_PROCESS);
+   fail_unless(tree_ident(p0) == ident_new("_C0"));
+   fail_unless(tree_decls(p0) == 2);
+   fail_unless(tree_stmts(p0) == 4);
+
+   tree_t w0 = tree_stmt(p0, 3);
+   fail_unless(tree_kind(w0) == T_WAIT);
+   fail_unless(tree_triggers(w0) == 3);
+
+   // Q is read through an attribute
+   tree_t p1 = tree_stmt(b0, 1);
+   fail_unless(tree_kind(p1) == T_PROCESS);
+   fail_unless(tree_decls(p1) == 0);
+
+   tree_t p2 = tree_stmt(b0, 2);
+   fail_unless(tree_kind(p2) == T_PROCESS);
+   fail_unless(tree_decls(p2) == 0);
+
+   fail_if_errors();
+}
+END_TEST
+
 Suite *get_elab_tests(void)
 {
    Suite *s = suite_create("elab");
@@ -1601,6 +1668,8 @@ Suite *get_elab_tests(void)
    tcase_add_test(tc, test_genpack2);
    tcase_add_test(tc, test_genpack3);
    tcase_add_test(tc, test_genpack4);
+   tcase_add_test(tc, test_fuse1);
+   tcase_add_test(tc, test_fuse2);
    suite_add_tcase(s, tc);
 
    return s;
@@ -239,6 +239,14 @@ START_TEST(test_glob)
 
    fail_unless(ident_glob(i, "*:a", -1));
    fail_unless(ident_glob(i, "foo:*", -1));
+   fail_unless(ident_glob(i, "*:bar:*", -1));
+   fail_if(ident_glob(i, "foo:bar:a*", -1));
+   fail_if(ident_glob(i, "*foo:bar:a", -1));
+
+   i = ident_new("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa");
+
+   fail_if(ident_glob(i, "*a*a*a*a*a*a*a*a*a*a*b", -1));
+   fail_unless(ident_glob(i, "*a*a*a*a*a*a*a*a*a*a", -1));
 }
 END_TEST;
 
@@ -5109,6 +5109,43 @@ START_TEST(test_issue662)
 }
 END_TEST
 
+static int64_t get_edge_mask(const char *name)
+{
+   vcode_select_unit(find_unit(name));
+   vcode_select_block(0);
+
+   const int nops = vcode_count_ops();
+   for (int i = 0; i < nops; i++) {
+      if (vcode_get_op(i) != VCODE_OP_SCHED_EVENT)
+         continue;
+      else if (vcode_count_args(i) < 3)
+         return -1;
+
+      int64_t mask;
+      if (!vcode_reg_const(vcode_get_arg(i, 2), &mask))
+         fail("edge mask for %s is not constant", name);
+      return mask;
+   }
+
+   fail("missing sched event in %s", name);
+   return -1;
+}
+
+START_TEST(test_edge1)
+{
+   input_from_file(TESTDIR "/lower/edge1.vhd");
+
+   run_elab();
+
+   ck_assert_int_eq(get_edge_mask("WORK.EDGE1.P1"), 2);
+   ck_assert_int_eq(get_edge_mask("WORK.EDGE1.P2"), 1);
+   ck_assert_int_eq(get_edge_mask("WORK.EDGE1.P3"), -1);
+   ck_assert_int_eq(get_edge_mask("WORK.EDGE1.P4"), -1);
+
+   fail_if_errors();
+}
+END_TEST
+
 Suite *get_lower_tests(void)
 {
    Suite *s = suite_create("lower");
@@ -5233,6 +5270,7 @@ Suite *get_lower_tests(void)
    tcase_add_test(tc, test_attr2);
    tcase_add_test(tc, test_copy1);
    tcase_add_test(tc, test_issue662);
+   tcase_add_test(tc, test_edge1);
    suite_add_tcase(s, tc);
 
    return s;
@@ -93,6 +93,33 @@ START_TEST(test_hash_delete)
 }
 END_TEST
 
+START_TEST(test_hash_iter)
+{
+   hash_t *h = hash_new(4);
+
+   for (int i = 1; i <= 100; i++)
+      hash_put(h, VOIDP((i * 7919)), VOIDP(i));
+
+   fail_unless(hash_put(h, VOIDP(7919), VOIDP(1)));
+   hash_delete(h, VOIDP((2 * 7919)));
+   ck_assert_int_eq(hash_members(h), 100);
+
+   // Entries are returned in insertion order even after the table grows
+   const void *key;
+   void *value;
+   int count = 0;
+   for (hash_iter_t it = HASH_BEGIN; hash_iter(h, &it, &key, &value); ) {
+      count++;
+      ck_assert_ptr_eq(key, VOIDP((count * 7919)));
+      ck_assert_ptr_eq(value, count == 2 ? NULL : VOIDP(count));
+   }
+
+   ck_assert_int_eq(count, 100);
+
+   hash_free(h);
+}
+END_TEST
+
 START_TEST(test_shash_basic)
 {
    shash_t *h = shash_new(8);
@@ -652,6 +679,7 @@ Suite *get_misc_tests(void)
    tcase_add_test(tc_hash, test_hash_basic);
    tcase_add_test(tc_hash, test_hash_rand);
    tcase_add_test(tc_hash, test_hash_delete);
+   tcase_add_test(tc_hash, test_hash_iter);
    tcase_add_test(tc_hash, test_shash_basic);
    tcase_add_test(tc_hash, test_shash_rand);
    tcase_add_test(tc_hash, test_ihash_rand);
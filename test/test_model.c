@@ -20,6 +20,7 @@
 #include "jit/jit.h"
 #include "option.h"
 #include "phase.h"
+#include "rt/cover.h"
 #include "rt/model.h"
 #include "rt/structs.h"
 #include "scan.h"
@@ -446,6 +447,81 @@ START_TEST(test_event1)
 }
 END_TEST
 
+static const int32_t *run_with_cover(jit_t *j, cover_mask_t mask,
+                                     int32_t *n_stmts)
+{
+   tree_t a = parse_check_and_simplify(T_ENTITY, T_ARCH);
+
+   jit_t *elab_jit = jit_new();
+   cover_tagging_t *cover = cover_tags_init(mask, 0);
+   tree_t top = elab(a, elab_jit, cover);
+   fail_if(top == NULL);
+   jit_free(elab_jit);
+
+   int32_t n_branches, n_toggles, n_expressions;
+   cover_count_tags(cover, n_stmts, &n_branches, &n_toggles, &n_expressions);
+
+   jit_enable_runtime(j, true);
+
+   // The test library has no directory to hold a coverage database
+   jit_alloc_cover_mem(j, *n_stmts, n_branches, n_toggles, n_expressions);
+
+   rt_model_t *m = model_new(top, j);
+   model_reset(m);
+   model_run(m, UINT64_MAX);
+   model_free(m);
+
+   // These are the same counts written to the coverage database
+   return jit_get_cover_mem(j, JIT_COVER_STMT);
+}
+
+START_TEST(test_cover1)
+{
+   input_from_file(TESTDIR "/model/cover1.vhd");
+
+   jit_t *j = jit_new();
+
+   int32_t n_stmts;
+   const int32_t *counts = run_with_cover(j, COVER_MASK_STMT, &n_stmts);
+   ck_assert_ptr_nonnull(counts);
+
+   int max = 0, nhit = 0;
+   for (int i = 0; i < n_stmts; i++) {
+      max = MAX(max, counts[i]);
+      nhit += (counts[i] > 0);
+   }
+
+   // The statement in the loop body is counted once per iteration
+   ck_assert_int_eq(max, 10);
+   ck_assert_int_eq(nhit, n_stmts);
+
+   jit_free(j);
+
+   fail_if_errors();
+}
+END_TEST
+
+START_TEST(test_cover2)
+{
+   input_from_file(TESTDIR "/model/cover1.vhd");
+
+   jit_t *j = jit_new();
+
+   int32_t n_stmts;
+   const int32_t *counts =
+      run_with_cover(j, COVER_MASK_STMT | COVER_MASK_STMT_HIT_ONCE, &n_stmts);
+   ck_assert_ptr_nonnull(counts);
+
+   // With hit-once every count saturates at one
+   for (int i = 0; i < n_stmts; i++)
+      ck_assert_int_eq(counts[i], 1);
+
+   jit_free(j);
+
+   fail_if_errors();
+}
+END_TEST
+
 Suite *get_model_tests(void)
 {
    Suite *s = suite_create("model");
@@ -459,6 +535,8 @@ Suite *get_model_tests(void)
    tcase_add_test(tc, test_pending1);
    tcase_add_test(tc, test_fast2);
    tcase_add_test(tc, test_event1);
+   tcase_add_test(tc, test_cover1);
+   tcase_add_test(tc, test_cover2);
    suite_add_tcase(s, tc);
 
    return s;
@@ -1,5 +1,5 @@
 //
-//  Copyright (C) 2022  Nick Gasson
+//  Copyright (C) 2022-2023  Nick Gasson
 //
 //  This program is free software: you can redistribute it and/or modify
 //  it under the terms of the GNU General Public License as published by
@@ -16,9 +16,11 @@
 //
 
 #include "test_util.h"
+#include "option.h"
 #include "rt/mspace.h"
 
 #include <stdlib.h>
+#include <unistd.h>
 
 START_TEST(test_sanity)
 {
@@ -277,6 +279,132 @@ START_TEST(test_end_ptr)
 }
 END_TEST
 
+__attribute__((noinline))
+static void fill_young(mspace_t *m, int **array, int count)
+{
+   for (int i = 0; i < count; i++) {
+      array[i] = mspace_alloc(m, sizeof(int));
+      *array[i] = i;
+   }
+}
+
+START_TEST(test_old_to_young)
+{
+   opt_set_int(OPT_GC_GENERATIONAL, 1);
+
+   mspace_t *m = mspace_new(64 * 1024);
+
+   // Do a few dummy allocations to ensure the pointer is not in the
+   // first line which is often kept alive by stack pointers to m->space
+   generate_garbage(m, 5, sizeof(int));
+
+   mptr_t p = mptr_new(m, "test");
+   *mptr_get(p) = mspace_alloc(m, 16 * sizeof(int *));
+
+   // Survive a collection so the array is in the old generation
+   generate_garbage(m, 5000, sizeof(int));
+
+   // The new objects are only reachable from the old array
+   fill_young(m, *mptr_get(p), 16);
+
+   generate_garbage(m, 5000, sizeof(int));
+
+   int **array = *mptr_get(p);
+   for (int i = 0; i < 16; i++)
+      ck_assert_int_eq(*array[i], i);
+
+   mptr_free(m, &p);
+   mspace_destroy(m);
+}
+END_TEST
+
+START_TEST(test_old_garbage)
+{
+   opt_set_int(OPT_GC_GENERATIONAL, 1);
+
+   mspace_t *m = mspace_new(16 * 1024);
+
+   for (int i = 0; i < 20; i++) {
+      mptr_t p = mptr_new(m, "test");
+      *mptr_get(p) = mspace_alloc(m, 8 * 1024);
+
+      // Survive a collection so the object is in the old generation
+      generate_garbage(m, 500, sizeof(int));
+
+      // Must eventually be reclaimed by a full collection
+      mptr_free(m, &p);
+   }
+
+   mspace_destroy(m);
+}
+END_TEST
+
+__attribute__((noinline))
+static void store_large(mspace_t *m, void **array)
+{
+   array[0] = mspace_alloc(m, 8 * 1024);
+   array[1] = (void *)42;
+}
+
+START_TEST(test_noscan)
+{
+   mspace_t *m = mspace_new(16 * 1024);
+   mspace_set_oom_handler(m, test_oom_cb);
+   oom_sz = 0;
+
+   mptr_t p = mptr_new(m, "test");
+   *mptr_get(p) = mspace_alloc_noscan(m, 64 * sizeof(void *));
+
+   // Pointers stored in an object allocated without scanning do not
+   // keep their target alive
+   store_large(m, *mptr_get(p));
+
+   generate_garbage(m, 1000, sizeof(int));
+
+   ck_assert_ptr_nonnull(mspace_alloc(m, 10 * 1024));
+   ck_assert_int_eq(oom_sz, 0);
+
+   void **array = *mptr_get(p);
+   ck_assert_ptr_eq(array[1], (void *)42);
+
+   mptr_free(m, &p);
+   mspace_destroy(m);
+}
+END_TEST
+
+#ifndef __MINGW32__
+START_TEST(test_syscall_write)
+{
+   mspace_t *m = mspace_new(256 * 1024);
+
+   const size_t pagesz = sysconf(_SC_PAGESIZE);
+
+   mptr_t p = mptr_new(m, "test");
+   *mptr_get(p) = mspace_alloc(m, 3 * pagesz);
+
+   // Survive a collection so the buffer is in the old generation
+   generate_garbage(m, 10000, sizeof(int));
+
+   int fds[2];
+   ck_assert_int_eq(pipe(fds), 0);
+   ck_assert_int_eq(write(fds[1], "hello", 5), 5);
+
+   // The kernel cannot write into a write-protected page so this
+   // would fail with EFAULT if generational mode were the default
+   char *buf = *mptr_get(p);
+   char *page = (char *)(((uintptr_t)buf + pagesz - 1) & ~(pagesz - 1));
+   ck_assert_int_eq(read(fds[0], page, 5), 5);
+   ck_assert_mem_eq(page, "hello", 5);
+
+   close(fds[0]);
+   close(fds[1]);
+
+   mptr_free(m, &p);
+   mspace_destroy(m);
+}
+END_TEST
+#endif
+
 Suite *get_mspace_tests(void)
 {
    Suite *s = suite_create("mspace");
@@ -291,6 +419,12 @@ Suite *get_mspace_tests(void)
    tcase_add_test(tc, test_linked_list);
    tcase_add_test(tc, test_tlab);
    tcase_add_test(tc, test_end_ptr);
+   tcase_add_test(tc, test_old_to_young);
+   tcase_add_test(tc, test_old_garbage);
+   tcase_add_test(tc, test_noscan);
+#ifndef __MINGW32__
+   tcase_add_test(tc, test_syscall_write);
+#endif
    suite_add_tcase(s, tc);
 
    return s;
@@ -5535,6 +5535,47 @@ START_TEST(test_interface)
 }
 END_TEST
 
+START_TEST(test_scan)
+{
+   set_standard(STD_08);
+
+   input_from_file(TESTDIR "/parse/scan.vhd");
+
+   tree_t p = parse();
+   fail_if(p == NULL);
+   fail_unless(tree_kind(p) == T_PACKAGE);
+   fail_unless(tree_decls(p) == 6);
+
+   tree_t d0 = tree_decl(p, 0);
+   fail_unless(tree_ident(d0) ==
+               ident_new("A_VERY_LONG_IDENTIFIER_NAME_0123456789"));
+
+   tree_t d1 = tree_decl(p, 1);
+   fail_unless(tree_ident(d1) ==
+               ident_new("LONG_IDENTIFIER_WITH_\xdcMLAUT_AND_\xc9"));
+   fail_unless(tree_ival(tree_value(d1)) == 255);
+
+   tree_t d2 = tree_decl(p, 2);
+   fail_unless(tree_ident(d2) == ident_new("SHORT"));
+
+   tree_t d3 = tree_decl(p, 3);
+   fail_unless(tree_ident(d3) == ident_new("SPACED"));
+   const loc_t *l3 = tree_loc(d3);
+   ck_assert_int_eq(l3->first_line, 6);
+   ck_assert_int_eq(l3->first_column, 49);
+
+   tree_t d5 = tree_decl(p, 5);
+   fail_unless(tree_ident(d5) == ident_new("LAST"));
+   const loc_t *l5 = tree_loc(d5);
+   ck_assert_int_eq(l5->first_line, 8);
+   ck_assert_int_eq(l5->first_column, 27);
+
+   fail_unless(parse() == NULL);
+
+   fail_if_errors();
+}
+END_TEST
+
 Suite *get_parse_tests(void)
 {
    Suite *s = suite_create("parse");
@@ -5649,6 +5690,7 @@ Suite *get_parse_tests(void)
    tcase_add_test(tc_core, test_issue688);
    tcase_add_test(tc_core, test_issue686);
    tcase_add_test(tc_core, test_interface);
+   tcase_add_test(tc_core, test_scan);
    suite_add_tcase(s, tc_core);
 
    return s;
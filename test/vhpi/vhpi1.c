@@ -69,6 +69,89 @@ static void test_bin_str(void)
    vhpi_release_handle(hv);
 }
 
+static void v_value_change(const vhpiCbDataT *cb_data)
+{
+   unsigned char raw[4];
+   vhpiValueT raw_value = {
+      .format    = vhpiRawDataVal,
+      .bufSize   = sizeof(raw),
+      .value.ptr = raw
+   };
+   fail_unless(vhpi_get_value(cb_data->obj, &raw_value) == 0);
+   check_error();
+   fail_unless(raw[0] == 1 && raw[1] == 0 && raw[2] == 1 && raw[3] == 1);
+
+   vhpiEnumT enums[4];
+   vhpiValueT vec_value = {
+      .format       = vhpiLogicVecVal,
+      .bufSize      = sizeof(enums),
+      .value.enumvs = enums
+   };
+   fail_unless(vhpi_get_value(cb_data->obj, &vec_value) == 0);
+   check_error();
+   fail_unless(enums[0] == 1 && enums[1] == 0 && enums[2] == 1
+               && enums[3] == 1);
+
+   vhpi_printf("v forced to raw data");
+
+   vhpi_release_handle(cb_data->obj);
+
+   vhpi_control(vhpiFinish);
+   check_error();
+}
+
+static void test_raw_data(void)
+{
+   vhpiHandleT root = vhpi_handle(vhpiRootInst, NULL);
+   check_error();
+
+   vhpiHandleT hv = vhpi_handle_by_name("v", root);
+   check_error();
+
+   vhpiValueT raw_value = {
+      .format    = vhpiRawDataVal,
+      .bufSize   = 0,
+      .value.ptr = NULL
+   };
+   fail_unless(vhpi_get_value(hv, &raw_value) == 4);
+   check_error();
+   fail_unless(raw_value.numElems == 4);
+
+   unsigned char raw[4];
+   raw_value.bufSize   = sizeof(raw);
+   raw_value.value.ptr = raw;
+   fail_unless(vhpi_get_value(hv, &raw_value) == 0);
+   check_error();
+   fail_unless(raw[0] == 0 && raw[1] == 0 && raw[2] == 1 && raw[3] == 1);
+
+   vhpiEnumT enums[4];
+   vhpiValueT vec_value = {
+      .format       = vhpiLogicVecVal,
+      .bufSize      = sizeof(enums),
+      .value.enumvs = enums
+   };
+   fail_unless(vhpi_get_value(hv, &vec_value) == 0);
+   check_error();
+   fail_unless(vec_value.numElems == 4);
+   fail_unless(enums[0] == 0 && enums[1] == 0 && enums[2] == 1
+               && enums[3] == 1);
+
+   raw[0] = 1;
+   fail_unless(vhpi_put_value(hv, &raw_value, vhpiForcePropagate) == 0);
+   check_error();
+
+   // The forced value is read back when it propagates
+   vhpiCbDataT cb_data = {
+      .reason = vhpiCbValueChange,
+      .cb_rtn = v_value_change,
+      .obj    = hv
+   };
+   vhpi_register_cb(&cb_data, 0);
+   check_error();
+
+   vhpi_release_handle(root);
+}
+
 static void y_value_change(const vhpiCbDataT *cb_data)
 {
    vhpiValueT value = {
@@ -82,9 +165,7 @@ static void y_value_change(const vhpiCbDataT *cb_data)
 
    if (value.value.intg == 75) {
       test_bin_str();
-
-      vhpi_control(vhpiFinish);
-      check_error();
+      test_raw_data();   // Finishes simulation once the force propagates
    }
    else {
       value.value.intg++;
@@ -0,0 +1,117 @@
+#include "vhpi_user.h"
+
+#include <stdio.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define fail_if(x)                                                      \
+   if (x) vhpi_assert(vhpiFailure, "assertion '%s' failed at %s:%d",    \
+                      #x, __FILE__, __LINE__)
+#define fail_unless(x) fail_if(!(x))
+
+static int clk_rising = 0;
+static int clk_falling = 0;
+static int b_rising = 0;
+
+static vhpiValueT clk_value = {
+   .format = vhpiLogicVal
+};
+
+static void check_error(void)
+{
+   vhpiErrorInfoT info;
+   if (vhpi_check_error(&info))
+      vhpi_assert(vhpiFailure, "unexpected error '%s'", info.message);
+}
+
+static void clk_rising_cb(const vhpiCbDataT *cb_data)
+{
+   clk_rising++;
+
+   // New value is passed to the callback
+   fail_unless(cb_data->value == &clk_value);
+   fail_unless(clk_value.value.enumv == vhpi1
+               || clk_value.value.enumv == vhpiH);
+}
+
+static void clk_falling_cb(const vhpiCbDataT *cb_data)
+{
+   clk_falling++;
+}
+
+static void b_rising_cb(const vhpiCbDataT *cb_data)
+{
+   b_rising++;
+}
+
+static void end_of_sim(const vhpiCbDataT *cb_data)
+{
+   vhpi_printf("clk rising %d falling %d", clk_rising, clk_falling);
+   vhpi_printf("b rising %d", b_rising);
+
+   fail_unless(clk_rising == 2);
+   fail_unless(clk_falling == 3);
+   fail_unless(b_rising == 2);
+}
+
+static void start_of_sim(const vhpiCbDataT *cb_data)
+{
+   vhpiHandleT root = vhpi_handle(vhpiRootInst, NULL);
+   check_error();
+
+   vhpiHandleT hclk = vhpi_handle_by_name("clk", root);
+   check_error();
+
+   vhpiHandleT hb = vhpi_handle_by_name("b", root);
+   check_error();
+
+   vhpiCbDataT cb_data1 = {
+      .reason = vhpiCbRisingEdge,
+      .cb_rtn = clk_rising_cb,
+      .obj    = hclk,
+      .value  = &clk_value
+   };
+   vhpi_register_cb(&cb_data1, 0);
+   check_error();
+
+   vhpiCbDataT cb_data2 = {
+      .reason = vhpiCbFallingEdge,
+      .cb_rtn = clk_falling_cb,
+      .obj    = hclk
+   };
+   vhpi_register_cb(&cb_data2, 0);
+   check_error();
+
+   vhpiCbDataT cb_data3 = {
+      .reason = vhpiCbRisingEdge,
+      .cb_rtn = b_rising_cb,
+      .obj    = hb
+   };
+   vhpi_register_cb(&cb_data3, 0);
+   check_error();
+
+   vhpi_release_handle(root);
+}
+
+static void startup()
+{
+   vhpiCbDataT cb_data1 = {
+      .reason = vhpiCbStartOfSimulation,
+      .cb_rtn = start_of_sim
+   };
+   vhpi_register_cb(&cb_data1, 0);
+   check_error();
+
+   vhpiCbDataT cb_data2 = {
+      .reason = vhpiCbEndOfSimulation,
+      .cb_rtn = end_of_sim
+   };
+   vhpi_register_cb(&cb_data2, 0);
+   check_error();
+}
+
+void (*vhpi_startup_routines[])() = {
+   startup,
+   NULL
+};